@@ -6,6 +6,7 @@
 #include "app/App.h"
 
 #include "core/AppContext.h"
+#include "core/CommandStack.h"
 #include "core/Project.h"
 #include "io/ProjectSerializer.h"
 #include "imgui.h"
@@ -16,6 +17,7 @@
 #include "ui/menu/MenuFactory.h"
 #include "ui/menu/menu_items/Menu_Edit.h"
 #include "ui/menu/menu_items/Menu_File.h"
+#include "ui/menu/menu_items/Menu_View.h"
 #include "ui/windows/ProjectWindow.h"
 #include "ui/windows/Window.h"
 #include "ui/windows/WindowFactory.h"
@@ -187,7 +189,7 @@ void App::createMenuAndWindows()
         [this]() { closeAllProjects(); });
 
     editMenu_ = menuFactory.createEditMenu(menuManager_, nullptr);
-    menuFactory.createViewMenu(menuManager_);
+    viewMenu_ = menuFactory.createViewMenu(menuManager_, nullptr);
     menuFactory.createHelpMenu(menuManager_);
 
     // 启动时默认创建一个项目，保证界面可用
@@ -327,6 +329,7 @@ void App::shutdown()
     }
     fileMenu_ = nullptr;
     editMenu_ = nullptr;
+    viewMenu_ = nullptr;
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
@@ -374,6 +377,8 @@ void App::setActiveContext(AppContext* context)
         fileMenu_->setContext(activeContext_);
     if (editMenu_)
         editMenu_->setContext(activeContext_);
+    if (viewMenu_)
+        viewMenu_->setContext(activeContext_);
 }
 
 int App::findSessionIndexByContext(const AppContext* context) const
@@ -803,8 +808,10 @@ void App::createSessionFromProject(std::unique_ptr<Project> project, const std::
 {
     ProjectSession session;
     session.project = std::move(project);
+    session.commandStack = std::make_unique<CommandStack>();
     session.context = std::make_unique<AppContext>();
     session.context->setProject(session.project.get());
+    session.context->setCommandStack(session.commandStack.get());
     session.context->setProjectFilePath(projectPath);
     session.context->setProjectDirty(false);
     session.context->setCurrentAnimationIndex(0);
@@ -837,8 +844,10 @@ void App::createNewProject(int width, int height, int frameCount, uint32_t fillC
 
     // 为新窗口创建独立项目数据 + 独立上下文
     session.project = std::make_unique<Project>(width, height, frameCount, fillColor);
+    session.commandStack = std::make_unique<CommandStack>();
     session.context = std::make_unique<AppContext>();
     session.context->setProject(session.project.get());
+    session.context->setCommandStack(session.commandStack.get());
     session.context->setProjectFilePath("");
     session.context->setProjectDirty(false);
     session.context->setCurrentAnimationIndex(0);
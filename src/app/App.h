@@ -21,9 +21,11 @@
 class MenuManager;
 class Menu_File;
 class Menu_Edit;
+class Menu_View;
 class ProjectWindow;
 class Project;
 class AppContext;
+class CommandStack;
 
 class App
 {
@@ -51,12 +53,14 @@ private:
      * @brief 一个项目会话对应一个独立窗口
      *
      * project: 业务数据（画布尺寸、帧序列、像素）
+     * commandStack: 该项目的撤销/重做历史（由 context 引用）
      * context: 编辑状态（当前帧、工具、缩放、脏标记等）
      * window:  该项目对应的 ProjectWindow
      */
     struct ProjectSession
     {
         std::unique_ptr<Project> project;
+        std::unique_ptr<CommandStack> commandStack;
         std::unique_ptr<AppContext> context;
         ProjectWindow* window = nullptr;
 
@@ -114,6 +118,7 @@ private:
     MenuManager* menuManager_ = nullptr;
     Menu_File* fileMenu_ = nullptr;
     Menu_Edit* editMenu_ = nullptr;
+    Menu_View* viewMenu_ = nullptr;
     std::vector<ProjectSession> projectSessions_;
     AppContext* activeContext_ = nullptr;
 
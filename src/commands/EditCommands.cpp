@@ -0,0 +1,481 @@
+#include "commands/EditCommands.h"
+
+#include "core/AppContext.h"
+#include "core/Clipboard.h"
+#include "core/FloatingSelection.h"
+#include "core/FramePatch.h"
+#include "core/Parallel.h"
+#include "core/Project.h"
+#include "core/Selection.h"
+#include "io/SystemClipboard.h"
+#include "tools/CustomBrush.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // 复制区域（选区包围盒，或无选区时的整帧）
+    struct Region
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    Region selectionRegion(const Selection& selection, int canvasWidth, int canvasHeight)
+    {
+        Region region;
+        int minX = 0;
+        int minY = 0;
+        int maxX = 0;
+        int maxY = 0;
+        if (selection.getWidth() == canvasWidth && selection.getHeight() == canvasHeight &&
+            selection.getBounds(minX, minY, maxX, maxY))
+        {
+            region.x = minX;
+            region.y = minY;
+            region.width = maxX - minX + 1;
+            region.height = maxY - minY + 1;
+        }
+        else
+        {
+            region.width = canvasWidth;
+            region.height = canvasHeight;
+        }
+        return region;
+    }
+
+    bool hasMask(const Selection& selection, int canvasWidth, int canvasHeight)
+    {
+        return selection.getWidth() == canvasWidth && selection.getHeight() == canvasHeight &&
+            !selection.isEmpty();
+    }
+
+    // 按行拷贝区域像素；有选区时把未选中的像素置为透明
+    std::shared_ptr<ImageBuffer> extractRegion(const Project::Frame& frame,
+                                               int canvasWidth,
+                                               const Selection* mask,
+                                               const Region& region)
+    {
+        auto image = std::make_shared<ImageBuffer>();
+        image->width = region.width;
+        image->height = region.height;
+        image->pixels.resize(static_cast<size_t>(region.width) * static_cast<size_t>(region.height));
+
+        for (int y = 0; y < region.height; ++y)
+        {
+            const uint32_t* src = frame.pixels.data()
+                + static_cast<size_t>(region.y + y) * static_cast<size_t>(canvasWidth)
+                + static_cast<size_t>(region.x);
+            uint32_t* dst = image->pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(region.width);
+            std::memcpy(dst, src, static_cast<size_t>(region.width) * sizeof(uint32_t));
+
+            if (!mask)
+                continue;
+            for (int x = 0; x < region.width; ++x)
+            {
+                if (!mask->contains(region.x + x, region.y + y))
+                    dst[x] = 0x00000000;
+            }
+        }
+        return image;
+    }
+
+    // 把区域内像素清为透明；mask 非空时只清除选中的像素
+    bool clearRegion(Project::Frame& frame, int canvasWidth, const Selection* mask, const Region& region)
+    {
+        bool changed = false;
+        for (int y = region.y; y < region.y + region.height; ++y)
+        {
+            uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+            for (int x = region.x; x < region.x + region.width; ++x)
+            {
+                if (row[x] != 0x00000000 && (!mask || mask->contains(x, y)))
+                {
+                    row[x] = 0x00000000;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    // 把浮动图像叠加到已提取的区域图像上（用于 Copy Merged）
+    void overlayFloating(ImageBuffer& image, const Region& region, const FloatingSelection& floating)
+    {
+        const ImageBuffer* src = floating.getImage();
+        for (int y = 0; y < src->height; ++y)
+        {
+            const int ty = floating.getY() + y - region.y;
+            if (ty < 0 || ty >= image.height)
+                continue;
+            for (int x = 0; x < src->width; ++x)
+            {
+                const int tx = floating.getX() + x - region.x;
+                if (tx < 0 || tx >= image.width)
+                    continue;
+                const uint32_t color = src->pixels[static_cast<size_t>(y) * static_cast<size_t>(src->width) + static_cast<size_t>(x)];
+                if ((color >> 24) != 0)
+                    image.pixels[static_cast<size_t>(ty) * static_cast<size_t>(image.width) + static_cast<size_t>(tx)] = color;
+            }
+        }
+    }
+
+    // 修改前记录 [first, last] 帧中区域的原像素
+    std::unique_ptr<FramePatchCommand> capturePatch(const char* name,
+                                                    const Project& project,
+                                                    int first,
+                                                    int last,
+                                                    const Region& region)
+    {
+        auto patch = std::make_unique<FramePatchCommand>(name, project.getWidth(), project.getHeight());
+        for (int i = first; i <= last; ++i)
+            patch->captureRect(project, i, region.x, region.y, region.x + region.width - 1, region.y + region.height - 1);
+        return patch;
+    }
+
+    // 修改完成后入栈；没有实际变化的记录直接丢弃
+    void pushPatch(AppContext& context, std::unique_ptr<FramePatchCommand> patch)
+    {
+        if (patch->finalize(*context.getProject()))
+            context.pushCommand(std::move(patch));
+    }
+
+    /**
+     * @brief 对帧范围内每帧执行整帧变换，整个范围只产生一条撤销记录
+     *
+     * 先串行记录原像素（tile 表是共享的），再按帧并行变换。
+     */
+    template <typename Fn>
+    bool transformFrameRange(AppContext& context, const char* name, Fn&& fn)
+    {
+        Project* project = context.getProject();
+        if (!project)
+            return false;
+
+        // 浮动选区属于某一帧的内容，先落地再整体变换
+        EditCommands::commitFloating(context);
+
+        const int width = project->getWidth();
+        const int height = project->getHeight();
+        int first = 0;
+        int last = 0;
+        context.getFrameRange(first, last);
+
+        auto patch = std::make_unique<FramePatchCommand>(name, width, height);
+        for (int i = first; i <= last; ++i)
+            patch->captureFrame(*project, i);
+
+        parallelFor(first, last + 1, [&](int frameIndex) {
+            std::vector<uint32_t> scratch;
+            fn(project->getFrame(frameIndex).pixels, width, height, scratch);
+        });
+
+        if (!patch->finalize(*project))
+            return false;
+        context.pushCommand(std::move(patch));
+        context.setProjectDirty(true);
+        return true;
+    }
+
+    void storeClipboard(std::shared_ptr<const ImageBuffer> image, int originX, int originY)
+    {
+        Clipboard::getInstance().setImage(image, originX, originY);
+        SystemClipboard::offerImage(std::move(image));
+    }
+
+    bool beginPaste(AppContext& context, bool keepOrigin)
+    {
+        Project* project = context.getProject();
+        const Clipboard& clipboard = Clipboard::getInstance();
+        if (!project || !clipboard.hasImage())
+            return false;
+
+        // 已有浮动选区时先落地，保证同一时刻只有一个浮动层
+        EditCommands::commitFloating(context);
+
+        const ImageBuffer& image = *clipboard.getImage();
+        int x = clipboard.getOriginX();
+        int y = clipboard.getOriginY();
+        if (!keepOrigin)
+        {
+            x = std::clamp(x, 0, std::max(0, project->getWidth() - image.width));
+            y = std::clamp(y, 0, std::max(0, project->getHeight() - image.height));
+        }
+        context.getFloatingSelection().begin(clipboard.getImage(), x, y);
+        return true;
+    }
+} // namespace
+
+bool EditCommands::copy(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    const FloatingSelection& floating = context.getFloatingSelection();
+    if (floating.isActive())
+    {
+        storeClipboard(floating.getImagePtr(), floating.getX(), floating.getY());
+        return true;
+    }
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const Region region = selectionRegion(selection, width, height);
+    const Project::Frame& frame = project->getFrame(context.getCurrentFrameIndex());
+    const Selection* mask = hasMask(selection, width, height) ? &selection : nullptr;
+    storeClipboard(extractRegion(frame, width, mask, region), region.x, region.y);
+    return true;
+}
+
+bool EditCommands::copyMerged(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const Region region = selectionRegion(selection, width, height);
+    const Project::Frame& frame = project->getFrame(context.getCurrentFrameIndex());
+    const Selection* mask = hasMask(selection, width, height) ? &selection : nullptr;
+
+    std::shared_ptr<ImageBuffer> image = extractRegion(frame, width, mask, region);
+    const FloatingSelection& floating = context.getFloatingSelection();
+    if (floating.isActive())
+        overlayFloating(*image, region, floating);
+    storeClipboard(std::move(image), region.x, region.y);
+    return true;
+}
+
+bool EditCommands::cut(AppContext& context)
+{
+    FloatingSelection& floating = context.getFloatingSelection();
+    if (floating.isActive())
+    {
+        storeClipboard(floating.getImagePtr(), floating.getX(), floating.getY());
+        floating.clear();
+        return true;
+    }
+
+    Project* project = context.getProject();
+    if (!project || !copy(context))
+        return false;
+
+    // 清除与 copy 相同的范围：有选区时为选区内像素，无选区时为整帧
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const Region region = selectionRegion(selection, width, height);
+    const Selection* mask = hasMask(selection, width, height) ? &selection : nullptr;
+    const int frameIndex = context.getCurrentFrameIndex();
+    std::unique_ptr<FramePatchCommand> patch = capturePatch("Cut", *project, frameIndex, frameIndex, region);
+    if (clearRegion(project->getFrame(frameIndex), width, mask, region))
+    {
+        pushPatch(context, std::move(patch));
+        context.setProjectDirty(true);
+    }
+    return true;
+}
+
+bool EditCommands::paste(AppContext& context)
+{
+    return beginPaste(context, false);
+}
+
+bool EditCommands::pasteInPlace(AppContext& context)
+{
+    return beginPaste(context, true);
+}
+
+bool EditCommands::pasteAsNewFrame(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project || !Clipboard::getInstance().hasImage())
+        return false;
+
+    commitFloating(context);
+    const int current = context.getCurrentFrameIndex();
+    project->insertFrameAfter(current, 0x00000000);
+    // 插帧改变了帧索引，旧记录不再适用
+    context.clearUndoHistory();
+    context.setCurrentFrameIndex(current + 1);
+    context.setProjectDirty(true);
+    return beginPaste(context, true);
+}
+
+bool EditCommands::deleteSelection(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    FloatingSelection& floating = context.getFloatingSelection();
+    if (floating.isActive())
+    {
+        floating.clear();
+        return true;
+    }
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    if (!hasMask(selection, width, height))
+        return false;
+
+    const Region region = selectionRegion(selection, width, height);
+    const int frameIndex = context.getCurrentFrameIndex();
+    std::unique_ptr<FramePatchCommand> patch = capturePatch("Delete", *project, frameIndex, frameIndex, region);
+    const bool changed = clearRegion(project->getFrame(frameIndex), width, &selection, region);
+    if (changed)
+    {
+        pushPatch(context, std::move(patch));
+        context.setProjectDirty(true);
+    }
+    return changed;
+}
+
+bool EditCommands::liftSelection(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    // 已有浮动选区时先落地，保证同一时刻只有一个浮动层
+    commitFloating(context);
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const Region region = selectionRegion(selection, width, height);
+    const Selection* mask = hasMask(selection, width, height) ? &selection : nullptr;
+
+    int first = 0;
+    int last = 0;
+    context.getFrameRange(first, last);
+
+    std::unique_ptr<FramePatchCommand> patch = capturePatch("Lift Selection", *project, first, last, region);
+    std::vector<std::shared_ptr<const ImageBuffer>> sources;
+    sources.reserve(static_cast<size_t>(last - first + 1));
+    for (int i = first; i <= last; ++i)
+    {
+        Project::Frame& frame = project->getFrame(i);
+        sources.push_back(extractRegion(frame, width, mask, region));
+        clearRegion(frame, width, mask, region);
+    }
+    pushPatch(context, std::move(patch));
+
+    context.getFloatingSelection().beginLifted(std::move(sources), first, region.x, region.y);
+    context.setProjectDirty(true);
+    return true;
+}
+
+bool EditCommands::transform(AppContext& context, const TransformStep& step)
+{
+    FloatingSelection& floating = context.getFloatingSelection();
+    if (!floating.isActive() && !liftSelection(context))
+        return false;
+
+    floating.applyTransform(step);
+    return true;
+}
+
+bool EditCommands::commitFloating(AppContext& context)
+{
+    Project* project = context.getProject();
+    FloatingSelection& floating = context.getFloatingSelection();
+    if (!project || !floating.isActive())
+        return false;
+
+    const int first = floating.isLifted() ? floating.getFirstFrame() : context.getCurrentFrameIndex();
+    const int last = floating.isLifted() ? floating.getLastFrame() : first;
+    const Region region{floating.getX(), floating.getY(), floating.getImage()->width, floating.getImage()->height};
+    std::unique_ptr<FramePatchCommand> patch = capturePatch("Commit Selection", *project, first, last, region);
+
+    const bool changed = floating.commit(*project, context.getCurrentFrameIndex());
+    if (changed)
+    {
+        pushPatch(context, std::move(patch));
+        context.setProjectDirty(true);
+    }
+    return changed;
+}
+
+void EditCommands::cancelFloating(AppContext& context)
+{
+    Project* project = context.getProject();
+    FloatingSelection& floating = context.getFloatingSelection();
+    if (!project)
+    {
+        floating.clear();
+        return;
+    }
+    std::unique_ptr<FramePatchCommand> patch;
+    if (floating.isLifted())
+    {
+        Region region;
+        floating.getLiftedRect(region.x, region.y, region.width, region.height);
+        patch = capturePatch("Cancel Selection", *project, floating.getFirstFrame(), floating.getLastFrame(), region);
+    }
+    if (floating.cancel(*project))
+    {
+        if (patch)
+            pushPatch(context, std::move(patch));
+        context.setProjectDirty(true);
+    }
+}
+
+bool EditCommands::newBrush(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    std::shared_ptr<const CustomBrush> brush;
+    const FloatingSelection& floating = context.getFloatingSelection();
+    if (floating.isActive())
+    {
+        brush = CustomBrush::fromImage(*floating.getImage());
+    }
+    else
+    {
+        const int width = project->getWidth();
+        const int height = project->getHeight();
+        const Selection& selection = context.getSelection();
+        if (!hasMask(selection, width, height))
+            return false;
+        const Region region = selectionRegion(selection, width, height);
+        const Project::Frame& frame = project->getFrame(context.getCurrentFrameIndex());
+        brush = CustomBrush::fromImage(*extractRegion(frame, width, &selection, region));
+    }
+
+    if (!brush)
+        return false;
+    context.setCustomBrush(std::move(brush));
+    context.setTool(ToolType::Brush);
+    return true;
+}
+
+bool EditCommands::shiftFrames(AppContext& context, int dx, int dy, bool wrap)
+{
+    if (dx == 0 && dy == 0)
+        return false;
+    return transformFrameRange(context, "Shift Frames", [&](std::vector<uint32_t>& pixels, int width, int height, std::vector<uint32_t>& scratch) {
+        ImageTransform::offsetPixels(pixels, width, height, dx, dy, wrap, scratch);
+    });
+}
+
+bool EditCommands::flipFrames(AppContext& context, bool horizontal)
+{
+    const char* name = horizontal ? "Flip Frames Horizontal" : "Flip Frames Vertical";
+    return transformFrameRange(context, name, [&](std::vector<uint32_t>& pixels, int width, int height, std::vector<uint32_t>& scratch) {
+        ImageTransform::flipPixels(pixels, width, height, horizontal, scratch);
+    });
+}
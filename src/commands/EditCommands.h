@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/ImageTransform.h"
+
+class AppContext;
+
+/**
+ * @brief Edit 菜单命令集合
+ *
+ * 菜单项只负责转发到这里；每个命令都作用于传入上下文的“当前项目/当前帧/当前选区”。
+ * 所有命令在没有打开项目时直接返回 false，调用方无需额外判断。
+ *
+ * @return 各命令返回 true 表示执行成功（对于修改像素的命令，同时表示项目已标记 dirty）。
+ */
+class EditCommands
+{
+public:
+    // 复制当前选区（无选区时复制整帧）；存在浮动选区时复制浮动图像本身
+    static bool copy(AppContext& context);
+
+    // 复制“所见即所得”的合并结果：当前帧叠加浮动选区
+    static bool copyMerged(AppContext& context);
+
+    // 复制后清除复制的像素（无选区时为整帧）；存在浮动选区时直接把它移入剪贴板
+    static bool cut(AppContext& context);
+
+    // 粘贴为浮动选区，位置为复制时的位置（超出画布时向内收）
+    static bool paste(AppContext& context);
+
+    // 粘贴为浮动选区，严格保持复制时的位置
+    static bool pasteInPlace(AppContext& context);
+
+    // 在当前帧之后插入新帧，并把剪贴板内容原位粘贴到新帧上
+    static bool pasteAsNewFrame(AppContext& context);
+
+    // 清除选区内像素为透明；存在浮动选区时丢弃浮动选区
+    static bool deleteSelection(AppContext& context);
+
+    // 把时间线帧范围内每帧的选区像素（无选区时为整帧）抬起为浮动选区，原位置清为透明
+    static bool liftSelection(AppContext& context);
+
+    // 变换浮动选区；没有浮动选区时先抬起当前选区/帧范围
+    static bool transform(AppContext& context, const TransformStep& step);
+
+    // 把浮动选区写回帧（粘贴写入当前帧，抬起的写回各自的帧）
+    static bool commitFloating(AppContext& context);
+
+    // 丢弃浮动选区；抬起的内容按原位置写回
+    static void cancelFloating(AppContext& context);
+
+    // 把当前选区（存在浮动选区时为浮动图像）捕获为自定义笔刷；选区内没有不透明像素时返回 false
+    static bool newBrush(AppContext& context);
+
+    // 时间线帧范围内每帧整体平移 (dx, dy)：wrap 为 true 时移出的像素从另一侧移入，否则清为透明
+    static bool shiftFrames(AppContext& context, int dx, int dy, bool wrap);
+
+    // 时间线帧范围内每帧整体水平/垂直翻转
+    static bool flipFrames(AppContext& context, bool horizontal);
+};
@@ -0,0 +1,186 @@
+#include "commands/FilterCommands.h"
+
+#include "commands/EditCommands.h"
+#include "core/AppContext.h"
+#include "core/FramePatch.h"
+#include "core/Noise.h"
+#include "core/Parallel.h"
+#include "core/Project.h"
+#include "core/Selection.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char* morphologyName(MorphologyOp op)
+    {
+        switch (op)
+        {
+        case MorphologyOp::Outline:
+            return "Outline";
+        case MorphologyOp::Dilate:
+            return "Dilate";
+        case MorphologyOp::Erode:
+            return "Erode";
+        case MorphologyOp::DropShadow:
+            return "Drop Shadow";
+        default:
+            return "Filter";
+        }
+    }
+} // namespace
+
+bool FilterCommands::applyMorphology(AppContext& context, const MorphologyParams& params)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    EditCommands::commitFloating(context);
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const bool hasMask = selection.getWidth() == width && selection.getHeight() == height && !selection.isEmpty();
+    const Selection* limit = hasMask ? &selection : nullptr;
+
+    int first = 0;
+    int last = 0;
+    context.getFrameRange(first, last);
+
+    // 记录撤销需要访问共享的 tile 表，先串行拷贝原像素，再并行处理各帧
+    auto patch = std::make_unique<FramePatchCommand>(morphologyName(params.op), width, height);
+    for (int i = first; i <= last; ++i)
+        patch->captureFrame(*project, i);
+
+    std::atomic<bool> changed(false);
+    parallelFor(first, last + 1, [&](int frameIndex) {
+        if (Morphology::apply(project->getFrame(frameIndex), width, height, limit, params))
+            changed = true;
+    });
+
+    if (!changed.load())
+        return false;
+    if (patch->finalize(*project))
+        context.pushCommand(std::move(patch));
+    context.setProjectDirty(true);
+    return true;
+}
+
+bool FilterCommands::fillNoise(AppContext& context)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    EditCommands::commitFloating(context);
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const Selection& selection = context.getSelection();
+    const bool hasMask = selection.getWidth() == width && selection.getHeight() == height && !selection.isEmpty();
+    const Selection* limit = hasMask ? &selection : nullptr;
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = width - 1;
+    int y1 = height - 1;
+    if (hasMask)
+        selection.getBounds(x0, y0, x1, y1);
+
+    int first = 0;
+    int last = 0;
+    context.getFrameRange(first, last);
+
+    std::vector<uint32_t> colors;
+    context.buildNoiseColors(colors);
+
+    auto patch = std::make_unique<FramePatchCommand>("Noise", width, height);
+    for (int i = first; i <= last; ++i)
+        patch->captureRect(*project, i, x0, y0, x1, y1);
+
+    // 多帧时按帧并行（Noise::scatter 内部的按行并行此时退化为串行）；只有一帧时由 scatter 按行并行
+    std::atomic<bool> changed(false);
+    const uint64_t baseSeed = context.getNoiseSeed();
+    const int density = context.getNoiseDensity();
+    parallelFor(first, last + 1, [&](int i) {
+        const uint64_t seed = Noise::mixSeed(baseSeed, static_cast<uint64_t>(i));
+        if (Noise::scatter(project->getFrame(i), width, x0, y0, x1, y1, limit, colors, density, seed))
+            changed.store(true);
+    });
+    context.advanceNoiseSeed();
+
+    if (!changed)
+        return false;
+    if (patch->finalize(*project))
+        context.pushCommand(std::move(patch));
+    context.setProjectDirty(true);
+    return true;
+}
+
+bool FilterCommands::replaceColors(AppContext& context, const std::vector<ColorRemap::Pair>& pairs)
+{
+    Project* project = context.getProject();
+    if (!project)
+        return false;
+
+    ColorRemap remap;
+    remap.set(pairs);
+    if (remap.isEmpty())
+        return false;
+
+    EditCommands::commitFloating(context);
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const int frameCount = project->getFrameCount();
+    constexpr int kTile = FramePatchCommand::kTileSize;
+    const int tilesX = (width + kTile - 1) / kTile;
+    const int tilesY = (height + kTile - 1) / kTile;
+
+    // 按撤销记录的 tile 划分：回调 fn(frameIndex, 行首指针, 像素数) 遍历 tile 内的每一行
+    const auto forEachTileRow = [&](int frameIndex, int tileX, int tileY, auto&& fn) {
+        const int x0 = tileX * kTile;
+        const int count = std::min(kTile, width - x0);
+        const int y1 = std::min(height, (tileY + 1) * kTile);
+        uint32_t* pixels = project->getFrame(frameIndex).pixels.data();
+        for (int y = tileY * kTile; y < y1; ++y)
+        {
+            if (fn(pixels + static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x0), static_cast<size_t>(count)))
+                return true;
+        }
+        return false;
+    };
+
+    // 按帧并行：扫描含源颜色的 tile（命中一行即可停止），命中的 tile 先记录到该帧的撤销桶再替换。
+    // 撤销数据只与实际替换的范围成正比；不同帧写不同的桶，不需要加锁
+    auto patch = std::make_unique<FramePatchCommand>("Replace Color", width, height);
+    patch->reserveFrames(frameCount);
+    std::atomic<bool> anyHit(false);
+    parallelFor(0, frameCount, [&](int frameIndex) {
+        for (int ty = 0; ty < tilesY; ++ty)
+        {
+            for (int tx = 0; tx < tilesX; ++tx)
+            {
+                if (!forEachTileRow(frameIndex, tx, ty, [&](const uint32_t* row, size_t count) { return remap.containsAny(row, count); }))
+                    continue;
+                patch->captureRect(*project, frameIndex, tx * kTile, ty * kTile, tx * kTile + kTile - 1, ty * kTile + kTile - 1);
+                forEachTileRow(frameIndex, tx, ty, [&](uint32_t* row, size_t count) {
+                    remap.apply(row, count);
+                    return false;
+                });
+                anyHit.store(true);
+            }
+        }
+    });
+    if (!anyHit)
+        return false;
+
+    if (patch->finalize(*project))
+        context.pushCommand(std::move(patch));
+    context.setProjectDirty(true);
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/ColorRemap.h"
+#include "core/Morphology.h"
+
+#include <vector>
+
+class AppContext;
+
+/**
+ * @brief 像素滤镜命令集合（Edit > FX 等菜单/对话框转发到这里）
+ *
+ * 作用范围：时间线帧范围（未设置时为当前帧）；存在选区时只修改选区内像素。
+ * 存在浮动选区时先落地。多帧之间互不相关，按帧并行处理，整个范围只产生一条撤销记录。
+ * 撤销记录是 FramePatchCommand 的 32x32 tile 补丁：只保存被触及的 tile 的原像素，
+ * finalize 时丢弃内容没有变化的 tile。
+ *
+ * @return 返回 true 表示有像素被修改（同时已标记项目 dirty）。
+ */
+class FilterCommands
+{
+public:
+    // 描边 / 扩张 / 腐蚀 / 投影
+    static bool applyMorphology(AppContext& context, const MorphologyParams& params);
+
+    // 按喷枪的颜色来源与密度随机散布颜色；使用当前种子（每帧派生子种子），完成后种子前进一步
+    static bool fillNoise(AppContext& context);
+
+    /**
+     * @brief 把项目所有帧中的源颜色替换为目标颜色（不受帧范围和选区限制）
+     *
+     * 先按帧并行扫描出含源颜色的 tile，只为这些 tile 记录撤销补丁，再按帧并行替换。
+     */
+    static bool replaceColors(AppContext& context, const std::vector<ColorRemap::Pair>& pairs);
+};
@@ -5,10 +5,29 @@
 
 #include "AppContext.h"
 
-// 后续实现 CommandStack 后在此包含，并取消下方 TODO 注释
-// #include "CommandStack.h"
+#include "CommandStack.h"
+#include "Project.h"
 
-AppContext::AppContext() = default;
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+    // 内置调色板
+    const uint32_t kDefaultPalette[] = {
+        0xFF000000, 0xFFFFFFFF, 0xFF404040, 0xFFC0C0C0,
+        0xFF0000FF, 0xFF00FF00, 0xFFFF0000, 0xFF00FFFF,
+        0xFFFF00FF, 0xFFFFFF00, 0xFF804000, 0xFFFFA500,
+        0xFF8B4513, 0xFF800080, 0xFF008080, 0xFF1E90FF
+    };
+} // namespace
+
+AppContext::AppContext()
+    : palette_(std::begin(kDefaultPalette), std::end(kDefaultPalette)),
+      defaultPaletteSize_(static_cast<int>(palette_.size()))
+{
+}
 
 AppContext::~AppContext() = default;
 
@@ -20,38 +39,166 @@ void AppContext::setBrushSize(int size)
     brushSize_ = size;
 }
 
-void AppContext::setCanvasZoom(int zoom)
+void AppContext::setPaletteColor(int index, uint32_t rgba)
 {
-    static const int allowed[] = {1, 2, 4, 8, 16, 32};
-    for (int z : allowed) {
-        if (z == zoom) {
-            canvasZoom_ = z;
-            return;
-        }
+    if (index < 0 || index >= static_cast<int>(palette_.size()) || palette_[static_cast<size_t>(index)] == rgba)
+        return;
+    palette_[static_cast<size_t>(index)] = rgba;
+    ++paletteRevision_;
+}
+
+void AppContext::addPaletteColor(uint32_t rgba)
+{
+    palette_.push_back(rgba);
+    ++paletteRevision_;
+}
+
+const PaletteLut& AppContext::getPaletteLut() const
+{
+    paletteLut_.update(palette_, paletteRevision_);
+    return paletteLut_;
+}
+
+void AppContext::setShadeRampColors(std::vector<uint32_t> colors)
+{
+    shadeRampColors_ = std::move(colors);
+    ++shadeRampRevision_;
+}
+
+const ShadeRamp& AppContext::getShadeRamp() const
+{
+    shadeRamp_.update(shadeRampColors_, shadeRampRevision_);
+    return shadeRamp_;
+}
+
+void AppContext::setEyedropperSize(int size)
+{
+    // 取样窗口以鼠标所在像素为中心，只允许奇数边长
+    size = std::clamp(size, 1, kMaxEyedropperSize);
+    eyedropperSize_ = size | 1;
+}
+
+void AppContext::setNoiseDensity(int density)
+{
+    noiseDensity_ = std::clamp(density, 1, Noise::kMaxDensity);
+}
+
+void AppContext::setSprayRadius(int radius)
+{
+    sprayRadius_ = std::clamp(radius, 1, Noise::kMaxSprayRadius);
+}
+
+void AppContext::buildNoiseColors(std::vector<uint32_t>& out) const
+{
+    out.clear();
+    switch (noiseColors_)
+    {
+    case NoiseColors::TwoColors:
+        out.push_back(colorRGBA_);
+        out.push_back(secondaryColorRGBA_);
+        break;
+    case NoiseColors::ShadeRamp:
+        out = getShadeRamp().getColors();
+        break;
+    default:
+        break;
     }
-    // 非法值忽略，或 clamp 到最近
+    if (out.empty())
+        out.push_back(colorRGBA_);
+}
+
+void AppContext::advanceNoiseSeed()
+{
+    noiseSeed_ = static_cast<uint32_t>(Noise::mixSeed(noiseSeed_, 1));
+}
+
+void AppContext::setRadialFolds(int folds)
+{
+    radialFolds_ = std::clamp(folds, Symmetry::kMinRadialFolds, Symmetry::kMaxRadialFolds);
+}
+
+void AppContext::getFrameRange(int& first, int& last) const
+{
+    if (!hasFrameRange())
+    {
+        first = last = currentFrameIndex_;
+        return;
+    }
+
+    const int maxIndex = project_ ? std::max(0, project_->getFrameCount() - 1) : 0;
+    first = std::clamp(frameRangeFirst_, 0, maxIndex);
+    last = std::clamp(frameRangeLast_, first, maxIndex);
+}
+
+void AppContext::setFrameRange(int first, int last)
+{
+    if (first > last) std::swap(first, last);
+    frameRangeFirst_ = std::max(0, first);
+    frameRangeLast_ = std::max(0, last);
+}
+
+void AppContext::setWandTolerance(int tolerance)
+{
+    if (tolerance < 0) tolerance = 0;
+    if (tolerance > 255) tolerance = 255;
+    wandTolerance_ = tolerance;
+}
+
+void AppContext::setCanvasZoom(float zoom)
+{
+    if (!(zoom > 0.0f))
+        return;
+    canvasZoom_ = std::clamp(zoom, kMinCanvasZoom, kMaxCanvasZoom);
+}
+
+void AppContext::zoomCanvasAt(float zoom, float anchorX, float anchorY)
+{
+    const float previous = canvasZoom_;
+    setCanvasZoom(zoom);
+    // 画布点 p 的屏幕位置 = 中心 + 平移 + (p - 画布中心) * 缩放；锚点处 p 不变可解出新平移
+    const float ratio = canvasZoom_ / previous;
+    canvasPanX_ = anchorX + (canvasPanX_ - anchorX) * ratio;
+    canvasPanY_ = anchorY + (canvasPanY_ - anchorY) * ratio;
 }
 
 bool AppContext::canUndo() const
 {
-    // TODO: 实现 CommandStack 后改为 return commandStack_ && commandStack_->canUndo();
-    return false;
+    return commandStack_ && commandStack_->canUndo();
 }
 
 bool AppContext::canRedo() const
 {
-    // TODO: 实现 CommandStack 后改为 return commandStack_ && commandStack_->canRedo();
-    return false;
+    return commandStack_ && commandStack_->canRedo();
 }
 
 void AppContext::undo()
 {
-    // TODO: 实现 CommandStack 后取消注释：
-    // if (commandStack_) commandStack_->undo();
+    // 浮动选区存在期间不会产生新记录：粘贴的直接丢弃；抬起的丢弃后撤销抬起记录，恢复原像素
+    if (floating_.isActive())
+    {
+        const bool lifted = floating_.isLifted();
+        floating_.clear();
+        if (!lifted)
+            return;
+    }
+    if (commandStack_)
+        commandStack_->undo(*this);
 }
 
 void AppContext::redo()
 {
-    // TODO: 实现 CommandStack 后取消注释：
-    // if (commandStack_) commandStack_->redo();
+    if (commandStack_)
+        commandStack_->redo(*this);
+}
+
+void AppContext::pushCommand(std::unique_ptr<Command> command)
+{
+    if (commandStack_)
+        commandStack_->push(std::move(command));
+}
+
+void AppContext::clearUndoHistory()
+{
+    if (commandStack_)
+        commandStack_->clear();
 }
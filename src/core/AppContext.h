@@ -8,12 +8,27 @@
 
 #pragma once
 
+#include "core/Dither.h"
+#include "core/FloatingSelection.h"
+#include "core/Noise.h"
+#include "core/OnionSkin.h"
+#include "core/PaletteLut.h"
+#include "core/Selection.h"
+#include "core/ShadeRamp.h"
+#include "core/Symmetry.h"
+#include "core/Tiling.h"
+
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // 前向声明，避免在头文件中包含尚未实现的类型，减少编译依赖与循环引用
 class Project;
+class Command;
 class CommandStack;
+class CustomBrush;
 
 /**
  * @brief 当前选中的绘图工具类型
@@ -29,9 +44,50 @@ enum class ToolType : int
     Line,          // 直线
     Rect,          // 矩形
     RectFilled,    // 填充矩形
+    MagicWand,     // 魔棒（按颜色/连续区域建立选区）
+    Gradient,      // 渐变（量化到调色板的有序抖动）
+    Shade,         // 明暗笔（沿调色板色带移动颜色）
+    Spray,         // 喷枪（按密度随机散布颜色）
     Count          // 工具数量，用于遍历与边界检查
 };
 
+/**
+ * @brief 吸管取色来源
+ */
+enum class EyedropperMode : int
+{
+    CurrentFrame = 0,   // 只读当前帧像素（含透明度）
+    Merged,             // 画布上看到的结果：当前帧叠加浮动选区
+    Count
+};
+
+/**
+ * @brief 画布纹理的上传方式
+ */
+enum class CanvasUploadMode : int
+{
+    Direct = 0,    // glTexSubImage2D 直接读取帧内存
+    PixelBuffer,   // 先拷入像素缓冲对象（PBO）环，驱动异步搬运到纹理
+    Count
+};
+
+/**
+ * @brief 需要由项目窗口弹出的对话框
+ *
+ * 菜单只登记请求，项目窗口在自己的渲染帧中打开对应的弹窗（与 New Project 弹窗的做法一致）。
+ */
+enum class EditorDialog : int
+{
+    None = 0,
+    Outline,       // FX > Outline...
+    Dilate,        // FX > Dilate...
+    Erode,         // FX > Erode...
+    DropShadow,    // FX > Drop Shadow...
+    ShiftFrames,   // Shift > Offset...
+    ReplaceColor,  // Edit > Replace Color...
+    Count
+};
+
 /**
  * @brief 应用程序/编辑器上下文
  *
@@ -128,6 +184,28 @@ public:
         currentFrameIndex_ = index; 
     }
 
+    /**
+     * @brief 时间线上选中的帧范围（闭区间），供跨帧编辑（抬起/变换等）使用
+     * 未设置范围时 getFrameRange 返回“仅当前帧”；结果按项目帧数钳制
+     */
+    void getFrameRange(int& first, int& last) const;
+
+    // 是否设置了帧范围
+    bool hasFrameRange() const
+    {
+        return frameRangeFirst_ >= 0;
+    }
+
+    // 设置帧范围；顺序无关，内部按 first <= last 保存
+    void setFrameRange(int first, int last);
+
+    // 清除帧范围（回到只编辑当前帧）
+    void clearFrameRange()
+    {
+        frameRangeFirst_ = -1;
+        frameRangeLast_ = -1;
+    }
+
     // -------------------------------------------------------------------------
     // 绘图工具与颜色
     // -------------------------------------------------------------------------
@@ -159,6 +237,125 @@ public:
         colorRGBA_ = rgba; 
     }
 
+    // 背景色（RGBA8888），作为渐变的终点色
+    uint32_t getSecondaryColorRGBA() const
+    {
+        return secondaryColorRGBA_;
+    }
+    void setSecondaryColorRGBA(uint32_t rgba)
+    {
+        secondaryColorRGBA_ = rgba;
+    }
+
+    // 调色板：前 getDefaultPaletteSize() 个为内置颜色，其后为用户添加的颜色
+    const std::vector<uint32_t>& getPalette() const
+    {
+        return palette_;
+    }
+    int getDefaultPaletteSize() const
+    {
+        return defaultPaletteSize_;
+    }
+    void setPaletteColor(int index, uint32_t rgba);
+    void addPaletteColor(uint32_t rgba);
+
+    // 调色板版本号：每次修改调色板递增，依赖调色板的缓存据此判断是否需要重建
+    uint64_t getPaletteRevision() const
+    {
+        return paletteRevision_;
+    }
+
+    // 当前调色板的最近色查找表（按版本号惰性重建）
+    const PaletteLut& getPaletteLut() const;
+
+    // 明暗色带：按值保存的颜色序列，与调色板之后的修改无关
+    const std::vector<uint32_t>& getShadeRampColors() const
+    {
+        return shadeRampColors_;
+    }
+    void setShadeRampColors(std::vector<uint32_t> colors);
+
+    // 当前色带的颜色 -> 位置查找表（按版本号惰性重建）
+    const ShadeRamp& getShadeRamp() const;
+
+    // 明暗笔每次移动的级数：+1 沿色带向后，-1 向前
+    int getShadeStep() const
+    {
+        return shadeStep_;
+    }
+    void setShadeStep(int step)
+    {
+        shadeStep_ = step < 0 ? -1 : 1;
+    }
+
+    // 渐变工具的形状与抖动矩阵
+    GradientShape getGradientShape() const
+    {
+        return gradientShape_;
+    }
+    void setGradientShape(GradientShape shape)
+    {
+        gradientShape_ = shape;
+    }
+    DitherMatrix getDitherMatrix() const
+    {
+        return ditherMatrix_;
+    }
+    void setDitherMatrix(DitherMatrix matrix)
+    {
+        ditherMatrix_ = matrix;
+    }
+
+    // 吸管：取色来源与取样范围（N x N 取平均，N 为奇数，1 表示单像素）
+    static constexpr int kMaxEyedropperSize = 9;
+    EyedropperMode getEyedropperMode() const
+    {
+        return eyedropperMode_;
+    }
+    void setEyedropperMode(EyedropperMode mode)
+    {
+        eyedropperMode_ = mode;
+    }
+    int getEyedropperSize() const
+    {
+        return eyedropperSize_;
+    }
+    void setEyedropperSize(int size);
+
+    // 喷枪/噪点：颜色来源、密度（百分比）与喷枪半径
+    NoiseColors getNoiseColors() const
+    {
+        return noiseColors_;
+    }
+    void setNoiseColors(NoiseColors colors)
+    {
+        noiseColors_ = colors;
+    }
+    int getNoiseDensity() const
+    {
+        return noiseDensity_;
+    }
+    void setNoiseDensity(int density);
+    int getSprayRadius() const
+    {
+        return sprayRadius_;
+    }
+    void setSprayRadius(int radius);
+
+    // 按颜色来源生成本次散布使用的颜色列表（至少包含前景色）
+    void buildNoiseColors(std::vector<uint32_t>& out) const;
+
+    // 随机种子：同一种子对同一输入总是产生相同像素；每次喷涂/填充后自动前进一步
+    uint32_t getNoiseSeed() const
+    {
+        return noiseSeed_;
+    }
+    void setNoiseSeed(uint32_t seed)
+    {
+        noiseSeed_ = seed;
+    }
+    void advanceNoiseSeed();
+
     // 画笔半径（像素），1/2/3 等，供 Brush/Eraser 使用
     int getBrushSize() const 
     { 
@@ -168,18 +365,138 @@ public:
     // 设置画笔半径
     void setBrushSize(int size);
 
+    // 1 像素笔画是否去除 L 形拐角（pixel-perfect）
+    bool isPixelPerfect() const
+    {
+        return pixelPerfect_;
+    }
+    void setPixelPerfect(bool enabled)
+    {
+        pixelPerfect_ = enabled;
+    }
+
+    // 自定义笔刷（从选区捕获）；非空时画笔工具改用它盖章
+    const std::shared_ptr<const CustomBrush>& getCustomBrush() const
+    {
+        return customBrush_;
+    }
+    void setCustomBrush(std::shared_ptr<const CustomBrush> brush)
+    {
+        customBrush_ = std::move(brush);
+    }
+
+    // 自定义笔刷只取形状、用前景色绘制
+    bool isCustomBrushUsingColor() const
+    {
+        return customBrushUseColor_;
+    }
+    void setCustomBrushUsingColor(bool enabled)
+    {
+        customBrushUseColor_ = enabled;
+    }
+
+    // 对称绘制模式（作用于画笔、橡皮擦、填充等绘制工具）
+    SymmetryMode getSymmetryMode() const
+    {
+        return symmetryMode_;
+    }
+    void setSymmetryMode(SymmetryMode mode)
+    {
+        symmetryMode_ = mode;
+    }
+
+    // 平铺模式：画布显示环绕预览，绘制工具跨边环绕
+    TiledMode getTiledMode() const
+    {
+        return tiledMode_;
+    }
+    void setTiledMode(TiledMode mode)
+    {
+        tiledMode_ = mode;
+    }
+
+    // 径向对称份数（2~16）
+    int getRadialFolds() const
+    {
+        return radialFolds_;
+    }
+    void setRadialFolds(int folds);
+
+    // -------------------------------------------------------------------------
+    // 选区
+    // -------------------------------------------------------------------------
+
+    // 当前选区（尺寸跟随画布，由画布面板在尺寸变化时同步）
+    Selection& getSelection()
+    {
+        return selection_;
+    }
+    const Selection& getSelection() const
+    {
+        return selection_;
+    }
+
+    // 浮动选区（粘贴后尚未写回帧的图像层）
+    FloatingSelection& getFloatingSelection()
+    {
+        return floating_;
+    }
+    const FloatingSelection& getFloatingSelection() const
+    {
+        return floating_;
+    }
+
+    // 魔棒/按颜色选择的通道容差（0~255，0 为精确匹配）
+    int getWandTolerance() const
+    {
+        return wandTolerance_;
+    }
+    void setWandTolerance(int tolerance);
+
+    // 魔棒是否只选连续区域；false 时等价于“选择所有同色像素”
+    bool isWandContiguous() const
+    {
+        return wandContiguous_;
+    }
+    void setWandContiguous(bool contiguous)
+    {
+        wandContiguous_ = contiguous;
+    }
+
+    // 新选区与已有选区的合并方式
+    SelectionMode getSelectionMode() const
+    {
+        return selectionMode_;
+    }
+    void setSelectionMode(SelectionMode mode)
+    {
+        selectionMode_ = mode;
+    }
+
     // -------------------------------------------------------------------------
     // 画布视图（缩放与平移）
     // -------------------------------------------------------------------------
 
-    // 画布缩放倍率（整数倍，如 1/2/4/8）
-    int getCanvasZoom() const 
+    // 画布缩放范围：缩小到 1/32 可以把大画布整张放进面板
+    static constexpr float kMinCanvasZoom = 1.0f / 32.0f;
+    static constexpr float kMaxCanvasZoom = 64.0f;
+
+    // 画布缩放倍率（每个画布像素的屏幕尺寸，可以是小数）
+    float getCanvasZoom() const 
     { 
         return canvasZoom_; 
     }
 
-    // 设置画布缩放；建议限制在 [1, 2, 4, 8, 16] 等 
-    void setCanvasZoom(int zoom);
+    // 设置画布缩放；限制在 [kMinCanvasZoom, kMaxCanvasZoom]
+    void setCanvasZoom(float zoom);
+
+    /**
+     * @brief 以锚点为中心缩放：锚点下的画布位置保持不动
+     *
+     * 画布默认居中显示，平移量相对面板中心，所以锚点也以面板中心为原点（屏幕像素）；
+     * 锚点取 (0, 0) 即以面板中心缩放。
+     */
+    void zoomCanvasAt(float zoom, float anchorX, float anchorY);
 
     // 画布平移 X（像素，屏幕空间）
     float getCanvasPanX() const 
@@ -229,16 +546,36 @@ public:
     // 是否可重做
     bool canRedo() const;
 
-    // 执行一次撤销；内部调用 CommandStack::Undo()
+    // 执行一次撤销；内部调用 CommandStack::undo()。存在浮动选区时先丢弃浮动选区
     void undo();
 
-    // 执行一次重做；内部调用 CommandStack::Redo()
+    // 执行一次重做；内部调用 CommandStack::redo()
     void redo();
 
+    // 记录一条已执行的命令；未设置命令栈时直接丢弃
+    void pushCommand(std::unique_ptr<Command> command);
+
+    // 结构性修改（增删帧、改画布尺寸）后调用，清空撤销记录
+    void clearUndoHistory();
+
     // -------------------------------------------------------------------------
     // 视图/UI 状态（可选，供 View 菜单、面板显隐使用）
     // -------------------------------------------------------------------------
 
+    // 请求项目窗口打开对话框
+    void requestDialog(EditorDialog dialog)
+    {
+        pendingDialog_ = dialog;
+    }
+
+    // 取出并清除待打开的对话框请求
+    EditorDialog takeDialogRequest()
+    {
+        const EditorDialog dialog = pendingDialog_;
+        pendingDialog_ = EditorDialog::None;
+        return dialog;
+    }
+
     // 是否显示网格线
     bool isGridVisible() const 
     { 
@@ -263,6 +600,16 @@ public:
         onionSkinEnabled_ = enabled; 
     }
 
+    // 洋葱皮显示的邻帧数量与各层色调/不透明度
+    const OnionSkinSettings& getOnionSkinSettings() const
+    {
+        return onionSkinSettings_;
+    }
+    void setOnionSkinSettings(const OnionSkinSettings& settings)
+    {
+        onionSkinSettings_ = settings;
+    }
+
     // 是否显示时间线面板
     bool isTimelineVisible() const 
     { 
@@ -286,6 +633,16 @@ public:
         checkerboardBackground_ = enabled;
     }
 
+    // 画布纹理上传方式（View > Canvas Upload，用于对比两条路径的耗时）
+    CanvasUploadMode getCanvasUploadMode() const
+    {
+        return canvasUploadMode_;
+    }
+    void setCanvasUploadMode(CanvasUploadMode mode)
+    {
+        canvasUploadMode_ = mode;
+    }
+
 private:
     // 项目与文档
     Project* project_ = nullptr;
@@ -295,14 +652,48 @@ private:
     // 动画与帧
     int currentAnimationIndex_ = 0;
     int currentFrameIndex_ = 0;
+    int frameRangeFirst_ = -1;   // -1 表示未设置帧范围
+    int frameRangeLast_ = -1;
 
     // 工具与颜色
     ToolType tool_ = ToolType::Brush;
     uint32_t colorRGBA_ = 0xFF000000;  // 默认不透明黑
+    uint32_t secondaryColorRGBA_ = 0xFFFFFFFF;  // 默认不透明白
     int brushSize_ = 1;
+    bool pixelPerfect_ = false;
+    std::shared_ptr<const CustomBrush> customBrush_;
+    bool customBrushUseColor_ = false;
+    SymmetryMode symmetryMode_ = SymmetryMode::None;
+    int radialFolds_ = 4;
+    TiledMode tiledMode_ = TiledMode::None;
+    GradientShape gradientShape_ = GradientShape::Linear;
+    DitherMatrix ditherMatrix_ = DitherMatrix::Bayer4;
+    EyedropperMode eyedropperMode_ = EyedropperMode::CurrentFrame;
+    int eyedropperSize_ = 1;
+    NoiseColors noiseColors_ = NoiseColors::Foreground;
+    int noiseDensity_ = 25;
+    int sprayRadius_ = 6;
+    uint32_t noiseSeed_ = 1;
+
+    // 调色板
+    std::vector<uint32_t> palette_;
+    int defaultPaletteSize_ = 0;
+    uint64_t paletteRevision_ = 0;
+    mutable PaletteLut paletteLut_;
+    std::vector<uint32_t> shadeRampColors_;
+    uint64_t shadeRampRevision_ = 0;
+    mutable ShadeRamp shadeRamp_;
+    int shadeStep_ = 1;
+
+    // 选区
+    Selection selection_;
+    FloatingSelection floating_;
+    int wandTolerance_ = 0;
+    bool wandContiguous_ = true;
+    SelectionMode selectionMode_ = SelectionMode::Replace;
 
     // 画布视图
-    int canvasZoom_ = 4;       // 默认 4 倍
+    float canvasZoom_ = 4.0f;  // 默认 4 倍
     float canvasPanX_ = 0.0f;
     float canvasPanY_ = 0.0f;
 
@@ -312,6 +703,9 @@ private:
     // 视图选项
     bool gridVisible_ = false;
     bool onionSkinEnabled_ = false;
+    OnionSkinSettings onionSkinSettings_;
     bool timelineVisible_ = true;
     bool checkerboardBackground_ = true;
+    CanvasUploadMode canvasUploadMode_ = CanvasUploadMode::Direct;
+    EditorDialog pendingDialog_ = EditorDialog::None;
 };
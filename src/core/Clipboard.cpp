@@ -0,0 +1,10 @@
+#include "core/Clipboard.h"
+
+#include <utility>
+
+void Clipboard::setImage(std::shared_ptr<const ImageBuffer> image, int originX, int originY)
+{
+    image_ = std::move(image);
+    originX_ = originX;
+    originY_ = originY;
+}
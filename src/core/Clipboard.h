@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/ImageBuffer.h"
+
+#include <memory>
+
+/**
+ * @brief 应用内剪贴板（所有项目窗口共享）
+ *
+ * 保存最近一次 Copy/Cut 的图像块及其来源位置。图像以 shared_ptr 持有且不可变，
+ * 粘贴出的浮动选区直接引用同一份数据，多次粘贴不会再复制像素。
+ */
+class Clipboard
+{
+public:
+    static Clipboard& getInstance()
+    {
+        static Clipboard instance;
+        return instance;
+    }
+
+    // 是否有可粘贴的内容
+    bool hasImage() const
+    {
+        return image_ != nullptr;
+    }
+
+    // 设置剪贴板内容；(originX, originY) 为复制时图像左上角在画布中的位置
+    void setImage(std::shared_ptr<const ImageBuffer> image, int originX, int originY);
+
+    const std::shared_ptr<const ImageBuffer>& getImage() const
+    {
+        return image_;
+    }
+    int getOriginX() const
+    {
+        return originX_;
+    }
+    int getOriginY() const
+    {
+        return originY_;
+    }
+
+private:
+    Clipboard() = default;
+    Clipboard(const Clipboard&) = delete;
+    Clipboard& operator=(const Clipboard&) = delete;
+
+    std::shared_ptr<const ImageBuffer> image_;
+    int originX_ = 0;
+    int originY_ = 0;
+};
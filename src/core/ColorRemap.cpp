@@ -0,0 +1,132 @@
+#include "core/ColorRemap.h"
+
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+
+void ColorRemap::set(const std::vector<Pair>& pairs)
+{
+    // 先去重（先出现的优先，包括源与目标相同的项），再丢弃不改变颜色的项
+    std::vector<Pair> unique;
+    unique.reserve(pairs.size());
+    for (const Pair& pair : pairs)
+    {
+        const bool duplicate = std::any_of(unique.begin(), unique.end(), [&](const Pair& p) { return p.first == pair.first; });
+        if (!duplicate)
+            unique.push_back(pair);
+    }
+    unique.erase(std::remove_if(unique.begin(), unique.end(), [](const Pair& p) { return p.first == p.second; }), unique.end());
+    std::sort(unique.begin(), unique.end(), [](const Pair& a, const Pair& b) { return a.first < b.first; });
+
+    sources_.clear();
+    targets_.clear();
+    deltas_.clear();
+    for (const Pair& pair : unique)
+    {
+        sources_.push_back(pair.first);
+        targets_.push_back(pair.second);
+        deltas_.push_back(pair.first ^ pair.second);
+    }
+}
+
+bool ColorRemap::lookup(uint32_t color, uint32_t& target) const
+{
+    const auto it = std::lower_bound(sources_.begin(), sources_.end(), color);
+    if (it == sources_.end() || *it != color)
+        return false;
+    target = targets_[static_cast<size_t>(it - sources_.begin())];
+    return true;
+}
+
+bool ColorRemap::containsAny(const uint32_t* pixels, size_t count) const
+{
+    if (sources_.empty())
+        return false;
+
+    size_t i = 0;
+#if PA_HAS_SSE2
+    if (usePrefilter())
+    {
+        const size_t sourceCount = sources_.size();
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+            __m128i hit = _mm_setzero_si128();
+            for (size_t s = 0; s < sourceCount; ++s)
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(sources_[s]))));
+            if (_mm_movemask_epi8(hit) != 0)
+                return true;
+        }
+    }
+#endif
+    uint32_t target = 0;
+    for (; i < count; ++i)
+    {
+        if (lookup(pixels[i], target))
+            return true;
+    }
+    return false;
+}
+
+bool ColorRemap::apply(uint32_t* pixels, size_t count) const
+{
+    if (sources_.empty())
+        return false;
+
+    bool changed = false;
+    size_t i = 0;
+#if PA_HAS_SSE2
+    if (usePrefilter())
+    {
+        // 源颜色互不相同，每个像素至多与一个源相等；delta 不为 0（恒等映射已在 set 中剔除）
+        const size_t sourceCount = sources_.size();
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+            // 两个累加器交错，缩短或运算的依赖链
+            __m128i deltaA = zero;
+            __m128i deltaB = zero;
+            size_t s = 0;
+            for (; s + 2 <= sourceCount; s += 2)
+            {
+                const __m128i eqA = _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(sources_[s])));
+                const __m128i eqB = _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(sources_[s + 1])));
+                deltaA = _mm_or_si128(deltaA, _mm_and_si128(eqA, _mm_set1_epi32(static_cast<int>(deltas_[s]))));
+                deltaB = _mm_or_si128(deltaB, _mm_and_si128(eqB, _mm_set1_epi32(static_cast<int>(deltas_[s + 1]))));
+            }
+            if (s < sourceCount)
+            {
+                const __m128i eq = _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(sources_[s])));
+                deltaA = _mm_or_si128(deltaA, _mm_and_si128(eq, _mm_set1_epi32(static_cast<int>(deltas_[s]))));
+            }
+            const __m128i delta = _mm_or_si128(deltaA, deltaB);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(delta, zero)) == 0xFFFF)
+                continue;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_xor_si128(v, delta));
+            changed = true;
+        }
+    }
+#endif
+    // 标量路径：相邻像素多为同色，缓存上一次的查表结果
+    bool hasLast = false;
+    bool lastHit = false;
+    uint32_t lastIn = 0;
+    uint32_t lastOut = 0;
+    for (; i < count; ++i)
+    {
+        const uint32_t color = pixels[i];
+        if (!hasLast || color != lastIn)
+        {
+            lastIn = color;
+            lastHit = lookup(color, lastOut);
+            hasLast = true;
+        }
+        if (lastHit)
+        {
+            pixels[i] = lastOut;
+            changed = true;
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 颜色替换表：把一组源颜色映射到目标颜色
+ *
+ * 替换表通常只有十几种颜色：SSE2 下把 4 个像素同时与每个源颜色做相等比较，
+ * 扫描时 4 个像素都不命中即跳过；替换时利用 像素 ^ (源 ^ 目标) = 目标，
+ * 按比较掩码把各源的异或差累积起来一次写回，无需查表和分支。
+ * 源颜色超过 kPrefilterLimit 种时逐源比较不再划算，改为按值排序后二分查找（缓存上一次的结果）。
+ */
+class ColorRemap
+{
+public:
+    static constexpr int kPrefilterLimit = 32;
+
+    using Pair = std::pair<uint32_t, uint32_t>;
+
+    // 设置映射；源颜色重复时以先出现的为准，源与目标相同的项被忽略
+    void set(const std::vector<Pair>& pairs);
+
+    bool isEmpty() const
+    {
+        return sources_.empty();
+    }
+
+    // count 个连续像素中是否含有任一源颜色
+    bool containsAny(const uint32_t* pixels, size_t count) const;
+
+    // 替换 count 个连续像素；返回 true 表示有像素被修改
+    bool apply(uint32_t* pixels, size_t count) const;
+
+private:
+    bool lookup(uint32_t color, uint32_t& target) const;
+    bool usePrefilter() const
+    {
+        return sources_.size() <= static_cast<size_t>(kPrefilterLimit);
+    }
+
+    std::vector<uint32_t> sources_;   // 升序
+    std::vector<uint32_t> targets_;   // 与 sources_ 一一对应
+    std::vector<uint32_t> deltas_;    // sources_[i] ^ targets_[i]
+};
@@ -0,0 +1,45 @@
+#include "core/CommandStack.h"
+
+#include <algorithm>
+#include <utility>
+
+CommandStack::CommandStack(size_t limit)
+    : limit_(std::max<size_t>(1, limit))
+{
+}
+
+CommandStack::~CommandStack() = default;
+
+void CommandStack::push(std::unique_ptr<Command> command)
+{
+    if (!command)
+        return;
+
+    commands_.erase(commands_.begin() + static_cast<std::ptrdiff_t>(cursor_), commands_.end());
+    commands_.push_back(std::move(command));
+    if (commands_.size() > limit_)
+        commands_.erase(commands_.begin());
+    cursor_ = commands_.size();
+}
+
+void CommandStack::undo(AppContext& context)
+{
+    if (!canUndo())
+        return;
+    --cursor_;
+    commands_[cursor_]->undo(context);
+}
+
+void CommandStack::redo(AppContext& context)
+{
+    if (!canRedo())
+        return;
+    commands_[cursor_]->redo(context);
+    ++cursor_;
+}
+
+void CommandStack::clear()
+{
+    commands_.clear();
+    cursor_ = 0;
+}
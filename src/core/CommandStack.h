@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class AppContext;
+
+/**
+ * @brief 可撤销的编辑操作
+ *
+ * 命令在入栈前已经执行完毕（例如笔画已经画到帧上），入栈后只负责 undo/redo。
+ */
+class Command
+{
+public:
+    virtual ~Command() = default;
+
+    // 显示在 Undo History 中的名称
+    virtual const std::string& getName() const = 0;
+
+    virtual void undo(AppContext& context) = 0;
+    virtual void redo(AppContext& context) = 0;
+};
+
+/**
+ * @brief 撤销/重做栈
+ *
+ * - push 会清空重做分支；超过上限时丢弃最早的记录
+ * - 帧的插入/删除、画布尺寸变化等结构性修改不记录为命令，发生时调用 clear()，
+ *   避免旧记录按帧索引写回到错误的帧上
+ */
+class CommandStack
+{
+public:
+    explicit CommandStack(size_t limit = 256);
+    ~CommandStack();
+
+    void push(std::unique_ptr<Command> command);
+
+    bool canUndo() const
+    {
+        return cursor_ > 0;
+    }
+    bool canRedo() const
+    {
+        return cursor_ < commands_.size();
+    }
+
+    void undo(AppContext& context);
+    void redo(AppContext& context);
+
+    // 清空全部记录
+    void clear();
+
+    // 历史记录（[0, getUndoCount()) 为可撤销部分，其余为可重做部分）
+    size_t getCount() const
+    {
+        return commands_.size();
+    }
+    size_t getUndoCount() const
+    {
+        return cursor_;
+    }
+    const std::string& getName(size_t index) const
+    {
+        return commands_[index]->getName();
+    }
+
+private:
+    std::vector<std::unique_ptr<Command>> commands_;
+    size_t cursor_ = 0;   // 下一次 redo 的位置，也是可撤销记录的数量
+    size_t limit_ = 256;
+};
@@ -0,0 +1,224 @@
+#include "core/Dither.h"
+
+#include "core/PaletteLut.h"
+#include "core/Parallel.h"
+#include "core/Selection.h"
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // 8x8 Bayer 矩阵；左上 n x n 子块右移后即为 n x n 的 Bayer 矩阵
+    constexpr int kBayer8[8][8] = {
+        {0, 32, 8, 40, 2, 34, 10, 42},
+        {48, 16, 56, 24, 50, 18, 58, 26},
+        {12, 44, 4, 36, 14, 46, 6, 38},
+        {60, 28, 52, 20, 62, 30, 54, 22},
+        {3, 35, 11, 43, 1, 33, 9, 41},
+        {51, 19, 59, 27, 49, 17, 57, 25},
+        {15, 47, 7, 39, 13, 45, 5, 37},
+        {63, 31, 55, 23, 61, 29, 53, 21},
+    };
+
+    int matrixSize(DitherMatrix matrix)
+    {
+        switch (matrix)
+        {
+        case DitherMatrix::Bayer2:
+            return 2;
+        case DitherMatrix::Bayer4:
+            return 4;
+        case DitherMatrix::Bayer8:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    uint32_t lerpColor(uint32_t a, uint32_t b, float t)
+    {
+        uint32_t out = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            const float ca = static_cast<float>((a >> shift) & 0xFF);
+            const float cb = static_cast<float>((b >> shift) & 0xFF);
+            const uint32_t c = static_cast<uint32_t>(ca + (cb - ca) * t + 0.5f);
+            out |= (std::min<uint32_t>(c, 255u)) << shift;
+        }
+        return out;
+    }
+
+    // 色带：kRampSize 级插值色，每级映射到调色板；返回色带中颜色的级数
+    int buildRamp(const GradientParams& params, const PaletteLut& lut, std::vector<uint32_t>& ramp)
+    {
+        ramp.resize(Dither::kRampSize);
+        int levels = 1;
+        for (int i = 0; i < Dither::kRampSize; ++i)
+        {
+            const float t = static_cast<float>(i) / static_cast<float>(Dither::kRampSize - 1);
+            const uint32_t color = lerpColor(params.startColor, params.endColor, t);
+            // 调色板颜色不带渐变的透明度，保留插值出的 alpha
+            const uint32_t mapped = lut.isEmpty() ? color : ((lut.nearest(color) & 0x00FFFFFFu) | (color & 0xFF000000u));
+            ramp[static_cast<size_t>(i)] = mapped;
+            if (i > 0 && mapped != ramp[static_cast<size_t>(i - 1)])
+                ++levels;
+        }
+        return levels;
+    }
+
+    /**
+     * @brief 一行像素的色带下标计算
+     *
+     * value(x) = base + x * stepX（线性）或 |(x, dy)| * radialScale（径向），再叠加阈值；
+     * 结果四舍五入并钳制到 [0, kRampSize - 1]。
+     */
+    struct RowKernel
+    {
+        GradientShape shape = GradientShape::Linear;
+        float base = 0.0f;        // 线性：行起点 x = 0 处的值
+        float stepX = 0.0f;       // 线性：每像素增量
+        float centerX = 0.0f;     // 径向：圆心 x（像素中心坐标）
+        float dy2 = 0.0f;         // 径向：(py - cy)^2
+        float radialScale = 0.0f; // 径向：距离 -> 色带下标
+        const float* thresholds = nullptr; // 12 个元素：x & 7 起连续读取 4 个
+
+        int scalarIndex(int x) const
+        {
+            float value = 0.0f;
+            if (shape == GradientShape::Linear)
+            {
+                value = base + static_cast<float>(x) * stepX;
+            }
+            else
+            {
+                const float dx = static_cast<float>(x) + 0.5f - centerX;
+                value = std::sqrt(dx * dx + dy2) * radialScale;
+            }
+            value += thresholds[x & 7] + 0.5f;
+            value = std::clamp(value, 0.0f, static_cast<float>(Dither::kRampSize - 1));
+            return static_cast<int>(value);
+        }
+    };
+
+    void renderRow(uint32_t* row,
+                   const uint64_t* maskWords,
+                   int x0,
+                   int x1,
+                   const RowKernel& kernel,
+                   const uint32_t* ramp)
+    {
+        const auto write = [&](int x, int index) {
+            if (!maskWords || ((maskWords[x >> 6] >> (x & 63)) & 1u))
+                row[x] = ramp[index];
+        };
+
+        int x = x0;
+#if PA_HAS_SSE2
+        alignas(16) int indices[4];
+        const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 maxIndex = _mm_set1_ps(static_cast<float>(Dither::kRampSize - 1));
+        if (kernel.shape == GradientShape::Linear)
+        {
+            const __m128 step = _mm_set1_ps(kernel.stepX);
+            const __m128 base = _mm_set1_ps(kernel.base);
+            for (; x + 3 <= x1; x += 4)
+            {
+                const __m128 xs = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lanes);
+                __m128 value = _mm_add_ps(base, _mm_mul_ps(xs, step));
+                value = _mm_add_ps(value, _mm_add_ps(_mm_loadu_ps(kernel.thresholds + (x & 7)), half));
+                value = _mm_min_ps(_mm_max_ps(value, zero), maxIndex);
+                _mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(value));
+                for (int i = 0; i < 4; ++i)
+                    write(x + i, indices[i]);
+            }
+        }
+        else
+        {
+            const __m128 center = _mm_set1_ps(kernel.centerX - 0.5f);
+            const __m128 dy2 = _mm_set1_ps(kernel.dy2);
+            const __m128 scale = _mm_set1_ps(kernel.radialScale);
+            for (; x + 3 <= x1; x += 4)
+            {
+                const __m128 dx = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lanes), center);
+                __m128 value = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dy2)), scale);
+                value = _mm_add_ps(value, _mm_add_ps(_mm_loadu_ps(kernel.thresholds + (x & 7)), half));
+                value = _mm_min_ps(_mm_max_ps(value, zero), maxIndex);
+                _mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(value));
+                for (int i = 0; i < 4; ++i)
+                    write(x + i, indices[i]);
+            }
+        }
+#endif
+        for (; x <= x1; ++x)
+            write(x, kernel.scalarIndex(x));
+    }
+} // namespace
+
+void Dither::renderGradient(Project::Frame& frame,
+                            int canvasWidth,
+                            int x0,
+                            int y0,
+                            int x1,
+                            int y1,
+                            const Selection* mask,
+                            const GradientParams& params,
+                            const PaletteLut& lut)
+{
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    std::vector<uint32_t> ramp;
+    const int levels = buildRamp(params, lut, ramp);
+
+    // 阈值幅度取相邻两级颜色在色带上的平均间距，使抖动恰好在相邻两级之间过渡
+    const int size = matrixSize(params.matrix);
+    const float spread = (size > 0 && levels > 1) ? static_cast<float>(kRampSize - 1) / static_cast<float>(levels) : 0.0f;
+    const int shift = (size == 2) ? 4 : (size == 4) ? 2 : 0;
+    float thresholds[8][12] = {};
+    for (int ty = 0; ty < 8 && size > 0; ++ty)
+    {
+        for (int tx = 0; tx < 12; ++tx)
+        {
+            const int cell = kBayer8[ty % size][(tx & 7) % size] >> shift;
+            const float normalized = (static_cast<float>(cell) + 0.5f) / static_cast<float>(size * size) - 0.5f;
+            thresholds[ty][tx] = normalized * spread;
+        }
+    }
+
+    const float sx = static_cast<float>(params.startX) + 0.5f;
+    const float sy = static_cast<float>(params.startY) + 0.5f;
+    const float dx = static_cast<float>(params.endX - params.startX);
+    const float dy = static_cast<float>(params.endY - params.startY);
+    const float length2 = dx * dx + dy * dy;
+    const float rampScale = static_cast<float>(kRampSize - 1);
+
+    parallelFor(y0, y1 + 1, [&](int y) {
+        RowKernel kernel;
+        kernel.shape = params.shape;
+        kernel.thresholds = thresholds[y & 7];
+        const float py = static_cast<float>(y) + 0.5f - sy;
+        if (params.shape == GradientShape::Linear)
+        {
+            // t = ((px - sx) * dx + py * dy) / |d|^2，起点与终点重合时整片取起点色
+            if (length2 > 0.0f)
+            {
+                kernel.stepX = dx / length2 * rampScale;
+                kernel.base = ((0.5f - sx) * dx + py * dy) / length2 * rampScale;
+            }
+        }
+        else
+        {
+            kernel.centerX = sx;
+            kernel.dy2 = py * py;
+            kernel.radialScale = length2 > 0.0f ? rampScale / std::sqrt(length2) : 0.0f;
+        }
+
+        uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+        renderRow(row, mask ? mask->rowWords(y) : nullptr, x0, x1, kernel, ramp.data());
+    });
+}
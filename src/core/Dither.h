@@ -0,0 +1,73 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstdint>
+
+class PaletteLut;
+class Selection;
+
+/**
+ * @brief 渐变形状
+ */
+enum class GradientShape : int
+{
+    Linear = 0,   // 沿起点 -> 终点方向线性变化
+    Radial,       // 以起点为圆心、到终点的距离为半径
+    Count
+};
+
+/**
+ * @brief 有序抖动的阈值矩阵
+ */
+enum class DitherMatrix : int
+{
+    None = 0,     // 不抖动（纯色带）
+    Bayer2,       // 2x2 Bayer
+    Bayer4,       // 4x4 Bayer
+    Bayer8,       // 8x8 Bayer
+    Count
+};
+
+/**
+ * @brief 渐变参数（画布像素坐标）
+ */
+struct GradientParams
+{
+    int startX = 0;
+    int startY = 0;
+    int endX = 0;
+    int endY = 0;
+    GradientShape shape = GradientShape::Linear;
+    DitherMatrix matrix = DitherMatrix::Bayer4;
+    uint32_t startColor = 0xFF000000;
+    uint32_t endColor = 0xFFFFFFFF;
+};
+
+/**
+ * @brief 量化到调色板的有序抖动渐变
+ *
+ * 颜色不逐像素计算：先把起止色之间的插值按 kRampSize 级离散，每级经 PaletteLut 映射到调色板，
+ * 得到一条“色带查找表”；再统计色带中实际出现的颜色级数，作为抖动幅度。
+ * 逐像素只需：求渐变参数 t（SSE2 一次 4 像素）-> 加上 Bayer 阈值 -> 查色带。
+ * 行之间互不相关，按行并行。
+ */
+class Dither
+{
+public:
+    static constexpr int kRampSize = 1024;
+
+    /**
+     * @brief 在 [x0, x1] x [y0, y1]（闭区间，已裁剪到画布）内绘制渐变
+     * @param mask  非空时只写选区内的像素
+     */
+    static void renderGradient(Project::Frame& frame,
+                               int canvasWidth,
+                               int x0,
+                               int y0,
+                               int x1,
+                               int y1,
+                               const Selection* mask,
+                               const GradientParams& params,
+                               const PaletteLut& lut);
+};
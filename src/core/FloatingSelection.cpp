@@ -0,0 +1,164 @@
+#include "core/FloatingSelection.h"
+
+#include "core/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+void FloatingSelection::begin(std::shared_ptr<const ImageBuffer> image, int x, int y)
+{
+    sources_.assign(1, image);
+    steps_.clear();
+    image_ = std::move(image);
+    firstFrame_ = -1;
+    previewFrame_ = -1;
+    originX_ = x_ = x;
+    originY_ = y_ = y;
+    ++revision_;
+}
+
+void FloatingSelection::beginLifted(std::vector<std::shared_ptr<const ImageBuffer>> sources, int firstFrame, int x, int y)
+{
+    if (sources.empty())
+        return;
+
+    sources_ = std::move(sources);
+    steps_.clear();
+    firstFrame_ = firstFrame;
+    previewFrame_ = firstFrame;
+    image_ = sources_.front();
+    originX_ = x_ = x;
+    originY_ = y_ = y;
+    ++revision_;
+}
+
+void FloatingSelection::clear()
+{
+    sources_.clear();
+    steps_.clear();
+    image_.reset();
+    firstFrame_ = -1;
+    previewFrame_ = -1;
+    ++revision_;
+}
+
+void FloatingSelection::applyTransform(const TransformStep& step)
+{
+    if (!image_)
+        return;
+
+    const int oldW = image_->width;
+    const int oldH = image_->height;
+    steps_.push_back(step);
+    image_ = std::make_shared<const ImageBuffer>(ImageTransform::apply(*image_, step));
+
+    // 旋转后尺寸可能变化，保持中心位置不动
+    x_ += (oldW - image_->width) / 2;
+    y_ += (oldH - image_->height) / 2;
+    ++revision_;
+}
+
+void FloatingSelection::syncPreview(int frameIndex)
+{
+    if (!isLifted() || frameIndex == previewFrame_)
+        return;
+    if (frameIndex < firstFrame_ || frameIndex > getLastFrame())
+        return;
+
+    image_ = buildTransformed(sources_[static_cast<size_t>(frameIndex - firstFrame_)]);
+    previewFrame_ = frameIndex;
+    ++revision_;
+}
+
+bool FloatingSelection::hitTest(int px, int py) const
+{
+    if (!image_)
+        return false;
+    return px >= x_ && py >= y_ && px < x_ + image_->width && py < y_ + image_->height;
+}
+
+bool FloatingSelection::commit(Project& project, int currentFrame)
+{
+    if (!image_)
+        return false;
+
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    bool changed = false;
+    if (!isLifted())
+    {
+        changed = blit(*image_, project.getFrame(currentFrame), width, height, x_, y_);
+    }
+    else
+    {
+        // 各帧互不重叠，按帧并行：变换 + 写回
+        std::atomic<bool> anyChanged(false);
+        const int frameCount = std::min(static_cast<int>(sources_.size()), project.getFrameCount() - firstFrame_);
+        parallelFor(0, frameCount, [&](int i) {
+            const int frameIndex = firstFrame_ + i;
+            const std::shared_ptr<const ImageBuffer> transformed =
+                (frameIndex == previewFrame_) ? image_ : buildTransformed(sources_[static_cast<size_t>(i)]);
+            if (blit(*transformed, project.getFrame(frameIndex), width, height, x_, y_))
+                anyChanged = true;
+        });
+        changed = anyChanged;
+    }
+
+    clear();
+    return changed;
+}
+
+bool FloatingSelection::cancel(Project& project)
+{
+    bool changed = false;
+    if (isLifted())
+    {
+        const int width = project.getWidth();
+        const int height = project.getHeight();
+        const int frameCount = std::min(static_cast<int>(sources_.size()), project.getFrameCount() - firstFrame_);
+        for (int i = 0; i < frameCount; ++i)
+        {
+            if (blit(*sources_[static_cast<size_t>(i)], project.getFrame(firstFrame_ + i), width, height, originX_, originY_))
+                changed = true;
+        }
+    }
+    clear();
+    return changed;
+}
+
+bool FloatingSelection::blit(const ImageBuffer& image, Project::Frame& frame, int canvasWidth, int canvasHeight, int x, int y)
+{
+    // 只遍历图像与画布的重叠区域
+    const int minX = std::max(0, x);
+    const int minY = std::max(0, y);
+    const int maxX = std::min(canvasWidth, x + image.width);
+    const int maxY = std::min(canvasHeight, y + image.height);
+
+    bool changed = false;
+    for (int py = minY; py < maxY; ++py)
+    {
+        const uint32_t* src = image.pixels.data() + static_cast<size_t>(py - y) * static_cast<size_t>(image.width);
+        uint32_t* dst = frame.pixels.data() + static_cast<size_t>(py) * static_cast<size_t>(canvasWidth);
+        for (int px = minX; px < maxX; ++px)
+        {
+            const uint32_t color = src[px - x];
+            if ((color >> 24) == 0 || dst[px] == color)
+                continue;
+            dst[px] = color;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+std::shared_ptr<const ImageBuffer> FloatingSelection::buildTransformed(const std::shared_ptr<const ImageBuffer>& source) const
+{
+    if (steps_.empty())
+        return source;
+
+    ImageBuffer current = ImageTransform::apply(*source, steps_.front());
+    for (size_t i = 1; i < steps_.size(); ++i)
+        current = ImageTransform::apply(current, steps_[i]);
+    return std::make_shared<const ImageBuffer>(std::move(current));
+}
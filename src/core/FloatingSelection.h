@@ -0,0 +1,149 @@
+#pragma once
+
+#include "core/ImageBuffer.h"
+#include "core/ImageTransform.h"
+#include "core/Project.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 浮动选区（粘贴或抬起后尚未落到帧上的图像层）
+ *
+ * 主要职责：
+ * - 引用不可变的源图像（粘贴时与剪贴板共享；抬起时每帧一份）以及它在画布上的位置
+ * - 记录作用在源图像上的变换序列，并缓存“当前帧”变换后的预览图像
+ * - 拖动只修改位置，不改写帧像素；只有 commit 时才写回帧（帧范围内并行）
+ *
+ * 两种来源：
+ * - 粘贴（begin）：只有一份源图像，落地时写入当前帧
+ * - 抬起（beginLifted）：帧范围内每帧一份源图像，落地时各帧分别变换并写回；
+ *   取消时源图像按原位置写回，相当于没有移动过
+ *
+ * 注意：
+ * - revision 只在预览图像内容变化时递增，画布据此决定是否重新上传纹理；
+ *   移动位置不会触发上传
+ */
+class FloatingSelection
+{
+public:
+    // 是否存在浮动图像
+    bool isActive() const
+    {
+        return image_ != nullptr;
+    }
+
+    // 是否为从帧范围抬起的浮动选区
+    bool isLifted() const
+    {
+        return firstFrame_ >= 0;
+    }
+
+    // 以单张图像开始浮动（粘贴），(x, y) 为图像左上角在画布中的像素坐标
+    void begin(std::shared_ptr<const ImageBuffer> image, int x, int y);
+
+    /**
+     * @brief 以帧范围抬起的图像开始浮动
+     * @param sources    帧 firstFrame + i 对应 sources[i]，各图像尺寸相同
+     * @param firstFrame 帧范围起点
+     * @param x/y        抬起位置（图像左上角），取消时写回此处
+     */
+    void beginLifted(std::vector<std::shared_ptr<const ImageBuffer>> sources, int firstFrame, int x, int y);
+
+    // 丢弃浮动图像（不写回帧）
+    void clear();
+
+    // 抬起范围（仅 isLifted 时有效）
+    int getFirstFrame() const
+    {
+        return firstFrame_;
+    }
+    int getLastFrame() const
+    {
+        return firstFrame_ + static_cast<int>(sources_.size()) - 1;
+    }
+
+    // 抬起时的原始区域（仅 isLifted 时有效），取消时写回此处
+    void getLiftedRect(int& x, int& y, int& width, int& height) const
+    {
+        x = originX_;
+        y = originY_;
+        width = sources_.empty() ? 0 : sources_.front()->width;
+        height = sources_.empty() ? 0 : sources_.front()->height;
+    }
+
+    // 当前预览图像（已应用全部变换）
+    const ImageBuffer* getImage() const
+    {
+        return image_.get();
+    }
+    const std::shared_ptr<const ImageBuffer>& getImagePtr() const
+    {
+        return image_;
+    }
+
+    int getX() const
+    {
+        return x_;
+    }
+    int getY() const
+    {
+        return y_;
+    }
+    void setPosition(int x, int y)
+    {
+        x_ = x;
+        y_ = y;
+    }
+
+    // 预览图像内容版本号
+    uint64_t getRevision() const
+    {
+        return revision_;
+    }
+
+    // 追加一次变换：只对缓存的预览图像增量计算，并保持图像中心不动
+    void applyTransform(const TransformStep& step);
+
+    // 抬起的浮动选区在切换帧时重建该帧的预览；帧未变化时无开销
+    void syncPreview(int frameIndex);
+
+    // 画布坐标 (px, py) 是否落在浮动图像范围内
+    bool hitTest(int px, int py) const;
+
+    /**
+     * @brief 写回帧并结束浮动
+     *
+     * 粘贴来源写入 currentFrame；抬起来源在帧范围内并行变换并写回各自的帧。
+     * @return true 表示有帧像素发生了修改
+     */
+    bool commit(Project& project, int currentFrame);
+
+    /**
+     * @brief 取消浮动：抬起来源按原位置写回，粘贴来源直接丢弃
+     * @return true 表示有帧像素发生了修改（写回抬起内容）
+     */
+    bool cancel(Project& project);
+
+    /**
+     * @brief 把图像写入帧：透明像素跳过，超出画布的部分裁掉
+     * @return true 表示帧像素发生了修改
+     */
+    static bool blit(const ImageBuffer& image, Project::Frame& frame, int canvasWidth, int canvasHeight, int x, int y);
+
+private:
+    // 对源图像依次应用全部变换
+    std::shared_ptr<const ImageBuffer> buildTransformed(const std::shared_ptr<const ImageBuffer>& source) const;
+
+    std::vector<std::shared_ptr<const ImageBuffer>> sources_;
+    std::vector<TransformStep> steps_;
+    std::shared_ptr<const ImageBuffer> image_;
+    int firstFrame_ = -1;     // -1 表示粘贴来源
+    int previewFrame_ = -1;   // 预览图像对应的帧（仅抬起来源）
+    int originX_ = 0;
+    int originY_ = 0;
+    int x_ = 0;
+    int y_ = 0;
+    uint64_t revision_ = 0;
+};
@@ -0,0 +1,174 @@
+#include "core/FramePatch.h"
+
+#include "core/AppContext.h"
+#include "core/Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+FramePatchCommand::FramePatchCommand(std::string name, int canvasWidth, int canvasHeight)
+    : name_(std::move(name)),
+      canvasWidth_(canvasWidth),
+      canvasHeight_(canvasHeight),
+      tilesPerRow_((canvasWidth + kTileSize - 1) / kTileSize),
+      tilesPerColumn_((canvasHeight + kTileSize - 1) / kTileSize)
+{
+}
+
+void FramePatchCommand::captureRect(const Project& project, int frameIndex, int x0, int y0, int x1, int y1)
+{
+    if (frameIndex < 0 || frameIndex >= project.getFrameCount())
+        return;
+
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(canvasWidth_ - 1, x1);
+    y1 = std::min(canvasHeight_ - 1, y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    if (frameIndex >= static_cast<int>(frames_.size()))
+        frames_.resize(static_cast<size_t>(frameIndex) + 1);
+    FramePatch& patch = frames_[static_cast<size_t>(frameIndex)];
+    std::vector<uint8_t>& captured = patch.captured;
+    if (captured.empty())
+        captured.assign(static_cast<size_t>(tilesPerRow_) * static_cast<size_t>(tilesPerColumn_), 0);
+
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    for (int ty = y0 / kTileSize; ty <= y1 / kTileSize; ++ty)
+    {
+        for (int tx = x0 / kTileSize; tx <= x1 / kTileSize; ++tx)
+        {
+            uint8_t& flag = captured[static_cast<size_t>(ty) * static_cast<size_t>(tilesPerRow_) + static_cast<size_t>(tx)];
+            if (flag)
+                continue;
+            flag = 1;
+
+            TilePatch tile;
+            tile.frameIndex = frameIndex;
+            tile.tileX = tx;
+            tile.tileY = ty;
+            copyTileOut(frame, tile, tile.before);
+            patch.tiles.push_back(std::move(tile));
+        }
+    }
+}
+
+void FramePatchCommand::captureFrame(const Project& project, int frameIndex)
+{
+    captureRect(project, frameIndex, 0, 0, canvasWidth_ - 1, canvasHeight_ - 1);
+}
+
+void FramePatchCommand::reserveFrames(int frameCount)
+{
+    if (frameCount > static_cast<int>(frames_.size()))
+        frames_.resize(static_cast<size_t>(frameCount));
+}
+
+bool FramePatchCommand::isEmpty() const
+{
+    for (const FramePatch& patch : frames_)
+    {
+        if (!patch.tiles.empty())
+            return false;
+    }
+    return true;
+}
+
+bool FramePatchCommand::finalize(Project& project)
+{
+    // 按帧并行拷出修改后的像素并丢弃没有变化的 tile；markDirty 会推进项目的全局版本号，留到后面串行执行
+    const int frameCount = std::min(static_cast<int>(frames_.size()), project.getFrameCount());
+    frames_.resize(static_cast<size_t>(frameCount));
+    parallelFor(0, frameCount, [&](int frameIndex) {
+        FramePatch& patch = frames_[static_cast<size_t>(frameIndex)];
+        const Project::Frame& frame = project.getFrame(frameIndex);
+        size_t kept = 0;
+        for (TilePatch& tile : patch.tiles)
+        {
+            copyTileOut(frame, tile, tile.after);
+            if (tile.after == tile.before)
+                continue;
+            if (&patch.tiles[kept] != &tile)
+                patch.tiles[kept] = std::move(tile);
+            ++kept;
+        }
+        patch.tiles.resize(kept);
+        std::vector<uint8_t>().swap(patch.captured);
+    });
+
+    bool changed = false;
+    for (const FramePatch& patch : frames_)
+    {
+        for (const TilePatch& tile : patch.tiles)
+            markTileDirty(project, tile);
+        changed = changed || !patch.tiles.empty();
+    }
+    return changed;
+}
+
+void FramePatchCommand::undo(AppContext& context)
+{
+    apply(context, true);
+}
+
+void FramePatchCommand::redo(AppContext& context)
+{
+    apply(context, false);
+}
+
+void FramePatchCommand::apply(AppContext& context, bool useBefore)
+{
+    Project* project = context.getProject();
+    if (!project || project->getWidth() != canvasWidth_ || project->getHeight() != canvasHeight_)
+        return;
+
+    const int frameCount = std::min(static_cast<int>(frames_.size()), project->getFrameCount());
+    for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+    {
+        Project::Frame& frame = project->getFrame(frameIndex);
+        for (const TilePatch& tile : frames_[static_cast<size_t>(frameIndex)].tiles)
+        {
+            copyTileIn(frame, tile, useBefore ? tile.before : tile.after);
+            markTileDirty(*project, tile);
+        }
+    }
+    context.setProjectDirty(true);
+}
+
+void FramePatchCommand::copyTileOut(const Project::Frame& frame, const TilePatch& tile, std::vector<uint32_t>& out) const
+{
+    const int x0 = tile.tileX * kTileSize;
+    const int y0 = tile.tileY * kTileSize;
+    const int w = std::min(kTileSize, canvasWidth_ - x0);
+    const int h = std::min(kTileSize, canvasHeight_ - y0);
+    out.resize(static_cast<size_t>(w) * static_cast<size_t>(h));
+    for (int y = 0; y < h; ++y)
+    {
+        std::memcpy(out.data() + static_cast<size_t>(y) * static_cast<size_t>(w),
+                    frame.pixels.data() + static_cast<size_t>(y0 + y) * static_cast<size_t>(canvasWidth_) + static_cast<size_t>(x0),
+                    static_cast<size_t>(w) * sizeof(uint32_t));
+    }
+}
+
+void FramePatchCommand::copyTileIn(Project::Frame& frame, const TilePatch& tile, const std::vector<uint32_t>& in) const
+{
+    const int x0 = tile.tileX * kTileSize;
+    const int y0 = tile.tileY * kTileSize;
+    const int w = std::min(kTileSize, canvasWidth_ - x0);
+    const int h = std::min(kTileSize, canvasHeight_ - y0);
+    for (int y = 0; y < h; ++y)
+    {
+        std::memcpy(frame.pixels.data() + static_cast<size_t>(y0 + y) * static_cast<size_t>(canvasWidth_) + static_cast<size_t>(x0),
+                    in.data() + static_cast<size_t>(y) * static_cast<size_t>(w),
+                    static_cast<size_t>(w) * sizeof(uint32_t));
+    }
+}
+
+void FramePatchCommand::markTileDirty(Project& project, const TilePatch& tile) const
+{
+    const int x0 = tile.tileX * kTileSize;
+    const int y0 = tile.tileY * kTileSize;
+    project.markDirty(tile.frameIndex, x0, y0, x0 + kTileSize - 1, y0 + kTileSize - 1);
+}
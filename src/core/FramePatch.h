@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/CommandStack.h"
+#include "core/Project.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 按 tile 记录帧像素修改的撤销命令
+ *
+ * 用法：修改像素之前对将要写入的区域调用 capture*（每个 tile 只在第一次时拷贝原像素），
+ * 修改完成后调用 finalize 记录修改后的像素并丢弃没有变化的 tile。
+ * 一次笔画、一次跨帧变换都只产生一条记录；内存只与实际改动的 tile 数量成正比。
+ * tile 按帧分桶保存：reserveFrames 之后，不同帧的 capture* 可以在不同线程并行调用。
+ */
+class FramePatchCommand : public Command
+{
+public:
+    static constexpr int kTileSize = 32;
+
+    FramePatchCommand(std::string name, int canvasWidth, int canvasHeight);
+
+    const std::string& getName() const override
+    {
+        return name_;
+    }
+
+    // 记录 frameIndex 帧中覆盖 [x0, x1] x [y0, y1]（闭区间，自动裁剪）的 tile 的原始像素
+    void captureRect(const Project& project, int frameIndex, int x0, int y0, int x1, int y1);
+
+    // 记录整帧
+    void captureFrame(const Project& project, int frameIndex);
+
+    // 预先为 [0, frameCount) 分配按帧的记录桶；之后对不同帧的 capture* 可并行调用（同一帧仍只能单线程）
+    void reserveFrames(int frameCount);
+
+    /**
+     * @brief 记录修改后的像素，并丢弃前后相同的 tile
+     *
+     * 有变化的 tile 同时标记为脏块（画布纹理据此局部更新）。
+     * @return true 表示存在实际修改（值得入栈）
+     */
+    bool finalize(Project& project);
+
+    bool isEmpty() const;
+
+    void undo(AppContext& context) override;
+    void redo(AppContext& context) override;
+
+private:
+    struct TilePatch
+    {
+        int frameIndex = 0;
+        int tileX = 0;
+        int tileY = 0;
+        std::vector<uint32_t> before;
+        std::vector<uint32_t> after;
+    };
+
+    // 一帧的记录：已记录的 tile 与每个 tile 是否已记录的标记（finalize 后清空）
+    struct FramePatch
+    {
+        std::vector<TilePatch> tiles;
+        std::vector<uint8_t> captured;
+    };
+
+    void copyTileOut(const Project::Frame& frame, const TilePatch& tile, std::vector<uint32_t>& out) const;
+    void copyTileIn(Project::Frame& frame, const TilePatch& tile, const std::vector<uint32_t>& in) const;
+    void markTileDirty(Project& project, const TilePatch& tile) const;
+    void apply(AppContext& context, bool useBefore);
+
+    std::string name_;
+    int canvasWidth_ = 0;
+    int canvasHeight_ = 0;
+    int tilesPerRow_ = 0;
+    int tilesPerColumn_ = 0;
+    std::vector<FramePatch> frames_;   // 按帧索引
+};
@@ -0,0 +1,164 @@
+#include "core/FramePreview.h"
+
+#include "core/Parallel.h"
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // 整张重建时按预览行并行；局部更新只涉及少量预览行，串行更省线程开销
+    constexpr int kParallelRows = 16;
+
+    uint64_t nextRevision()
+    {
+        static std::atomic<uint64_t> counter(0);
+        return ++counter;
+    }
+
+    // 一行 [x0, x1) 的像素按 alpha 预乘后累加到 sums（R, G, B, A）
+    void accumulateRow(const uint32_t* row, int x0, int x1, uint64_t sums[4])
+    {
+        int x = x0;
+#if PA_HAS_SSE2
+        if (x1 - x0 >= 4)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            // 16 位通道乘数：RGB 乘 alpha，A 乘 1
+            const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+            const __m128i alphaOne = _mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0);
+            __m128i acc = _mm_setzero_si128();   // 32 位 R, G, B, A
+            const auto addPair = [&](__m128i pair) {
+                __m128i alpha = _mm_shufflelo_epi16(pair, _MM_SHUFFLE(3, 3, 3, 3));
+                alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+                alpha = _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaOne);
+                // 255 * 255 < 65536，16 位无符号乘积不溢出
+                const __m128i premultiplied = _mm_mullo_epi16(pair, alpha);
+                acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(premultiplied, zero));
+                acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(premultiplied, zero));
+            };
+            for (; x + 4 <= x1; x += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+                addPair(_mm_unpacklo_epi8(v, zero));
+                addPair(_mm_unpackhi_epi8(v, zero));
+            }
+            alignas(16) uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            for (int c = 0; c < 4; ++c)
+                sums[c] += lanes[c];
+        }
+#endif
+        for (; x < x1; ++x)
+        {
+            const uint32_t pixel = row[x];
+            const uint32_t a = pixel >> 24;
+            sums[0] += (pixel & 0xFFu) * a;
+            sums[1] += ((pixel >> 8) & 0xFFu) * a;
+            sums[2] += ((pixel >> 16) & 0xFFu) * a;
+            sums[3] += a;
+        }
+    }
+} // namespace
+
+int FramePreviewCache::chooseFactor(int width, int height, int maxSize)
+{
+    const int longest = std::max(1, std::max(width, height));
+    return std::max(1, (longest + maxSize - 1) / std::max(1, maxSize));
+}
+
+void FramePreviewCache::downsample(const uint32_t* src,
+                                   int srcWidth,
+                                   int srcHeight,
+                                   const Project::DirtyRect& rect,
+                                   FramePreview& preview,
+                                   bool parallel)
+{
+    const int factor = preview.factor;
+    const int bx0 = std::max(0, rect.x / factor);
+    const int by0 = std::max(0, rect.y / factor);
+    const int bx1 = std::min(preview.width, (rect.x + rect.width + factor - 1) / factor);
+    const int by1 = std::min(preview.height, (rect.y + rect.height + factor - 1) / factor);
+    if (bx0 >= bx1 || by0 >= by1)
+        return;
+
+    const auto previewRow = [&](int by) {
+        const int y0 = by * factor;
+        const int y1 = std::min(srcHeight, y0 + factor);
+        uint32_t* out = preview.pixels.data() + static_cast<size_t>(by) * static_cast<size_t>(preview.width);
+        for (int bx = bx0; bx < bx1; ++bx)
+        {
+            const int x0 = bx * factor;
+            const int x1 = std::min(srcWidth, x0 + factor);
+            uint64_t sums[4] = {0, 0, 0, 0};
+            for (int y = y0; y < y1; ++y)
+                accumulateRow(src + static_cast<size_t>(y) * static_cast<size_t>(srcWidth), x0, x1, sums);
+
+            const uint64_t count = static_cast<uint64_t>(x1 - x0) * static_cast<uint64_t>(y1 - y0);
+            const uint64_t alphaSum = sums[3];
+            if (alphaSum == 0)
+            {
+                out[bx] = 0;
+                continue;
+            }
+            uint32_t pixel = static_cast<uint32_t>((alphaSum + count / 2) / count) << 24;
+            for (int c = 0; c < 3; ++c)
+                pixel |= static_cast<uint32_t>((sums[c] + alphaSum / 2) / alphaSum) << (c * 8);
+            out[bx] = pixel;
+        }
+    };
+
+    if (parallel && by1 - by0 >= kParallelRows)
+    {
+        parallelFor(by0, by1, previewRow);
+    }
+    else
+    {
+        for (int by = by0; by < by1; ++by)
+            previewRow(by);
+    }
+}
+
+const FramePreview& FramePreviewCache::update(const Project& project, int frameIndex)
+{
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    if (previews_.find(frame.id) == previews_.end() && previews_.size() >= kMaxEntries)
+    {
+        // 为新帧腾出位置：淘汰最久没用过的预览
+        auto oldest = previews_.begin();
+        for (auto it = previews_.begin(); it != previews_.end(); ++it)
+        {
+            if (it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+        previews_.erase(oldest);
+    }
+    Entry& entry = previews_[frame.id];
+    entry.lastUsed = ++useCounter_;
+    FramePreview& preview = entry.preview;
+    if (preview.pixels.empty())
+    {
+        // 新帧（帧编号在创建或调整尺寸时分配，所以尺寸不会在同一编号下改变）
+        preview.factor = chooseFactor(width, height, maxSize_);
+        preview.width = (width + preview.factor - 1) / preview.factor;
+        preview.height = (height + preview.factor - 1) / preview.factor;
+        preview.pixels.assign(static_cast<size_t>(preview.width) * static_cast<size_t>(preview.height), 0u);
+        downsample(frame.pixels.data(), width, height, Project::DirtyRect{0, 0, width, height}, preview);
+    }
+    else if (entry.generation != frame.generation)
+    {
+        project.collectDirtyRects(frameIndex, entry.generation, dirtyRects_);
+        for (const Project::DirtyRect& rect : dirtyRects_)
+            downsample(frame.pixels.data(), width, height, rect, preview);
+    }
+    else
+    {
+        return preview;
+    }
+    entry.generation = frame.generation;
+    preview.revision = nextRevision();
+    return preview;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 帧的缩小预览图
+ *
+ * 按整数倍数 factor 做盒式缩小：预览的每个像素是原图 factor x factor 块的 alpha 加权平均
+ * （边缘不满的块按实际像素数平均），透明像素的颜色不会渗进邻近像素。
+ */
+struct FramePreview
+{
+    int width = 0;
+    int height = 0;
+    int factor = 1;                  // 原图像素 / 预览像素
+    std::vector<uint32_t> pixels;    // RGBA8888，straight alpha
+    uint64_t revision = 0;           // 内容每次变化都会改变（全局递增，可用来判断是否需要重新上传）
+};
+
+/**
+ * @brief 按帧编号缓存的缩小预览
+ *
+ * 每一帧的预览记录已同步的帧版本号；帧被修改时只按 Project::collectDirtyRects 的脏块
+ * 重新缩小受影响的预览像素，从不在每个 UI 帧整张重算。
+ * 只保留最近用过的 kMaxEntries 帧（在几帧之间来回切换时直接复用），更早的按最近最少使用淘汰；
+ * 已删除的帧不会再被访问，同样由淘汰回收。每次 update 的开销与项目帧数无关。
+ */
+class FramePreviewCache
+{
+public:
+    static constexpr size_t kMaxEntries = 4;
+
+    // maxSize 为预览的最大边长（像素）
+    explicit FramePreviewCache(int maxSize = 256)
+        : maxSize_(maxSize)
+    {
+    }
+
+    // 同步并返回指定帧的预览
+    const FramePreview& update(const Project& project, int frameIndex);
+
+    void clear()
+    {
+        previews_.clear();
+    }
+
+    // 选取缩小倍数，使 max(width, height) / factor 不超过 maxSize
+    static int chooseFactor(int width, int height, int maxSize);
+
+    /**
+     * @brief 把 src 中 rect 覆盖的原图区域重新缩小到 preview
+     *
+     * rect 为原图像素坐标，会向外扩到完整的块。parallel 为 false 时不启动工作线程
+     * （已经在后台线程中调用时使用）。
+     */
+    static void downsample(const uint32_t* src,
+                           int srcWidth,
+                           int srcHeight,
+                           const Project::DirtyRect& rect,
+                           FramePreview& preview,
+                           bool parallel = true);
+
+private:
+    struct Entry
+    {
+        FramePreview preview;
+        uint64_t generation = 0;   // 预览对应的帧版本号
+        uint64_t lastUsed = 0;
+    };
+
+    int maxSize_ = 256;
+    std::unordered_map<uint64_t, Entry> previews_;   // 帧编号 -> 预览
+    uint64_t useCounter_ = 0;
+    std::vector<Project::DirtyRect> dirtyRects_;
+};
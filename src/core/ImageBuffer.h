@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 独立于项目帧的 RGBA8888 图像块
+ *
+ * 剪贴板、浮动选区等使用。以 std::shared_ptr<const ImageBuffer> 传递时视为不可变，
+ * 多处可以零拷贝共享同一份数据；需要修改时先复制一份再改（写时复制）。
+ */
+struct ImageBuffer
+{
+    int width = 0;
+    int height = 0;
+
+    // 长度始终等于 width * height；未选中/透明像素为 0x00000000
+    std::vector<uint32_t> pixels;
+};
@@ -0,0 +1,376 @@
+#include "core/ImageTransform.h"
+
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // 旋转分块边长：32x32x4B = 4KB，读写两块都能留在 L1 中
+    constexpr int kBlockSize = 32;
+
+    ImageBuffer makeImage(int width, int height)
+    {
+        ImageBuffer image;
+        image.width = width;
+        image.height = height;
+        image.pixels.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0x00000000);
+        return image;
+    }
+
+    // 反转一行像素写入 dst（dst 与 src 不重叠）
+    void reverseRow(const uint32_t* src, uint32_t* dst, int width)
+    {
+        int x = 0;
+#if PA_HAS_SSE2
+        // 每次从源行尾部取 4 个像素，组内反序后写到目标行头部
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + width - x - 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+#endif
+        for (; x < width; ++x)
+            dst[x] = src[width - 1 - x];
+    }
+
+    // Scale2x（EPX）规则：中心像素 p 与上/右/左/下邻居 a/b/c/d 决定 2x2 子像素 (qx, qy) 的颜色
+    uint32_t epxPick(uint32_t p, uint32_t a, uint32_t b, uint32_t c, uint32_t d, int qx, int qy)
+    {
+        if (qy == 0)
+        {
+            if (qx == 0)
+                return (c == a && c != d && a != b) ? a : p;
+            return (a == b && a != c && b != d) ? b : p;
+        }
+        if (qx == 0)
+            return (d == c && d != b && c != a) ? c : p;
+        return (b == d && b != a && d != c) ? d : p;
+    }
+
+    uint32_t pixelAt(const ImageBuffer& image, int x, int y)
+    {
+        x = std::clamp(x, 0, image.width - 1);
+        y = std::clamp(y, 0, image.height - 1);
+        return image.pixels[static_cast<size_t>(y) * static_cast<size_t>(image.width) + static_cast<size_t>(x)];
+    }
+
+    // Scale2x 一次放大：每个像素放大为 2x2，沿对角方向的同色边缘保持连续
+    ImageBuffer scale2x(const ImageBuffer& src)
+    {
+        ImageBuffer dst = makeImage(src.width * 2, src.height * 2);
+        for (int y = 0; y < dst.height; ++y)
+        {
+            uint32_t* out = dst.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(dst.width);
+            const int sy = y >> 1;
+            for (int x = 0; x < dst.width; ++x)
+            {
+                const int sx = x >> 1;
+                out[x] = epxPick(pixelAt(src, sx, sy),
+                                 pixelAt(src, sx, sy - 1),
+                                 pixelAt(src, sx + 1, sy),
+                                 pixelAt(src, sx - 1, sy),
+                                 pixelAt(src, sx, sy + 1),
+                                 x & 1,
+                                 y & 1);
+            }
+        }
+        return dst;
+    }
+
+    /**
+     * 8 倍 Scale2x 采样器。
+     *
+     * 只物化第一次放大（2x，内存为源图 4 倍），第二、三次放大在采样时按需计算，
+     * 避免大选区旋转时分配 64 倍内存；每次采样约 25 次查表。
+     */
+    class Scale8xSampler
+    {
+    public:
+        explicit Scale8xSampler(const ImageBuffer& src) : level1_(scale2x(src)) {}
+
+        // (x, y) 为 8 倍空间坐标，调用方保证在范围内
+        uint32_t sample(int x, int y) const
+        {
+            return level3(x, y);
+        }
+
+    private:
+        // 4 倍空间像素，越界时钳制到边缘
+        uint32_t level2(int x, int y) const
+        {
+            x = std::clamp(x, 0, level1_.width * 2 - 1);
+            y = std::clamp(y, 0, level1_.height * 2 - 1);
+            const int px = x >> 1;
+            const int py = y >> 1;
+            return epxPick(pixelAt(level1_, px, py),
+                           pixelAt(level1_, px, py - 1),
+                           pixelAt(level1_, px + 1, py),
+                           pixelAt(level1_, px - 1, py),
+                           pixelAt(level1_, px, py + 1),
+                           x & 1,
+                           y & 1);
+        }
+
+        uint32_t level3(int x, int y) const
+        {
+            const int px = x >> 1;
+            const int py = y >> 1;
+            return epxPick(level2(px, py),
+                           level2(px, py - 1),
+                           level2(px + 1, py),
+                           level2(px - 1, py),
+                           level2(px, py + 1),
+                           x & 1,
+                           y & 1);
+        }
+
+        ImageBuffer level1_;
+    };
+} // namespace
+
+ImageBuffer ImageTransform::flipHorizontal(const ImageBuffer& src)
+{
+    ImageBuffer dst = makeImage(src.width, src.height);
+    for (int y = 0; y < src.height; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * static_cast<size_t>(src.width);
+        reverseRow(src.pixels.data() + row, dst.pixels.data() + row, src.width);
+    }
+    return dst;
+}
+
+ImageBuffer ImageTransform::flipVertical(const ImageBuffer& src)
+{
+    ImageBuffer dst = makeImage(src.width, src.height);
+    const size_t rowBytes = static_cast<size_t>(src.width) * sizeof(uint32_t);
+    for (int y = 0; y < src.height; ++y)
+    {
+        std::memcpy(dst.pixels.data() + static_cast<size_t>(src.height - 1 - y) * static_cast<size_t>(src.width),
+                    src.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(src.width),
+                    rowBytes);
+    }
+    return dst;
+}
+
+ImageBuffer ImageTransform::rotate90(const ImageBuffer& src, bool clockwise)
+{
+    const int w = src.width;
+    const int h = src.height;
+    ImageBuffer dst = makeImage(h, w);
+
+    // 分块转置：顺时针 (x, y) -> (h-1-y, x)，逆时针 (x, y) -> (y, w-1-x)
+    for (int by = 0; by < h; by += kBlockSize)
+    {
+        const int yEnd = std::min(h, by + kBlockSize);
+        for (int bx = 0; bx < w; bx += kBlockSize)
+        {
+            const int xEnd = std::min(w, bx + kBlockSize);
+            for (int y = by; y < yEnd; ++y)
+            {
+                const uint32_t* srcRow = src.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(w);
+                for (int x = bx; x < xEnd; ++x)
+                {
+                    const int dx = clockwise ? (h - 1 - y) : y;
+                    const int dy = clockwise ? x : (w - 1 - x);
+                    dst.pixels[static_cast<size_t>(dy) * static_cast<size_t>(h) + static_cast<size_t>(dx)] = srcRow[x];
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+ImageBuffer ImageTransform::rotate180(const ImageBuffer& src)
+{
+    ImageBuffer dst = makeImage(src.width, src.height);
+    for (int y = 0; y < src.height; ++y)
+    {
+        reverseRow(src.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(src.width),
+                   dst.pixels.data() + static_cast<size_t>(src.height - 1 - y) * static_cast<size_t>(src.width),
+                   src.width);
+    }
+    return dst;
+}
+
+ImageBuffer ImageTransform::rotSprite(const ImageBuffer& src, float degrees)
+{
+    // 角度归一化到 [0, 360)，90 的整数倍走精确内核
+    float normalized = std::fmod(degrees, 360.0f);
+    if (normalized < 0.0f)
+        normalized += 360.0f;
+    const float quarter = normalized / 90.0f;
+    if (std::fabs(quarter - std::round(quarter)) < 1e-4f)
+    {
+        switch (static_cast<int>(std::round(quarter)) % 4)
+        {
+        case 1:
+            return rotate90(src, true);
+        case 2:
+            return rotate180(src);
+        case 3:
+            return rotate90(src, false);
+        default:
+            return src;
+        }
+    }
+
+    if (src.width <= 0 || src.height <= 0)
+        return src;
+
+    // 1) Scale2x x3 得到 8 倍平滑放大图（按需采样）
+    const Scale8xSampler up(src);
+    const float scale = 8.0f;
+    const int upW = src.width * 8;
+    const int upH = src.height * 8;
+
+    // 2) 计算旋转后包围盒
+    const float radians = normalized * 3.14159265358979f / 180.0f;
+    const float c = std::cos(radians);
+    const float s = std::sin(radians);
+    const float w = static_cast<float>(src.width);
+    const float h = static_cast<float>(src.height);
+    const int outW = std::max(1, static_cast<int>(std::ceil(std::fabs(w * c) + std::fabs(h * s) - 1e-3f)));
+    const int outH = std::max(1, static_cast<int>(std::ceil(std::fabs(w * s) + std::fabs(h * c) - 1e-3f)));
+    ImageBuffer dst = makeImage(outW, outH);
+
+    // 3) 每个输出像素中心反向旋转回源坐标，在放大图上取最近采样
+    const float srcCx = w * 0.5f;
+    const float srcCy = h * 0.5f;
+    const float dstCx = static_cast<float>(outW) * 0.5f;
+    const float dstCy = static_cast<float>(outH) * 0.5f;
+    for (int y = 0; y < outH; ++y)
+    {
+        const float py = static_cast<float>(y) + 0.5f - dstCy;
+        uint32_t* outRow = dst.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(outW);
+        for (int x = 0; x < outW; ++x)
+        {
+            const float px = static_cast<float>(x) + 0.5f - dstCx;
+            const float sx = px * c + py * s + srcCx;
+            const float sy = -px * s + py * c + srcCy;
+            if (sx < 0.0f || sy < 0.0f || sx >= w || sy >= h)
+                continue;
+            const int ux = std::min(upW - 1, static_cast<int>(sx * scale));
+            const int uy = std::min(upH - 1, static_cast<int>(sy * scale));
+            outRow[x] = up.sample(ux, uy);
+        }
+    }
+    return dst;
+}
+
+ImageBuffer ImageTransform::apply(const ImageBuffer& src, const TransformStep& step)
+{
+    switch (step.op)
+    {
+    case TransformOp::FlipHorizontal:
+        return flipHorizontal(src);
+    case TransformOp::FlipVertical:
+        return flipVertical(src);
+    case TransformOp::Rotate90CW:
+        return rotate90(src, true);
+    case TransformOp::Rotate90CCW:
+        return rotate90(src, false);
+    case TransformOp::Rotate180:
+        return rotate180(src);
+    case TransformOp::RotateAngle:
+        return rotSprite(src, step.degrees);
+    default:
+        return src;
+    }
+}
+
+void ImageTransform::offsetPixels(std::vector<uint32_t>& pixels,
+                                  int width,
+                                  int height,
+                                  int dx,
+                                  int dy,
+                                  bool wrap,
+                                  std::vector<uint32_t>& scratch)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    if (wrap)
+    {
+        dx %= width;
+        dy %= height;
+    }
+    if (dx == 0 && dy == 0)
+        return;
+
+    scratch.assign(pixels.begin(), pixels.end());
+    const size_t stride = static_cast<size_t>(width);
+    for (int y = 0; y < height; ++y)
+    {
+        uint32_t* dst = pixels.data() + static_cast<size_t>(y) * stride;
+        int sy = y - dy;
+        if (wrap)
+        {
+            sy = (sy % height + height) % height;
+        }
+        else if (sy < 0 || sy >= height)
+        {
+            std::fill(dst, dst + width, 0x00000000u);
+            continue;
+        }
+        const uint32_t* src = scratch.data() + static_cast<size_t>(sy) * stride;
+
+        // 目标 x 取自源 x - dx
+        if (wrap)
+        {
+            const int shift = (dx % width + width) % width;
+            std::memcpy(dst + shift, src, static_cast<size_t>(width - shift) * sizeof(uint32_t));
+            std::memcpy(dst, src + (width - shift), static_cast<size_t>(shift) * sizeof(uint32_t));
+            continue;
+        }
+        if (dx >= width || dx <= -width)
+        {
+            std::fill(dst, dst + width, 0x00000000u);
+            continue;
+        }
+        if (dx >= 0)
+        {
+            std::fill(dst, dst + dx, 0x00000000u);
+            std::memcpy(dst + dx, src, static_cast<size_t>(width - dx) * sizeof(uint32_t));
+        }
+        else
+        {
+            std::memcpy(dst, src - dx, static_cast<size_t>(width + dx) * sizeof(uint32_t));
+            std::fill(dst + width + dx, dst + width, 0x00000000u);
+        }
+    }
+}
+
+void ImageTransform::flipPixels(std::vector<uint32_t>& pixels,
+                                int width,
+                                int height,
+                                bool horizontal,
+                                std::vector<uint32_t>& scratch)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    scratch.resize(static_cast<size_t>(width));
+    const size_t stride = static_cast<size_t>(width);
+    const size_t rowBytes = stride * sizeof(uint32_t);
+    if (horizontal)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            uint32_t* row = pixels.data() + static_cast<size_t>(y) * stride;
+            reverseRow(row, scratch.data(), width);
+            std::memcpy(row, scratch.data(), rowBytes);
+        }
+        return;
+    }
+
+    // 垂直翻转：首尾两行经一行临时缓冲交换
+    for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+    {
+        uint32_t* a = pixels.data() + static_cast<size_t>(top) * stride;
+        uint32_t* b = pixels.data() + static_cast<size_t>(bottom) * stride;
+        std::memcpy(scratch.data(), a, rowBytes);
+        std::memcpy(a, b, rowBytes);
+        std::memcpy(b, scratch.data(), rowBytes);
+    }
+}
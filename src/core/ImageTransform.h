@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/ImageBuffer.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 图像块变换类型（浮动选区变换、跨帧变换共用）
+ */
+enum class TransformOp : int
+{
+    FlipHorizontal = 0,   // 水平翻转
+    FlipVertical,         // 垂直翻转
+    Rotate90CW,           // 顺时针旋转 90 度
+    Rotate90CCW,          // 逆时针旋转 90 度
+    Rotate180,            // 旋转 180 度
+    RotateAngle,          // 任意角度（RotSprite 风格像素画旋转）
+    Count
+};
+
+/**
+ * @brief 一次变换：类型 + 任意角度旋转时使用的角度（度，顺时针为正）
+ */
+struct TransformStep
+{
+    TransformOp op = TransformOp::FlipHorizontal;
+    float degrees = 0.0f;
+};
+
+/**
+ * @brief 图像块变换内核
+ *
+ * - 翻转按行处理（水平翻转每次反转 4 个像素），旋转 90 度按 32x32 分块转置，
+ *   保证读写两侧都落在缓存友好的小块内
+ * - 任意角度旋转采用 RotSprite 思路：先用 Scale2x 连续放大 3 次（8 倍，后两次按需采样），
+ *   再对每个输出像素反向旋转取最近采样，避免最近邻旋转产生的锯齿和断线
+ * - 所有函数都返回新图像，不修改输入；可在多个线程中对不同图像并行调用
+ */
+class ImageTransform
+{
+public:
+    static ImageBuffer flipHorizontal(const ImageBuffer& src);
+    static ImageBuffer flipVertical(const ImageBuffer& src);
+    static ImageBuffer rotate90(const ImageBuffer& src, bool clockwise);
+    static ImageBuffer rotate180(const ImageBuffer& src);
+
+    // 输出尺寸为旋转后图像的包围盒；角度为 90 的整数倍时退化为精确旋转
+    static ImageBuffer rotSprite(const ImageBuffer& src, float degrees);
+
+    // 按 step 分派到上面的具体内核
+    static ImageBuffer apply(const ImageBuffer& src, const TransformStep& step);
+
+    /**
+     * @brief 整幅画布原地平移 (dx, dy)
+     *
+     * 先把整幅拷到 scratch，再逐行用至多两次 memcpy 写回（环绕时行尾部分接到行首），
+     * 读写都是连续内存。wrap 为 false 时移出的像素丢弃、空出的位置清为透明。
+     * scratch 由调用方提供，可在多次调用间复用。
+     */
+    static void offsetPixels(std::vector<uint32_t>& pixels,
+                             int width,
+                             int height,
+                             int dx,
+                             int dy,
+                             bool wrap,
+                             std::vector<uint32_t>& scratch);
+
+    // 整幅画布原地翻转；scratch 只需一行大小
+    static void flipPixels(std::vector<uint32_t>& pixels,
+                           int width,
+                           int height,
+                           bool horizontal,
+                           std::vector<uint32_t>& scratch);
+};
@@ -0,0 +1,158 @@
+#include "core/MipChain.h"
+
+#include "core/Parallel.h"
+
+#include <algorithm>
+
+namespace
+{
+    // 整层重建时按行并行；局部更新的矩形通常很小，串行更省线程开销
+    constexpr int kParallelRows = 64;
+
+    template <typename Fn>
+    void forEachRow(const Project::DirtyRect& rect, Fn&& row)
+    {
+        if (rect.height >= kParallelRows)
+        {
+            parallelFor(rect.y, rect.y + rect.height, row);
+        }
+        else
+        {
+            for (int y = rect.y; y < rect.y + rect.height; ++y)
+                row(y);
+        }
+    }
+
+    // 把帧像素 rect 区域按 alpha 预乘写入第 0 层
+    void premultiply(const uint32_t* src, uint32_t* dst, int width, const Project::DirtyRect& rect)
+    {
+        forEachRow(rect, [&](int y) {
+            const size_t rowOffset = static_cast<size_t>(y) * static_cast<size_t>(width);
+            for (int x = rect.x; x < rect.x + rect.width; ++x)
+            {
+                const uint32_t pixel = src[rowOffset + static_cast<size_t>(x)];
+                const uint32_t a = pixel >> 24;
+                uint32_t out = a << 24;
+                for (int c = 0; c < 3; ++c)
+                    out |= ((((pixel >> (c * 8)) & 0xFFu) * a + 127u) / 255u) << (c * 8);
+                dst[rowOffset + static_cast<size_t>(x)] = out;
+            }
+        });
+    }
+
+    // 把 src 中 2x2 的块（预乘 alpha）逐通道平均写入 dst 的 rect 区域
+    void downsample(const uint32_t* src, int srcWidth, int srcHeight, uint32_t* dst, int dstWidth, const Project::DirtyRect& rect)
+    {
+        forEachRow(rect, [&](int y) {
+            const int sy0 = std::min(y * 2, srcHeight - 1);
+            const int sy1 = std::min(y * 2 + 1, srcHeight - 1);
+            const uint32_t* top = src + static_cast<size_t>(sy0) * static_cast<size_t>(srcWidth);
+            const uint32_t* bottom = src + static_cast<size_t>(sy1) * static_cast<size_t>(srcWidth);
+            uint32_t* out = dst + static_cast<size_t>(y) * static_cast<size_t>(dstWidth);
+            for (int x = rect.x; x < rect.x + rect.width; ++x)
+            {
+                const int sx0 = std::min(x * 2, srcWidth - 1);
+                const int sx1 = std::min(x * 2 + 1, srcWidth - 1);
+                const uint32_t samples[4] = {top[sx0], top[sx1], bottom[sx0], bottom[sx1]};
+                uint32_t pixel = 0;
+                for (int c = 0; c < 4; ++c)
+                {
+                    uint32_t sum = 0;
+                    for (uint32_t sample : samples)
+                        sum += (sample >> (c * 8)) & 0xFFu;
+                    pixel |= ((sum + 2u) / 4u) << (c * 8);
+                }
+                out[x] = pixel;
+            }
+        });
+    }
+
+    // 上一层的矩形在下一层覆盖的范围（奇数边界向外取整）
+    Project::DirtyRect halve(const Project::DirtyRect& rect, int width, int height)
+    {
+        const int x0 = rect.x / 2;
+        const int y0 = rect.y / 2;
+        const int x1 = std::min(width, (rect.x + rect.width + 1) / 2);
+        const int y1 = std::min(height, (rect.y + rect.height + 1) / 2);
+        return Project::DirtyRect{x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+    }
+} // namespace
+
+void MipChain::clear()
+{
+    frameId_ = 0;
+    generation_ = 0;
+    width_ = 0;
+    height_ = 0;
+    rebuilt_ = false;
+    levels_.clear();
+    changed_.clear();
+}
+
+size_t MipChain::getByteSize() const
+{
+    size_t bytes = 0;
+    for (const Level& level : levels_)
+        bytes += level.pixels.size() * sizeof(uint32_t);
+    return bytes;
+}
+
+bool MipChain::update(const Project& project, int frameIndex)
+{
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    rebuilt_ = false;
+    for (std::vector<Project::DirtyRect>& rects : changed_)
+        rects.clear();
+
+    if (frame.id == frameId_ && width == width_ && height == height_)
+    {
+        if (frame.generation == generation_)
+            return false;
+        project.collectDirtyRects(frameIndex, generation_, changed_[0]);
+    }
+    else
+    {
+        // 换帧或尺寸变化：按新尺寸建立层级并整链重建
+        frameId_ = frame.id;
+        width_ = width;
+        height_ = height;
+        levels_.clear();
+        int levelWidth = width;
+        int levelHeight = height;
+        while (true)
+        {
+            Level level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.pixels.resize(static_cast<size_t>(levelWidth) * static_cast<size_t>(levelHeight));
+            levels_.push_back(std::move(level));
+            if (static_cast<int>(levels_.size()) >= kMaxLevels || (levelWidth == 1 && levelHeight == 1))
+                break;
+            levelWidth = std::max(1, levelWidth / 2);
+            levelHeight = std::max(1, levelHeight / 2);
+        }
+        changed_.assign(levels_.size(), std::vector<Project::DirtyRect>());
+        changed_[0].push_back(Project::DirtyRect{0, 0, width, height});
+        rebuilt_ = true;
+    }
+    generation_ = frame.generation;
+
+    for (const Project::DirtyRect& rect : changed_[0])
+        premultiply(frame.pixels.data(), levels_[0].pixels.data(), width, rect);
+    for (size_t i = 1; i < levels_.size(); ++i)
+    {
+        Level& level = levels_[i];
+        const Level& source = levels_[i - 1];
+        for (const Project::DirtyRect& rect : changed_[i - 1])
+        {
+            const Project::DirtyRect target = halve(rect, level.width, level.height);
+            if (target.width <= 0 || target.height <= 0)
+                continue;
+            downsample(source.pixels.data(), source.width, source.height, level.pixels.data(), level.width, target);
+            changed_[i].push_back(target);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 一帧的缩小链（mipmap），用于缩放小于 1 倍时的显示
+ *
+ * 第 L 层尺寸为 max(1, floor(size / 2^L))，与 OpenGL 的层级尺寸一致；第 0 层是帧的拷贝。
+ * 所有层（含第 0 层）都按预乘 alpha 存储：2x2 盒式平均在预乘空间里就是按 alpha 加权，
+ * 显示端的双线性/三线性插值也在预乘空间进行，透明像素（预乘后 RGB 为 0）的颜色
+ * 不会渗进精灵边缘，半透明边缘也不会发灰。显示端须按预乘 alpha 合成。
+ *
+ * update 记住上次同步的 (帧编号, 版本号)：同一帧只按 Project::collectDirtyRects 的脏区域
+ * 逐层向下重算，换帧或尺寸变化时整链重建。每层变化的矩形可以通过 getChangedRects 取得，
+ * 供显示端只上传变化部分。
+ */
+class MipChain
+{
+public:
+    static constexpr int kMaxLevels = 6;   // 含第 0 层；最小缩放 1/32 时用到第 5 层
+
+    struct Level
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+    };
+
+    /**
+     * @brief 同步到指定帧的当前内容
+     * @return true 表示有层级内容发生了变化
+     */
+    bool update(const Project& project, int frameIndex);
+
+    // 层数（含第 0 层）
+    int getLevelCount() const
+    {
+        return static_cast<int>(levels_.size());
+    }
+
+    const Level& getLevel(int level) const
+    {
+        return levels_[static_cast<size_t>(level)];
+    }
+
+    // 各层像素总字节数
+    size_t getByteSize() const;
+
+    // 最近一次 update 中各层变化的矩形（下标为层号）；wasRebuilt() 时为整层
+    const std::vector<Project::DirtyRect>& getChangedRects(int level) const
+    {
+        return changed_[static_cast<size_t>(level)];
+    }
+
+    // 最近一次 update 是否整链重建
+    bool wasRebuilt() const
+    {
+        return rebuilt_;
+    }
+
+    void clear();
+
+private:
+    uint64_t frameId_ = 0;
+    uint64_t generation_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    bool rebuilt_ = false;
+    std::vector<Level> levels_;
+    std::vector<std::vector<Project::DirtyRect>> changed_;
+};
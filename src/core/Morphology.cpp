@@ -0,0 +1,319 @@
+#include "core/Morphology.h"
+
+#include "core/Selection.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+    // 行内最后一个字的有效位（超出画布宽度的位必须保持为 0）
+    uint64_t tailMask(int width)
+    {
+        const int bits = width & 63;
+        return bits == 0 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    }
+
+    int countTrailingZeros(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        int count = 0;
+        while ((value & 1u) == 0)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // 枚举一行掩码中置位的像素，只访问非零字
+    template <typename Fn>
+    void forEachBit(const uint64_t* words, int wordCount, Fn&& fn)
+    {
+        for (int i = 0; i < wordCount; ++i)
+        {
+            uint64_t word = words[i];
+            while (word != 0)
+            {
+                fn(i * 64 + countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief 一行的水平膨胀/腐蚀：与左右相邻像素做或/与
+     *
+     * 像素 x 位于第 x / 64 个字的第 x % 64 位，左邻来自左移一位（跨字借上一字的最高位），
+     * 右邻来自右移一位（跨字借下一字的最低位）；画布外的位为 0。
+     */
+    void horizontalRow(const uint64_t* in, uint64_t* out, int wordCount, bool dilate, uint64_t tail)
+    {
+        for (int i = 0; i < wordCount; ++i)
+        {
+            const uint64_t word = in[i];
+            const uint64_t prev = i > 0 ? in[i - 1] : 0;
+            const uint64_t next = i + 1 < wordCount ? in[i + 1] : 0;
+            const uint64_t left = (word << 1) | (prev >> 63);
+            const uint64_t right = (word >> 1) | (next << 63);
+            out[i] = dilate ? (word | left | right) : (word & left & right);
+        }
+        if (wordCount > 0)
+            out[wordCount - 1] &= tail;
+    }
+
+    void morph(const Selection& in, bool eightConnected, bool dilate, Selection& out)
+    {
+        const int width = in.getWidth();
+        const int height = in.getHeight();
+        const int wordCount = in.getWordsPerRow();
+        const uint64_t tail = tailMask(width);
+
+        Selection horizontal(width, height);
+        for (int y = 0; y < height; ++y)
+            horizontalRow(in.rowWords(y), horizontal.rowWords(y), wordCount, dilate, tail);
+
+        // 8 邻接：上下两行也取水平结果（含对角）；4 邻接：上下两行取原始掩码
+        const Selection& vertical = eightConnected ? horizontal : in;
+        out.resize(width, height);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint64_t* center = horizontal.rowWords(y);
+            const uint64_t* above = y > 0 ? vertical.rowWords(y - 1) : nullptr;
+            const uint64_t* below = y + 1 < height ? vertical.rowWords(y + 1) : nullptr;
+            uint64_t* dst = out.rowWords(y);
+            for (int i = 0; i < wordCount; ++i)
+            {
+                const uint64_t a = above ? above[i] : 0;
+                const uint64_t b = below ? below[i] : 0;
+                dst[i] = dilate ? (center[i] | a | b) : (center[i] & a & b);
+            }
+        }
+    }
+
+    // 把 mask 中置位（且在 limit 内）的像素写为 color
+    bool fillMask(Project::Frame& frame, int canvasWidth, const Selection& mask, const Selection* limit, uint32_t color)
+    {
+        bool changed = false;
+        const int wordCount = mask.getWordsPerRow();
+        for (int y = 0; y < mask.getHeight(); ++y)
+        {
+            const uint64_t* limitWords = limit ? limit->rowWords(y) : nullptr;
+            uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+            forEachBit(mask.rowWords(y), wordCount, [&](int x) {
+                if (limitWords && !((limitWords[x >> 6] >> (x & 63)) & 1u))
+                    return;
+                if (row[x] != color)
+                {
+                    row[x] = color;
+                    changed = true;
+                }
+            });
+        }
+        return changed;
+    }
+
+    // out = a & ~b（逐字）
+    void subtract(const Selection& a, const Selection& b, Selection& out)
+    {
+        out.resize(a.getWidth(), a.getHeight());
+        const int wordCount = a.getWordsPerRow();
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            const uint64_t* wa = a.rowWords(y);
+            const uint64_t* wb = b.rowWords(y);
+            uint64_t* dst = out.rowWords(y);
+            for (int i = 0; i < wordCount; ++i)
+                dst[i] = wa[i] & ~wb[i];
+        }
+    }
+
+    // 扩张：每圈新像素取相邻（上一圈内）像素的颜色
+    bool dilateColors(Project::Frame& frame,
+                      int canvasWidth,
+                      int canvasHeight,
+                      Selection current,
+                      const Selection* limit,
+                      const MorphologyParams& params)
+    {
+        static const int kOffsets[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+        const int neighborCount = params.eightConnected ? 8 : 4;
+
+        bool changed = false;
+        Selection grown;
+        Selection ring;
+        for (int pass = 0; pass < params.thickness; ++pass)
+        {
+            Morphology::dilate(current, params.eightConnected, grown);
+            subtract(grown, current, ring);
+
+            const int wordCount = ring.getWordsPerRow();
+            for (int y = 0; y < canvasHeight; ++y)
+            {
+                const uint64_t* limitWords = limit ? limit->rowWords(y) : nullptr;
+                uint64_t* ringWords = ring.rowWords(y);
+                uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+                forEachBit(ringWords, wordCount, [&](int x) {
+                    if (limitWords && !((limitWords[x >> 6] >> (x & 63)) & 1u))
+                    {
+                        ringWords[x >> 6] &= ~(uint64_t(1) << (x & 63));
+                        return;
+                    }
+                    for (int n = 0; n < neighborCount; ++n)
+                    {
+                        const int nx = x + kOffsets[n][0];
+                        const int ny = y + kOffsets[n][1];
+                        if (!current.contains(nx, ny))
+                            continue;
+                        row[x] = frame.pixels[static_cast<size_t>(ny) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(nx)];
+                        changed = true;
+                        break;
+                    }
+                });
+            }
+
+            // 下一圈只从实际写入的像素继续长
+            for (int y = 0; y < canvasHeight; ++y)
+            {
+                uint64_t* dst = current.rowWords(y);
+                const uint64_t* add = ring.rowWords(y);
+                for (int i = 0; i < wordCount; ++i)
+                    dst[i] |= add[i];
+            }
+        }
+        return changed;
+    }
+} // namespace
+
+void Morphology::buildAlphaMask(const Project::Frame& frame, int canvasWidth, int canvasHeight, Selection& out)
+{
+    out.resize(canvasWidth, canvasHeight);
+    for (int y = 0; y < canvasHeight; ++y)
+    {
+        const uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+        uint64_t* words = out.rowWords(y);
+        for (int x0 = 0; x0 < canvasWidth; x0 += 64)
+        {
+            const int x1 = std::min(canvasWidth, x0 + 64);
+            uint64_t word = 0;
+            for (int x = x0; x < x1; ++x)
+                word |= static_cast<uint64_t>((row[x] >> 24) != 0) << (x - x0);
+            words[x0 >> 6] = word;
+        }
+    }
+}
+
+void Morphology::dilate(const Selection& in, bool eightConnected, Selection& out)
+{
+    morph(in, eightConnected, true, out);
+}
+
+void Morphology::erode(const Selection& in, bool eightConnected, Selection& out)
+{
+    morph(in, eightConnected, false, out);
+}
+
+void Morphology::shift(const Selection& in, int dx, int dy, Selection& out)
+{
+    const int width = in.getWidth();
+    const int height = in.getHeight();
+    const int wordCount = in.getWordsPerRow();
+    const uint64_t tail = tailMask(width);
+    out.resize(width, height);
+
+    const int wordShift = std::abs(dx) / 64;
+    const int bitShift = std::abs(dx) % 64;
+    const auto word = [&](const uint64_t* row, int i) { return (i >= 0 && i < wordCount) ? row[i] : uint64_t(0); };
+    for (int y = 0; y < height; ++y)
+    {
+        const int sy = y - dy;
+        if (sy < 0 || sy >= height)
+            continue;
+        const uint64_t* src = in.rowWords(sy);
+        uint64_t* dst = out.rowWords(y);
+        for (int i = 0; i < wordCount; ++i)
+        {
+            // dx > 0：像素 x 取自 x - dx（整体左移位）；dx < 0 反之
+            if (dx >= 0)
+            {
+                dst[i] = word(src, i - wordShift) << bitShift;
+                if (bitShift != 0)
+                    dst[i] |= word(src, i - wordShift - 1) >> (64 - bitShift);
+            }
+            else
+            {
+                dst[i] = word(src, i + wordShift) >> bitShift;
+                if (bitShift != 0)
+                    dst[i] |= word(src, i + wordShift + 1) << (64 - bitShift);
+            }
+        }
+        if (wordCount > 0)
+            dst[wordCount - 1] &= tail;
+    }
+}
+
+bool Morphology::apply(Project::Frame& frame,
+                       int canvasWidth,
+                       int canvasHeight,
+                       const Selection* limit,
+                       const MorphologyParams& params)
+{
+    Selection alpha;
+    buildAlphaMask(frame, canvasWidth, canvasHeight, alpha);
+    const int thickness = std::clamp(params.thickness, 1, kMaxThickness);
+
+    Selection result;
+    Selection scratch;
+    switch (params.op)
+    {
+    case MorphologyOp::Outline:
+    {
+        // 外描边 = 膨胀 t 圈 - 原区域；内描边 = 原区域 - 腐蚀 t 圈
+        result = alpha;
+        for (int pass = 0; pass < thickness; ++pass)
+        {
+            if (params.inside)
+                erode(result, params.eightConnected, scratch);
+            else
+                dilate(result, params.eightConnected, scratch);
+            std::swap(result, scratch);
+        }
+        if (params.inside)
+            subtract(alpha, result, scratch);
+        else
+            subtract(result, alpha, scratch);
+        return fillMask(frame, canvasWidth, scratch, limit, params.color);
+    }
+    case MorphologyOp::Dilate:
+    {
+        MorphologyParams clamped = params;
+        clamped.thickness = thickness;
+        return dilateColors(frame, canvasWidth, canvasHeight, std::move(alpha), limit, clamped);
+    }
+    case MorphologyOp::Erode:
+    {
+        result = alpha;
+        for (int pass = 0; pass < thickness; ++pass)
+        {
+            erode(result, params.eightConnected, scratch);
+            std::swap(result, scratch);
+        }
+        subtract(alpha, result, scratch);
+        return fillMask(frame, canvasWidth, scratch, limit, 0x00000000);
+    }
+    case MorphologyOp::DropShadow:
+    {
+        const int dx = std::clamp(params.offsetX, -kMaxShadowOffset, kMaxShadowOffset);
+        const int dy = std::clamp(params.offsetY, -kMaxShadowOffset, kMaxShadowOffset);
+        shift(alpha, dx, dy, result);
+        subtract(result, alpha, scratch);
+        return fillMask(frame, canvasWidth, scratch, limit, params.color);
+    }
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstdint>
+
+class Selection;
+
+/**
+ * @brief 形态学滤镜类型
+ */
+enum class MorphologyOp : int
+{
+    Outline = 0,   // 描边：沿不透明区域的外侧/内侧画一圈颜色
+    Dilate,        // 扩张：不透明区域向外长一圈，新像素取相邻像素的颜色
+    Erode,         // 腐蚀：不透明区域的边缘一圈清为透明
+    DropShadow,    // 投影：不透明区域平移后落在透明处的部分填充阴影色
+    Count
+};
+
+/**
+ * @brief 形态学滤镜参数
+ */
+struct MorphologyParams
+{
+    MorphologyOp op = MorphologyOp::Outline;
+    bool eightConnected = false;   // 邻接方式：false 为 4 邻接（十字），true 为 8 邻接（含对角）
+    bool inside = false;           // 仅 Outline：true 画在区域内侧
+    int thickness = 1;             // Outline/Dilate/Erode 的圈数
+    uint32_t color = 0xFF000000;   // Outline/DropShadow 的颜色
+    int offsetX = 1;               // 仅 DropShadow：阴影偏移
+    int offsetY = 1;
+};
+
+/**
+ * @brief 基于位掩码的形态学滤镜
+ *
+ * 不透明像素先打包为每行若干 64 位字的掩码（复用 Selection 的存储），
+ * 膨胀/腐蚀用整字移位 + 按位或/与完成：一次处理 64 个像素，不做逐像素邻域检查。
+ * 只有最终需要写入的像素（描边环、扩张出的新像素等）才按位枚举回写到帧。
+ */
+class Morphology
+{
+public:
+    static constexpr int kMaxThickness = 16;
+    static constexpr int kMaxShadowOffset = 64;
+
+    // alpha 不为 0 的像素置位
+    static void buildAlphaMask(const Project::Frame& frame, int canvasWidth, int canvasHeight, Selection& out);
+
+    // 膨胀/腐蚀一圈；画布外按透明处理
+    static void dilate(const Selection& in, bool eightConnected, Selection& out);
+    static void erode(const Selection& in, bool eightConnected, Selection& out);
+
+    // 平移 (dx, dy)，移出画布的部分丢弃
+    static void shift(const Selection& in, int dx, int dy, Selection& out);
+
+    /**
+     * @brief 对一帧执行滤镜
+     * @param limit 非空时只修改其中置位的像素（例如当前选区）
+     * @return true 表示帧像素发生了修改
+     */
+    static bool apply(Project::Frame& frame,
+                      int canvasWidth,
+                      int canvasHeight,
+                      const Selection* limit,
+                      const MorphologyParams& params);
+};
@@ -0,0 +1,129 @@
+#include "core/Noise.h"
+
+#include "core/Parallel.h"
+#include "core/Selection.h"
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    uint64_t splitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // 每批生成的随机数个数（每个像素消耗 2 个：是否命中 + 颜色下标）
+    constexpr int kBatch = 256;
+} // namespace
+
+void NoiseRng::reseed(uint64_t seed)
+{
+    uint64_t state = seed;
+    for (int i = 0; i < kLanes; ++i)
+    {
+        // xorshift 的状态不能为 0
+        uint32_t lane = static_cast<uint32_t>(splitMix64(state) >> 32);
+        state_[i] = lane != 0 ? lane : 0x6D2B79F5u;
+    }
+}
+
+void NoiseRng::generate(uint32_t* out, int count)
+{
+    int i = 0;
+#if PA_HAS_SSE2
+    __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(state_));
+    for (; i < count; i += kLanes)
+    {
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+        if (i + kLanes <= count)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+        }
+        else
+        {
+            alignas(16) uint32_t tail[kLanes];
+            _mm_store_si128(reinterpret_cast<__m128i*>(tail), x);
+            std::copy(tail, tail + (count - i), out + i);
+        }
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(state_), x);
+#else
+    for (; i < count; i += kLanes)
+    {
+        for (int lane = 0; lane < kLanes; ++lane)
+        {
+            uint32_t x = state_[lane];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state_[lane] = x;
+            if (i + lane < count)
+                out[i + lane] = x;
+        }
+    }
+#endif
+}
+
+uint64_t Noise::mixSeed(uint64_t seed, uint64_t salt)
+{
+    uint64_t state = seed ^ (salt * 0xD1B54A32D192ED03ull);
+    return splitMix64(state);
+}
+
+bool Noise::scatter(Project::Frame& frame,
+                    int canvasWidth,
+                    int x0,
+                    int y0,
+                    int x1,
+                    int y1,
+                    const Selection* mask,
+                    const std::vector<uint32_t>& colors,
+                    int density,
+                    uint64_t seed)
+{
+    if (x0 > x1 || y0 > y1 || colors.empty() || density <= 0)
+        return false;
+
+    // 命中阈值：r < threshold 的概率为 density%（100% 时恒成立）
+    const uint64_t threshold = (uint64_t(std::min(density, kMaxDensity)) << 32) / kMaxDensity;
+    const uint64_t colorCount = colors.size();
+
+    std::atomic<bool> changed(false);
+    parallelFor(y0, y1 + 1, [&](int y) {
+        NoiseRng rng(mixSeed(seed, static_cast<uint64_t>(y)));
+        uint32_t random[kBatch];
+        uint32_t* row = frame.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(canvasWidth);
+        const uint64_t* maskWords = mask ? mask->rowWords(y) : nullptr;
+        bool rowChanged = false;
+        for (int start = x0; start <= x1; start += kBatch / 2)
+        {
+            const int end = std::min(x1, start + kBatch / 2 - 1);
+            rng.generate(random, (end - start + 1) * 2);
+            for (int x = start; x <= end; ++x)
+            {
+                const uint32_t* r = random + (x - start) * 2;
+                if (r[0] >= threshold)
+                    continue;
+                if (maskWords && !((maskWords[x >> 6] >> (x & 63)) & 1u))
+                    continue;
+                // 乘法取高位把 32 位随机数映射到 [0, colorCount)
+                const uint32_t color = colors[static_cast<size_t>((uint64_t(r[1]) * colorCount) >> 32)];
+                if (row[x] != color)
+                {
+                    row[x] = color;
+                    rowChanged = true;
+                }
+            }
+        }
+        if (rowChanged)
+            changed = true;
+    });
+    return changed;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstdint>
+#include <vector>
+
+class Selection;
+
+/**
+ * @brief 喷枪/噪点使用的颜色来源
+ */
+enum class NoiseColors : int
+{
+    Foreground = 0,   // 仅前景色
+    TwoColors,        // 前景色与背景色随机
+    ShadeRamp,        // 明暗色带中的颜色随机（色带为空时退回前景色）
+    Count
+};
+
+/**
+ * @brief 批量生成随机数的 4 路 xorshift32
+ *
+ * 4 个通道各自独立迭代，SSE2 下一条指令序列同时推进 4 路；标量路径按相同顺序输出，
+ * 两条路径对同一种子给出完全相同的序列，保证“同一种子 + 同一输入 = 同一结果”。
+ */
+class NoiseRng
+{
+public:
+    static constexpr int kLanes = 4;
+
+    explicit NoiseRng(uint64_t seed = 0)
+    {
+        reseed(seed);
+    }
+
+    void reseed(uint64_t seed);
+
+    // 生成 count 个随机数；内部按 kLanes 个一组推进，不足一组的尾部多出的值直接丢弃
+    void generate(uint32_t* out, int count);
+
+private:
+    alignas(16) uint32_t state_[kLanes] = {};
+};
+
+/**
+ * @brief 按密度散布颜色
+ */
+class Noise
+{
+public:
+    static constexpr int kMaxDensity = 100;
+    static constexpr int kMaxSprayRadius = 32;
+
+    // 由一个种子派生出互不相关的子种子（按行、按帧、按笔画等）
+    static uint64_t mixSeed(uint64_t seed, uint64_t salt);
+
+    /**
+     * @brief 在 [x0, x1] x [y0, y1] 内按 density% 的概率把像素替换为 colors 中的随机颜色
+     *
+     * 每行用 (seed, y) 派生的子种子独立生成，行间并行处理，结果与线程调度无关。
+     * @param mask 非空时只修改其中置位的像素
+     * @return true 表示帧像素发生了修改
+     */
+    static bool scatter(Project::Frame& frame,
+                        int canvasWidth,
+                        int x0,
+                        int y0,
+                        int x1,
+                        int y1,
+                        const Selection* mask,
+                        const std::vector<uint32_t>& colors,
+                        int density,
+                        uint64_t seed);
+};
@@ -0,0 +1,169 @@
+#include "core/OnionSkin.h"
+
+#include "core/Parallel.h"
+
+#include <algorithm>
+
+namespace
+{
+    uint32_t channel(uint32_t rgba, int shift)
+    {
+        return (rgba >> shift) & 0xFFu;
+    }
+
+    // 着色：RGB 向色调靠拢 kTintStrength%，alpha 乘以不透明度
+    uint32_t tintPixel(uint32_t rgba, uint32_t tint, int opacity)
+    {
+        const uint32_t alpha = channel(rgba, 24) * static_cast<uint32_t>(opacity) / 100u;
+        if (alpha == 0)
+            return 0;
+        const uint32_t strength = OnionSkin::kTintStrength;
+        uint32_t out = alpha << 24;
+        for (int shift = 0; shift < 24; shift += 8)
+        {
+            const uint32_t src = channel(rgba, shift);
+            const uint32_t dst = channel(tint, shift);
+            out |= ((src * (100u - strength) + dst * strength + 50u) / 100u) << shift;
+        }
+        return out;
+    }
+
+    // straight alpha 的 src over dst
+    uint32_t over(uint32_t src, uint32_t dst)
+    {
+        const uint32_t sa = channel(src, 24);
+        if (sa == 255 || dst == 0)
+            return src;
+        if (sa == 0)
+            return dst;
+        const uint32_t da = channel(dst, 24);
+        const uint32_t dstWeight = da * (255u - sa);              // 已乘 255
+        const uint32_t outA255 = sa * 255u + dstWeight;            // outA * 255
+        uint32_t out = ((outA255 + 127u) / 255u) << 24;
+        for (int shift = 0; shift < 24; shift += 8)
+        {
+            const uint32_t value = channel(src, shift) * sa * 255u + channel(dst, shift) * dstWeight;
+            out |= ((value + outA255 / 2u) / outA255) << shift;
+        }
+        return out;
+    }
+} // namespace
+
+OnionSkinSettings::OnionSkinSettings()
+{
+    // 之前的帧偏红、之后的帧偏蓝，越远越淡
+    const int opacities[kMaxFrames] = {50, 30, 20, 10};
+    for (int i = 0; i < kMaxFrames; ++i)
+    {
+        previousLayers[i].tint = 0xFF4040FF;
+        previousLayers[i].opacity = opacities[i];
+        nextLayers[i].tint = 0xFFFF8040;
+        nextLayers[i].opacity = opacities[i];
+    }
+}
+
+void OnionSkin::collectNeighbors(int frameCount,
+                                 int currentFrame,
+                                 const OnionSkinSettings& settings,
+                                 std::vector<OnionSkinNeighbor>& out)
+{
+    out.clear();
+    const int previous = std::clamp(settings.previous, 0, OnionSkinSettings::kMaxFrames);
+    const int next = std::clamp(settings.next, 0, OnionSkinSettings::kMaxFrames);
+    for (int distance = std::max(previous, next); distance >= 1; --distance)
+    {
+        if (distance <= previous && currentFrame - distance >= 0)
+            out.push_back({currentFrame - distance, settings.previousLayers[distance - 1]});
+        if (distance <= next && currentFrame + distance < frameCount)
+            out.push_back({currentFrame + distance, settings.nextLayers[distance - 1]});
+    }
+}
+
+void OnionSkinCache::clear()
+{
+    tinted_.clear();
+    compositeKeys_.clear();
+    composite_.clear();
+    width_ = 0;
+    height_ = 0;
+}
+
+bool OnionSkinCache::update(const Project& project, int currentFrame, const OnionSkinSettings& settings)
+{
+    if (project.getWidth() != width_ || project.getHeight() != height_)
+    {
+        clear();
+        width_ = project.getWidth();
+        height_ = project.getHeight();
+    }
+
+    OnionSkin::collectNeighbors(project.getFrameCount(), currentFrame, settings, neighbors_);
+    std::vector<CompositeKey> keys;
+    keys.reserve(neighbors_.size());
+    for (const OnionSkinNeighbor& neighbor : neighbors_)
+    {
+        const Project::Frame& frame = project.getFrame(neighbor.frameIndex);
+        keys.push_back({frame.id, frame.generation, neighbor.layer.tint, neighbor.layer.opacity});
+    }
+    if (keys == compositeKeys_)
+        return false;
+    compositeKeys_ = std::move(keys);
+
+    if (neighbors_.empty())
+    {
+        composite_.clear();
+        tinted_.clear();
+        return true;
+    }
+
+    for (auto& entry : tinted_)
+        entry.second.used = false;
+    std::vector<const TintedFrame*> layers;
+    layers.reserve(neighbors_.size());
+    for (const OnionSkinNeighbor& neighbor : neighbors_)
+        layers.push_back(&tintedFrame(project.getFrame(neighbor.frameIndex), neighbor.layer));
+
+    // 由远到近叠加
+    composite_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), 0u);
+    parallelFor(0, height_, [&](int y) {
+        const size_t rowStart = static_cast<size_t>(y) * static_cast<size_t>(width_);
+        uint32_t* dst = composite_.data() + rowStart;
+        for (const TintedFrame* layer : layers)
+        {
+            const uint32_t* src = layer->pixels.data() + rowStart;
+            for (int x = 0; x < width_; ++x)
+                dst[x] = over(src[x], dst[x]);
+        }
+    });
+
+    // 不再在范围内的邻帧着色结果随之丢弃，缓存大小不超过显示的层数
+    for (auto it = tinted_.begin(); it != tinted_.end();)
+    {
+        if (it->second.used)
+            ++it;
+        else
+            it = tinted_.erase(it);
+    }
+    return true;
+}
+
+const OnionSkinCache::TintedFrame& OnionSkinCache::tintedFrame(const Project::Frame& frame, const OnionSkinLayer& layer)
+{
+    TintedFrame& tinted = tinted_[frame.id];
+    tinted.used = true;
+    if (!tinted.pixels.empty() && tinted.generation == frame.generation && tinted.tint == layer.tint
+        && tinted.opacity == layer.opacity)
+        return tinted;
+
+    tinted.generation = frame.generation;
+    tinted.tint = layer.tint;
+    tinted.opacity = layer.opacity;
+    tinted.pixels.resize(frame.pixels.size());
+    const int opacity = std::clamp(layer.opacity, 0, 100);
+    parallelFor(0, height_, [&](int y) {
+        const size_t rowStart = static_cast<size_t>(y) * static_cast<size_t>(width_);
+        for (int x = 0; x < width_; ++x)
+            tinted.pixels[rowStart + static_cast<size_t>(x)] = tintPixel(frame.pixels[rowStart + static_cast<size_t>(x)], layer.tint, opacity);
+    });
+    return tinted;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 洋葱皮中一帧邻帧的显示方式
+ */
+struct OnionSkinLayer
+{
+    uint32_t tint = 0xFF4040FF;   // 色调（RGBA8888，alpha 不使用）
+    int opacity = 50;             // 不透明度（0~100）
+};
+
+/**
+ * @brief 洋葱皮设置：当前帧之前 previous 帧、之后 next 帧，距离越远的层排在数组越后面
+ */
+struct OnionSkinSettings
+{
+    static constexpr int kMaxFrames = 4;   // 每一侧最多显示的帧数
+
+    int previous = 1;
+    int next = 1;
+    OnionSkinLayer previousLayers[kMaxFrames];
+    OnionSkinLayer nextLayers[kMaxFrames];
+
+    OnionSkinSettings();
+};
+
+/**
+ * @brief 要叠加显示的一帧邻帧
+ */
+struct OnionSkinNeighbor
+{
+    int frameIndex = 0;
+    OnionSkinLayer layer;
+};
+
+/**
+ * @brief 洋葱皮合成
+ *
+ * 邻帧按色调与不透明度着色后，由远到近依次叠加（近处的帧盖住远处的帧），
+ * 最后由画布在当前帧下方显示。
+ *
+ * GPU 可以直接从纹理数组取邻帧时只需要 collectNeighbors；否则用 OnionSkinCache
+ * 在 CPU 上合成一张图再上传。
+ */
+class OnionSkin
+{
+public:
+    // 着色强度：邻帧颜色向色调靠拢的比例（着色器中使用同一常量）
+    static constexpr int kTintStrength = 60;   // 百分比
+
+    // 由远到近列出要显示的邻帧（超出帧范围的跳过，不环绕）
+    static void collectNeighbors(int frameCount,
+                                 int currentFrame,
+                                 const OnionSkinSettings& settings,
+                                 std::vector<OnionSkinNeighbor>& out);
+};
+
+/**
+ * @brief CPU 合成的洋葱皮缓存
+ *
+ * 每个邻帧的着色结果按帧编号缓存，记录 (版本号, 色调, 不透明度)，只有帧被修改或设置变化时才重新着色；
+ * 合成结果记录由哪些 (帧, 版本号, 设置) 组成，组成不变时（例如只在当前帧上绘画）直接复用。
+ * 拖动时间轴时，仍在范围内的邻帧不需要重新着色，只重新叠加一次。
+ */
+class OnionSkinCache
+{
+public:
+    /**
+     * @brief 按当前帧与设置更新合成结果
+     * @return true 表示合成结果发生了变化（需要重新上传）
+     */
+    bool update(const Project& project, int currentFrame, const OnionSkinSettings& settings);
+
+    // 合成结果（straight alpha，尺寸同画布）；没有邻帧时为空
+    const std::vector<uint32_t>& getPixels() const
+    {
+        return composite_;
+    }
+
+    bool isEmpty() const
+    {
+        return composite_.empty();
+    }
+
+    // 释放所有缓存
+    void clear();
+
+private:
+    struct TintedFrame
+    {
+        uint64_t generation = 0;
+        uint32_t tint = 0;
+        int opacity = 0;
+        std::vector<uint32_t> pixels;   // 着色后的像素，alpha 已乘以不透明度
+        bool used = false;
+    };
+
+    struct CompositeKey
+    {
+        uint64_t frameId = 0;
+        uint64_t generation = 0;
+        uint32_t tint = 0;
+        int opacity = 0;
+
+        bool operator==(const CompositeKey& other) const
+        {
+            return frameId == other.frameId && generation == other.generation && tint == other.tint
+                && opacity == other.opacity;
+        }
+    };
+
+    const TintedFrame& tintedFrame(const Project::Frame& frame, const OnionSkinLayer& layer);
+
+    std::unordered_map<uint64_t, TintedFrame> tinted_;   // 帧编号 -> 着色结果
+    std::vector<CompositeKey> compositeKeys_;
+    std::vector<uint32_t> composite_;
+    std::vector<OnionSkinNeighbor> neighbors_;
+    int width_ = 0;
+    int height_ = 0;
+};
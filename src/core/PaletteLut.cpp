@@ -0,0 +1,51 @@
+#include "core/PaletteLut.h"
+
+#include "core/Parallel.h"
+
+#include <algorithm>
+
+void PaletteLut::update(const std::vector<uint32_t>& palette, uint64_t revision)
+{
+    if (built_ && revision == revision_)
+        return;
+
+    built_ = true;
+    revision_ = revision;
+    // 下标用 uint16_t 存储，超出部分的颜色不参与匹配
+    palette_.assign(palette.begin(), palette.begin() + std::min<size_t>(palette.size(), 0xFFFF));
+    table_.assign(static_cast<size_t>(kTableSize), 0);
+    if (palette_.empty())
+        return;
+
+    // 按蓝色层并行；每格取格中心与各调色板颜色比较平方距离
+    constexpr int kLevels = 1 << kBitsPerChannel;
+    constexpr int kHalfCell = 1 << (8 - kBitsPerChannel - 1);
+    parallelFor(0, kLevels, [&](int b) {
+        const int cb = (b << (8 - kBitsPerChannel)) + kHalfCell;
+        for (int g = 0; g < kLevels; ++g)
+        {
+            const int cg = (g << (8 - kBitsPerChannel)) + kHalfCell;
+            for (int r = 0; r < kLevels; ++r)
+            {
+                const int cr = (r << (8 - kBitsPerChannel)) + kHalfCell;
+                int bestIndex = 0;
+                int bestDistance = 0x7FFFFFFF;
+                for (size_t i = 0; i < palette_.size(); ++i)
+                {
+                    const uint32_t color = palette_[i];
+                    const int dr = static_cast<int>((color >> 0) & 0xFF) - cr;
+                    const int dg = static_cast<int>((color >> 8) & 0xFF) - cg;
+                    const int db = static_cast<int>((color >> 16) & 0xFF) - cb;
+                    const int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = static_cast<int>(i);
+                    }
+                }
+                table_[static_cast<size_t>(r | (g << kBitsPerChannel) | (b << (kBitsPerChannel * 2)))] =
+                    static_cast<uint16_t>(bestIndex);
+            }
+        }
+    });
+}
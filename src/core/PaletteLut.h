@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 调色板最近色查找表
+ *
+ * 把 RGB 各量化到 5 位（共 32768 格），每格预先算好距离格中心最近的调色板颜色下标。
+ * 之后任意颜色映射到调色板只需一次查表，不再逐像素遍历调色板。
+ * 查找表只依赖调色板内容，按 AppContext 的调色板版本号判断是否需要重建。
+ */
+class PaletteLut
+{
+public:
+    static constexpr int kBitsPerChannel = 5;
+    static constexpr int kTableSize = 1 << (kBitsPerChannel * 3);
+
+    // 调色板版本号与上次不同时重建；相同时不做任何事
+    void update(const std::vector<uint32_t>& palette, uint64_t revision);
+
+    bool isEmpty() const
+    {
+        return palette_.empty();
+    }
+
+    // 最近的调色板颜色（RGBA8888）；调色板为空时原样返回
+    uint32_t nearest(uint32_t rgba) const
+    {
+        if (palette_.empty())
+            return rgba;
+        return palette_[table_[keyOf(rgba)]];
+    }
+
+private:
+    static uint32_t keyOf(uint32_t rgba)
+    {
+        const uint32_t r = (rgba >> (0 + 8 - kBitsPerChannel)) & 0x1F;
+        const uint32_t g = (rgba >> (8 + 8 - kBitsPerChannel)) & 0x1F;
+        const uint32_t b = (rgba >> (16 + 8 - kBitsPerChannel)) & 0x1F;
+        return r | (g << kBitsPerChannel) | (b << (kBitsPerChannel * 2));
+    }
+
+    std::vector<uint32_t> palette_;
+    std::vector<uint16_t> table_;
+    uint64_t revision_ = 0;
+    bool built_ = false;
+};
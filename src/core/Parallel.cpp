@@ -0,0 +1,119 @@
+#include "core/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 常驻工作线程池
+     *
+     * 同一时刻只执行一个任务（busy_ 标记）。每个任务所有工作线程都要确认完成后 run 才返回，
+     * 所以工作线程不会在任务结束后再访问已经失效的 context。
+     */
+    class WorkerPool
+    {
+    public:
+        WorkerPool()
+        {
+            const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+            threads_.reserve(hardwareThreads - 1);
+            for (unsigned t = 1; t < hardwareThreads; ++t)
+                threads_.emplace_back(&WorkerPool::workerLoop, this);
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            for (std::thread& thread : threads_)
+                thread.join();
+        }
+
+        // 池空闲时执行任务并返回 true；被占用时返回 false（由调用方串行执行）
+        bool tryRun(int begin, int end, Parallel::Invoke invoke, void* context)
+        {
+            bool expected = false;
+            if (threads_.empty() || !busy_.compare_exchange_strong(expected, true))
+                return false;
+
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                invoke_ = invoke;
+                context_ = context;
+                end_ = end;
+                next_.store(begin);
+                finished_ = 0;
+                ++job_;
+            }
+            wake_.notify_all();
+            drain(invoke, context, end);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return finished_ == threads_.size(); });
+            lock.unlock();
+            busy_.store(false);
+            return true;
+        }
+
+    private:
+        void drain(Parallel::Invoke invoke, void* context, int end)
+        {
+            for (int i = next_.fetch_add(1); i < end; i = next_.fetch_add(1))
+                invoke(context, i);
+        }
+
+        void workerLoop()
+        {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                wake_.wait(lock, [&]() { return stopping_ || job_ != seen; });
+                if (stopping_)
+                    return;
+                seen = job_;
+                const Parallel::Invoke invoke = invoke_;
+                void* context = context_;
+                const int end = end_;
+                lock.unlock();
+
+                drain(invoke, context, end);
+
+                lock.lock();
+                if (++finished_ == threads_.size())
+                    done_.notify_one();
+            }
+        }
+
+        std::vector<std::thread> threads_;
+        std::atomic<bool> busy_{false};
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        uint64_t job_ = 0;
+        size_t finished_ = 0;
+        bool stopping_ = false;
+        Parallel::Invoke invoke_ = nullptr;
+        void* context_ = nullptr;
+        int end_ = 0;
+        std::atomic<int> next_{0};
+    };
+} // namespace
+
+void Parallel::run(int begin, int end, Invoke invoke, void* context)
+{
+    static WorkerPool pool;
+    if (pool.tryRun(begin, end, invoke, context))
+        return;
+    for (int i = begin; i < end; ++i)
+        invoke(context, i);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <type_traits>
+
+namespace Parallel
+{
+    // 类型擦除后的任务：对下标 index 调用 context 指向的函数对象
+    using Invoke = void (*)(void* context, int index);
+
+    /**
+     * @brief 在常驻工作线程池上执行 [begin, end)
+     *
+     * 线程池在第一次使用时创建（硬件线程数 - 1 个工作线程），之后一直复用，
+     * 每次调用只有唤醒/等待的开销，没有线程创建与回收。
+     * 池正被占用时（嵌套调用，或另一个线程正在使用）直接在调用线程串行执行。
+     */
+    void run(int begin, int end, Invoke invoke, void* context);
+} // namespace Parallel
+
+/**
+ * @brief 简单的并行 for：把 [begin, end) 的下标动态分发给工作线程
+ *
+ * - 每个下标只会被一个线程处理一次；fn 需保证不同下标之间不写同一块数据（例如按帧并行）
+ * - 工作线程来自常驻线程池；只有一个任务、单核或嵌套调用时直接在调用线程串行执行
+ * - 调用线程本身也参与计算，函数返回时所有任务均已完成
+ */
+template <typename Fn>
+void parallelFor(int begin, int end, Fn&& fn)
+{
+    if (end - begin <= 0)
+        return;
+    if (end - begin == 1)
+    {
+        fn(begin);
+        return;
+    }
+
+    using Callable = typename std::remove_reference<Fn>::type;
+    Parallel::run(
+        begin,
+        end,
+        [](void* context, int index) { (*static_cast<Callable*>(context))(index); },
+        const_cast<void*>(static_cast<const void*>(&fn)));
+}
@@ -1,6 +1,7 @@
 #include "Project.h"
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 
 namespace
@@ -10,6 +11,13 @@ namespace
     {
         return std::max(1, value);
     }
+
+    // 帧编号与版本号共用的全局计数器：项目重新加载后编号也不会与旧纹理缓存撞上
+    uint64_t nextStamp()
+    {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
 }
 
 Project::Project() : Project(16, 16, 1, 0x00000000) {}
@@ -75,6 +83,11 @@ void Project::resizeCanvas(int width, int height, uint32_t fillColor)
     // 更新尺寸
     width_ = newWidth;
     height_ = newHeight;
+
+    // 尺寸变化后脏块表与旧缓存都失效
+    for (Frame& frame : frames_)
+        resetFrameStamp(frame);
+    touchFrameList();
 }
 
 void Project::setFrameCount(int count, uint32_t fillColor)
@@ -88,6 +101,7 @@ void Project::setFrameCount(int count, uint32_t fillColor)
     {
         // 缩小帧数：直接截断
         frames_.resize(static_cast<size_t>(newCount));
+        touchFrameList();
         return;
     }
 
@@ -98,7 +112,9 @@ void Project::setFrameCount(int count, uint32_t fillColor)
     for (size_t i = oldCount; i < frames_.size(); ++i)
     {
         frames_[i].pixels.assign(pixelCount, fillColor);
+        resetFrameStamp(frames_[i]);
     }
+    touchFrameList();
 }
 
 void Project::insertFrameAfter(int index, uint32_t fillColor)
@@ -116,8 +132,10 @@ void Project::insertFrameAfter(int index, uint32_t fillColor)
     const size_t pixelCount =
         static_cast<size_t>(width_) * static_cast<size_t>(height_);
     newFrame.pixels.assign(pixelCount, fillColor);
+    resetFrameStamp(newFrame);
 
     frames_.insert(frames_.begin() + static_cast<long long>(insertPos), std::move(newFrame));
+    touchFrameList();
 }
 
 void Project::removeFrame(int index)
@@ -127,6 +145,7 @@ void Project::removeFrame(int index)
 
     const int clamped = std::clamp(index, 0, static_cast<int>(frames_.size()) - 1);
     frames_.erase(frames_.begin() + static_cast<long long>(clamped));
+    touchFrameList();
 }
 
 void Project::createFrames(int count, uint32_t fillColor)
@@ -140,5 +159,106 @@ void Project::createFrames(int count, uint32_t fillColor)
     for (Frame& frame : frames_)
     {
         frame.pixels.assign(pixelCount, fillColor);
+        resetFrameStamp(frame);
+    }
+    touchFrameList();
+}
+
+void Project::resetFrameStamp(Frame& frame) const
+{
+    frame.id = nextStamp();
+    frame.generation = nextStamp();
+    frame.tileGenerations.assign(static_cast<size_t>(getTilesPerRow()) * static_cast<size_t>(getTilesPerColumn()),
+                                 frame.generation);
+}
+
+void Project::touchFrameList()
+{
+    frameListRevision_ = nextStamp();
+    revision_ = frameListRevision_;
+}
+
+void Project::markDirty(int index, int x0, int y0, int x1, int y1)
+{
+    if (index < 0 || index >= static_cast<int>(frames_.size()))
+        return;
+
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(width_ - 1, x1);
+    y1 = std::min(height_ - 1, y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    Frame& frame = frames_[static_cast<size_t>(index)];
+    const int tilesPerRow = getTilesPerRow();
+    frame.generation = nextStamp();
+    revision_ = frame.generation;
+    for (int ty = y0 / kDirtyTileSize; ty <= y1 / kDirtyTileSize; ++ty)
+    {
+        uint64_t* row = frame.tileGenerations.data() + static_cast<size_t>(ty) * static_cast<size_t>(tilesPerRow);
+        std::fill(row + x0 / kDirtyTileSize, row + x1 / kDirtyTileSize + 1, frame.generation);
+    }
+}
+
+void Project::markDirty(int index)
+{
+    markDirty(index, 0, 0, width_ - 1, height_ - 1);
+}
+
+size_t Project::collectDirtyRects(int index, uint64_t since, std::vector<DirtyRect>& out) const
+{
+    out.clear();
+    const Frame& frame = getFrame(index);
+    if (frame.generation <= since)
+        return 0;
+
+    const int tilesPerRow = getTilesPerRow();
+    const int tilesPerColumn = getTilesPerColumn();
+    size_t pixelCount = 0;
+    std::vector<size_t> open;   // 下边缘恰好在上一块行底部的矩形（可继续向下延伸）
+    std::vector<size_t> nextOpen;
+    for (int ty = 0; ty < tilesPerColumn; ++ty)
+    {
+        const uint64_t* row = frame.tileGenerations.data() + static_cast<size_t>(ty) * static_cast<size_t>(tilesPerRow);
+        const int y = ty * kDirtyTileSize;
+        const int h = std::min(kDirtyTileSize, height_ - y);
+        nextOpen.clear();
+        for (int tx = 0; tx < tilesPerRow;)
+        {
+            if (row[tx] <= since)
+            {
+                ++tx;
+                continue;
+            }
+            const int runStart = tx;
+            while (tx < tilesPerRow && row[tx] > since)
+                ++tx;
+
+            DirtyRect rect;
+            rect.x = runStart * kDirtyTileSize;
+            rect.y = y;
+            rect.width = std::min(tx * kDirtyTileSize, width_) - rect.x;
+            rect.height = h;
+            pixelCount += static_cast<size_t>(rect.width) * static_cast<size_t>(h);
+
+            // 与上一块行中横向范围相同的矩形向下延伸
+            size_t target = out.size();
+            for (size_t i : open)
+            {
+                if (out[i].x == rect.x && out[i].width == rect.width)
+                {
+                    target = i;
+                    break;
+                }
+            }
+            if (target < out.size())
+                out[target].height += h;
+            else
+                out.push_back(rect);
+            nextOpen.push_back(target);
+        }
+        open.swap(nextOpen);
     }
+    return pixelCount;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -19,10 +20,31 @@
 class Project
 {
 public:
+    // 脏块粒度（与撤销记录的 tile 一致）
+    static constexpr int kDirtyTileSize = 32;
+
     struct Frame
     {
         // RGBA8888 像素数组，长度始终等于 width * height
         std::vector<uint32_t> pixels;
+
+        // 帧创建（含调整画布尺寸）时分配的唯一编号；插入/删除帧后下标会变，编号不变
+        uint64_t id = 0;
+
+        // 最近一次修改的版本号（全局递增，不同帧/不同项目之间也不会重复）
+        uint64_t generation = 0;
+
+        // 每个脏块最近一次修改的版本号，按行优先排列
+        std::vector<uint64_t> tileGenerations;
+    };
+
+    // 像素矩形（左上角 + 尺寸）
+    struct DirtyRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
     };
 
     // 默认构造：16x16、1 帧、透明填充
@@ -71,10 +93,56 @@ public:
     // 删除指定帧（至少保留 1 帧）
     void removeFrame(int index);
 
+    /**
+     * @brief 标记帧像素已修改
+     *
+     * 直接改写 frame.pixels 的代码（笔画、撤销记录）负责调用；纹理等缓存记住已同步的
+     * (id, generation)，之后只需重新读取版本号更新过的脏块。
+     * 区域为闭区间 [x0, x1] x [y0, y1]，自动裁剪到画布内。
+     */
+    void markDirty(int index, int x0, int y0, int x1, int y1);
+    void markDirty(int index);
+
+    /**
+     * @brief 收集 since 之后修改过的区域
+     *
+     * 同一行相邻的脏块合并为一段，上下相邻且横向范围相同的段再合并为矩形。
+     * @return 脏区域的像素总数
+     */
+    size_t collectDirtyRects(int index, uint64_t since, std::vector<DirtyRect>& out) const;
+
+    // 项目版本号：任一帧被标记修改或帧列表变化时更新，缓存据此跳过没有变化的 UI 帧
+    uint64_t getRevision() const
+    {
+        return revision_;
+    }
+
+    // 帧列表版本号：插入/删除帧、调整帧数或画布尺寸时更新（帧下标与编号的对应可能变了）
+    uint64_t getFrameListRevision() const
+    {
+        return frameListRevision_;
+    }
+
+    // 脏块表的尺寸（Frame::tileGenerations 按行优先排列）
+    int getTilesPerRow() const
+    {
+        return (width_ + kDirtyTileSize - 1) / kDirtyTileSize;
+    }
+    int getTilesPerColumn() const
+    {
+        return (height_ + kDirtyTileSize - 1) / kDirtyTileSize;
+    }
+
 private:
     // 按当前 width_/height_ 创建指定数量的帧并填充像素
     void createFrames(int count, uint32_t fillColor);
 
+    // 给新建（或整体替换像素）的帧分配新编号，并按当前尺寸重置脏块表
+    void resetFrameStamp(Frame& frame) const;
+
+    // 帧列表变化后调用：同时更新项目版本号与帧列表版本号
+    void touchFrameList();
+
     // 项目信息
     std::string name_ = "Untitled";
     int width_ = 0;
@@ -82,4 +150,6 @@ private:
 
     // 帧列表
     std::vector<Frame> frames_;
+    uint64_t revision_ = 0;
+    uint64_t frameListRevision_ = 0;
 };
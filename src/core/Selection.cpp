@@ -0,0 +1,294 @@
+#include "core/Selection.h"
+
+#include "core/SimdConfig.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // 每个通道差值都不超过 tolerance 视为命中
+    bool matchScalar(uint32_t pixel, uint32_t color, int tolerance)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            const int a = static_cast<int>((pixel >> shift) & 0xFF);
+            const int b = static_cast<int>((color >> shift) & 0xFF);
+            if (std::abs(a - b) > tolerance)
+                return false;
+        }
+        return true;
+    }
+
+#if PA_HAS_SSE2
+    // 比较 4 个像素，返回 4 位命中掩码（第 i 位对应第 i 个像素）
+    template <bool kExact>
+    int matchLanes(__m128i pixels, __m128i color, __m128i tolerance)
+    {
+        __m128i hit;
+        if (kExact)
+        {
+            hit = _mm_cmpeq_epi32(pixels, color);
+        }
+        else
+        {
+            // |p - c| 按字节求绝对差，再减去容差；四个通道都归零才算命中
+            const __m128i diff = _mm_or_si128(_mm_subs_epu8(pixels, color), _mm_subs_epu8(color, pixels));
+            hit = _mm_cmpeq_epi32(_mm_subs_epu8(diff, tolerance), _mm_setzero_si128());
+        }
+        return _mm_movemask_ps(_mm_castsi128_ps(hit));
+    }
+
+    // 一次处理 64 个像素，产出一个完整掩码字
+    template <bool kExact>
+    uint64_t matchWord(const uint32_t* src, __m128i color, __m128i tolerance)
+    {
+        uint64_t bits = 0;
+        for (int k = 0; k < 64; k += 16)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(src + k);
+            const uint64_t m0 = static_cast<uint64_t>(matchLanes<kExact>(_mm_loadu_si128(p + 0), color, tolerance));
+            const uint64_t m1 = static_cast<uint64_t>(matchLanes<kExact>(_mm_loadu_si128(p + 1), color, tolerance));
+            const uint64_t m2 = static_cast<uint64_t>(matchLanes<kExact>(_mm_loadu_si128(p + 2), color, tolerance));
+            const uint64_t m3 = static_cast<uint64_t>(matchLanes<kExact>(_mm_loadu_si128(p + 3), color, tolerance));
+            bits |= (m0 | (m1 << 4) | (m2 << 8) | (m3 << 12)) << k;
+        }
+        return bits;
+    }
+#endif
+
+    // 生成一行的命中掩码，写入 outWords（长度 >= ceil(width / 64)）
+    void buildRowMask(const uint32_t* row, int width, uint32_t color, int tolerance, uint64_t* outWords)
+    {
+        int x = 0;
+        int word = 0;
+#if PA_HAS_SSE2
+        const __m128i colorVec = _mm_set1_epi32(static_cast<int>(color));
+        const __m128i toleranceVec = _mm_set1_epi8(static_cast<char>(tolerance));
+        if (tolerance == 0)
+        {
+            for (; x + 64 <= width; x += 64, ++word)
+                outWords[word] = matchWord<true>(row + x, colorVec, toleranceVec);
+        }
+        else
+        {
+            for (; x + 64 <= width; x += 64, ++word)
+                outWords[word] = matchWord<false>(row + x, colorVec, toleranceVec);
+        }
+#endif
+        // 行尾不足 64 像素（或无 SIMD）时走标量路径
+        for (; x < width; x += 64, ++word)
+        {
+            const int count = std::min(64, width - x);
+            uint64_t bits = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (matchScalar(row[x + i], color, tolerance))
+                    bits |= uint64_t(1) << i;
+            }
+            outWords[word] = bits;
+        }
+    }
+} // namespace
+
+Selection::Selection(int width, int height)
+{
+    resize(width, height);
+}
+
+void Selection::resize(int width, int height)
+{
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    wordsPerRow_ = (width_ + 63) / 64;
+    words_.assign(static_cast<size_t>(wordsPerRow_) * static_cast<size_t>(height_), 0);
+}
+
+bool Selection::isEmpty() const
+{
+    return std::all_of(words_.begin(), words_.end(), [](uint64_t w) { return w == 0; });
+}
+
+void Selection::clear()
+{
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+void Selection::selectAll()
+{
+    for (int y = 0; y < height_; ++y)
+        setSpan(y, 0, width_ - 1, true);
+}
+
+bool Selection::contains(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= width_ || y >= height_)
+        return false;
+    return (rowWords(y)[x >> 6] >> (x & 63)) & 1u;
+}
+
+void Selection::set(int x, int y, bool selected)
+{
+    if (x < 0 || y < 0 || x >= width_ || y >= height_)
+        return;
+    const uint64_t bit = uint64_t(1) << (x & 63);
+    uint64_t& word = rowWords(y)[x >> 6];
+    word = selected ? (word | bit) : (word & ~bit);
+}
+
+void Selection::setSpan(int y, int x0, int x1, bool selected)
+{
+    if (y < 0 || y >= height_)
+        return;
+    x0 = std::max(0, x0);
+    x1 = std::min(width_ - 1, x1);
+    if (x0 > x1)
+        return;
+
+    uint64_t* row = rowWords(y);
+    const int firstWord = x0 >> 6;
+    const int lastWord = x1 >> 6;
+    for (int w = firstWord; w <= lastWord; ++w)
+    {
+        // 计算本字内 [lo, hi] 的位掩码
+        const int lo = (w == firstWord) ? (x0 & 63) : 0;
+        const int hi = (w == lastWord) ? (x1 & 63) : 63;
+        const uint64_t upper = (hi == 63) ? ~uint64_t(0) : ((uint64_t(1) << (hi + 1)) - 1);
+        const uint64_t mask = upper & ~((uint64_t(1) << lo) - 1);
+        row[w] = selected ? (row[w] | mask) : (row[w] & ~mask);
+    }
+}
+
+void Selection::combine(const Selection& other, SelectionMode mode)
+{
+    if (other.width_ != width_ || other.height_ != height_)
+        return;
+
+    switch (mode)
+    {
+    case SelectionMode::Replace:
+        words_ = other.words_;
+        break;
+    case SelectionMode::Add:
+        for (size_t i = 0; i < words_.size(); ++i)
+            words_[i] |= other.words_[i];
+        break;
+    case SelectionMode::Subtract:
+        for (size_t i = 0; i < words_.size(); ++i)
+            words_[i] &= ~other.words_[i];
+        break;
+    default:
+        break;
+    }
+}
+
+bool Selection::getBounds(int& minX, int& minY, int& maxX, int& maxY) const
+{
+    minX = width_;
+    minY = height_;
+    maxX = -1;
+    maxY = -1;
+    for (int y = 0; y < height_; ++y)
+    {
+        const uint64_t* row = rowWords(y);
+        for (int w = 0; w < wordsPerRow_; ++w)
+        {
+            if (row[w] == 0)
+                continue;
+            // 本字内最低/最高置位即该字覆盖的最左/最右像素
+            int lo = 0;
+            while (((row[w] >> lo) & 1u) == 0)
+                ++lo;
+            int hi = 63;
+            while (((row[w] >> hi) & 1u) == 0)
+                --hi;
+            minX = std::min(minX, w * 64 + lo);
+            maxX = std::max(maxX, w * 64 + hi);
+            minY = std::min(minY, y);
+            maxY = y;
+        }
+    }
+    return maxX >= 0;
+}
+
+void Selection::buildColorMask(const uint32_t* pixels,
+                               int width,
+                               int height,
+                               uint32_t color,
+                               int tolerance,
+                               Selection& out)
+{
+    if (out.width_ != width || out.height_ != height)
+        out.resize(width, height);
+
+    tolerance = std::clamp(tolerance, 0, 255);
+    for (int y = 0; y < height; ++y)
+    {
+        const uint32_t* row = pixels + static_cast<size_t>(y) * static_cast<size_t>(width);
+        buildRowMask(row, width, color, tolerance, out.rowWords(y));
+    }
+}
+
+void Selection::buildMagicWand(const uint32_t* pixels,
+                               int width,
+                               int height,
+                               int x,
+                               int y,
+                               int tolerance,
+                               Selection& out)
+{
+    out.resize(width, height);
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return;
+
+    // 1) 先生成“颜色命中”候选掩码（SIMD）
+    const uint32_t seedColor = pixels[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
+    Selection candidates;
+    buildColorMask(pixels, width, height, seedColor, tolerance, candidates);
+
+    // 2) 在候选掩码上做扫描线填充，只访问连通区域内的像素
+    const auto open = [&](int px, int py) {
+        return candidates.contains(px, py) && !out.contains(px, py);
+    };
+
+    std::vector<std::pair<int, int>> stack;
+    stack.emplace_back(x, y);
+    while (!stack.empty())
+    {
+        const auto [sx, sy] = stack.back();
+        stack.pop_back();
+        if (!open(sx, sy))
+            continue;
+
+        int left = sx;
+        while (left > 0 && open(left - 1, sy))
+            --left;
+        int right = sx;
+        while (right < width - 1 && open(right + 1, sy))
+            ++right;
+        out.setSpan(sy, left, right, true);
+
+        // 上下两行中每段连续候选只压入一个种子
+        for (int ny = sy - 1; ny <= sy + 1; ny += 2)
+        {
+            if (ny < 0 || ny >= height)
+                continue;
+            bool inRun = false;
+            for (int px = left; px <= right; ++px)
+            {
+                if (open(px, ny))
+                {
+                    if (!inRun)
+                        stack.emplace_back(px, ny);
+                    inRun = true;
+                }
+                else
+                {
+                    inRun = false;
+                }
+            }
+        }
+    }
+}
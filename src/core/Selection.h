@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 选区合并方式（魔棒、按颜色选择等命令共用）
+ */
+enum class SelectionMode : int
+{
+    Replace = 0,   // 替换当前选区
+    Add,           // 并入当前选区
+    Subtract,      // 从当前选区中减去
+    Count
+};
+
+/**
+ * @brief 像素选区（按位打包的掩码）
+ *
+ * 主要职责：
+ * - 每个像素占 1 bit，每行按 64 位字对齐存储，便于整字做并/差等位运算
+ * - 提供按颜色选择与魔棒（连续区域）两种选区构建方法
+ *
+ * 注意：
+ * - 坐标与 Project::Frame 像素索引一致（左上角为原点，行优先）
+ * - 选区尺寸应与画布一致；尺寸变化时由调用方 resize（内容会被清空）
+ */
+class Selection
+{
+public:
+    Selection() = default;
+    Selection(int width, int height);
+
+    // 重新分配尺寸并清空选区
+    void resize(int width, int height);
+
+    int getWidth() const
+    {
+        return width_;
+    }
+    int getHeight() const
+    {
+        return height_;
+    }
+
+    // 每行占用的 64 位字数
+    int getWordsPerRow() const
+    {
+        return wordsPerRow_;
+    }
+
+    // 某一行的位数据（x 对应第 x / 64 个字的第 x % 64 位）
+    uint64_t* rowWords(int y)
+    {
+        return words_.data() + static_cast<size_t>(y) * static_cast<size_t>(wordsPerRow_);
+    }
+    const uint64_t* rowWords(int y) const
+    {
+        return words_.data() + static_cast<size_t>(y) * static_cast<size_t>(wordsPerRow_);
+    }
+
+    // 选区是否为空
+    bool isEmpty() const;
+
+    // 清空 / 全选
+    void clear();
+    void selectAll();
+
+    // 单像素读写；越界读取返回 false，越界写入忽略
+    bool contains(int x, int y) const;
+    void set(int x, int y, bool selected);
+
+    // 整段写入一行中 [x0, x1]（闭区间，自动裁剪到画布内）
+    void setSpan(int y, int x0, int x1, bool selected);
+
+    // 按指定方式与另一个同尺寸选区合并
+    void combine(const Selection& other, SelectionMode mode);
+
+    // 选区包围盒（闭区间）；选区为空时返回 false
+    bool getBounds(int& minX, int& minY, int& maxX, int& maxY) const;
+
+    /**
+     * @brief 按颜色选择：选中所有与 color 在容差内的像素（不要求连续）
+     *
+     * 每个通道的差值都不超过 tolerance 才算命中；tolerance = 0 为精确匹配。
+     * 内部按 16 像素一组做 SIMD 比较并直接生成掩码位。
+     */
+    static void buildColorMask(const uint32_t* pixels,
+                               int width,
+                               int height,
+                               uint32_t color,
+                               int tolerance,
+                               Selection& out);
+
+    /**
+     * @brief 魔棒：从 (x, y) 出发选中 4 邻域连通且颜色在容差内的像素
+     *
+     * 先用 buildColorMask 得到候选掩码，再在掩码上做扫描线填充提取连通区域。
+     */
+    static void buildMagicWand(const uint32_t* pixels,
+                               int width,
+                               int height,
+                               int x,
+                               int y,
+                               int tolerance,
+                               Selection& out);
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    int wordsPerRow_ = 0;
+
+    // 位数据，长度始终等于 wordsPerRow_ * height_
+    std::vector<uint64_t> words_;
+};
@@ -0,0 +1,29 @@
+#include "core/ShadeRamp.h"
+
+#include <algorithm>
+
+void ShadeRamp::update(const std::vector<uint32_t>& colors, uint64_t revision)
+{
+    if (built_ && revision == revision_)
+        return;
+
+    built_ = true;
+    revision_ = revision;
+    colors_.clear();
+    positions_.clear();
+    for (uint32_t color : colors)
+    {
+        // 同一颜色重复出现时保留第一次的位置
+        if (positions_.emplace(color, static_cast<int>(colors_.size())).second)
+            colors_.push_back(color);
+    }
+}
+
+uint32_t ShadeRamp::shift(uint32_t rgba, int steps) const
+{
+    const auto it = positions_.find(rgba);
+    if (it == positions_.end())
+        return rgba;
+    const int position = std::clamp(it->second + steps, 0, static_cast<int>(colors_.size()) - 1);
+    return colors_[static_cast<size_t>(position)];
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 明暗色带查找表
+ *
+ * 色带是若干颜色的有序序列（由调色板面板定义）。颜色按值保存，
+ * 所以之后修改或增删调色板不会改变明暗笔经过的颜色。
+ * 颜色 -> 色带位置的哈希表在色带变化时重建一次，
+ * 之后逐像素的“沿色带移动一级”只是一次哈希查找。
+ */
+class ShadeRamp
+{
+public:
+    // 色带版本号与上次不同时重建；colors 为色带中的颜色（按顺序）
+    void update(const std::vector<uint32_t>& colors, uint64_t revision);
+
+    bool isEmpty() const
+    {
+        return colors_.empty();
+    }
+
+    const std::vector<uint32_t>& getColors() const
+    {
+        return colors_;
+    }
+
+    // 沿色带移动 steps 级（到两端为止）；不在色带中的颜色原样返回
+    uint32_t shift(uint32_t rgba, int steps) const;
+
+private:
+    std::vector<uint32_t> colors_;
+    std::unordered_map<uint32_t, int> positions_;
+    uint64_t revision_ = 0;
+    bool built_ = false;
+};
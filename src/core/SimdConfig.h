@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * @file SimdConfig.h
+ * @brief SIMD 指令集探测
+ *
+ * SSE2 是 x86-64 的基线指令集（MinGW / MSVC 64 位默认开启），像素批处理内核优先走 SSE2；
+ * 其他平台（如 ARM）自动退回标量路径，结果保持一致。
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PA_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define PA_HAS_SSE2 0
+#endif
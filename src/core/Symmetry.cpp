@@ -0,0 +1,257 @@
+#include "core/Symmetry.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // 反向映射取整时的偏置，避免 90 度整数倍旋转落在像素边界上时因浮点误差错位
+    constexpr float kRoundBias = 1e-4f;
+    constexpr float kPi = 3.14159265358979f;
+
+    // 印章按行索引的只读视图，用于径向旋转时的成员测试
+    class StampRows
+    {
+    public:
+        explicit StampRows(const std::vector<PixelSpan>& stamp)
+        {
+            if (stamp.empty())
+                return;
+
+            minX_ = maxX_ = stamp.front().x0;
+            minY_ = maxY_ = stamp.front().y;
+            for (const PixelSpan& span : stamp)
+            {
+                minX_ = std::min(minX_, span.x0);
+                maxX_ = std::max(maxX_, span.x1);
+                minY_ = std::min(minY_, span.y);
+                maxY_ = std::max(maxY_, span.y);
+            }
+            rows_.resize(static_cast<size_t>(maxY_ - minY_ + 1));
+            for (const PixelSpan& span : stamp)
+                rows_[static_cast<size_t>(span.y - minY_)].push_back(span);
+        }
+
+        bool empty() const
+        {
+            return rows_.empty();
+        }
+
+        bool contains(int x, int y) const
+        {
+            if (y < minY_ || y > maxY_ || x < minX_ || x > maxX_)
+                return false;
+            for (const PixelSpan& span : rows_[static_cast<size_t>(y - minY_)])
+            {
+                if (x >= span.x0 && x <= span.x1)
+                    return true;
+            }
+            return false;
+        }
+
+        int minX() const { return minX_; }
+        int maxX() const { return maxX_; }
+        int minY() const { return minY_; }
+        int maxY() const { return maxY_; }
+
+    private:
+        std::vector<std::vector<PixelSpan>> rows_;
+        int minX_ = 0;
+        int maxX_ = 0;
+        int minY_ = 0;
+        int maxY_ = 0;
+    };
+
+    // 印章绕画布中心旋转 radians 后的副本，逐行输出连续段
+    void appendRotated(const StampRows& rows, float radians, int canvasWidth, int canvasHeight, std::vector<PixelSpan>& out)
+    {
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        const float cx = static_cast<float>(canvasWidth) * 0.5f;
+        const float cy = static_cast<float>(canvasHeight) * 0.5f;
+
+        // 旋转后包围盒（四个角正向旋转）
+        const float corners[4][2] = {
+            {static_cast<float>(rows.minX()) - cx, static_cast<float>(rows.minY()) - cy},
+            {static_cast<float>(rows.maxX() + 1) - cx, static_cast<float>(rows.minY()) - cy},
+            {static_cast<float>(rows.minX()) - cx, static_cast<float>(rows.maxY() + 1) - cy},
+            {static_cast<float>(rows.maxX() + 1) - cx, static_cast<float>(rows.maxY() + 1) - cy},
+        };
+        float minX = 1e30f;
+        float minY = 1e30f;
+        float maxX = -1e30f;
+        float maxY = -1e30f;
+        for (const auto& corner : corners)
+        {
+            const float rx = corner[0] * c - corner[1] * s + cx;
+            const float ry = corner[0] * s + corner[1] * c + cy;
+            minX = std::min(minX, rx);
+            maxX = std::max(maxX, rx);
+            minY = std::min(minY, ry);
+            maxY = std::max(maxY, ry);
+        }
+        const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+        const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+        const int x1 = std::min(canvasWidth - 1, static_cast<int>(std::ceil(maxX)));
+        const int y1 = std::min(canvasHeight - 1, static_cast<int>(std::ceil(maxY)));
+
+        for (int y = y0; y <= y1; ++y)
+        {
+            const float py = static_cast<float>(y) + 0.5f - cy;
+            int runStart = -1;
+            for (int x = x0; x <= x1; ++x)
+            {
+                const float px = static_cast<float>(x) + 0.5f - cx;
+                const int sx = static_cast<int>(std::floor(px * c + py * s + cx + kRoundBias));
+                const int sy = static_cast<int>(std::floor(-px * s + py * c + cy + kRoundBias));
+                const bool inside = rows.contains(sx, sy);
+                if (inside && runStart < 0)
+                {
+                    runStart = x;
+                }
+                else if (!inside && runStart >= 0)
+                {
+                    out.push_back({y, runStart, x - 1});
+                    runStart = -1;
+                }
+            }
+            if (runStart >= 0)
+                out.push_back({y, runStart, x1});
+        }
+    }
+
+    // 裁剪到画布、按 (y, x0) 排序并合并重叠/相邻段
+    void mergeSpans(std::vector<PixelSpan>& spans, int canvasWidth, int canvasHeight)
+    {
+        size_t kept = 0;
+        for (const PixelSpan& span : spans)
+        {
+            if (span.y < 0 || span.y >= canvasHeight)
+                continue;
+            const int x0 = std::max(0, span.x0);
+            const int x1 = std::min(canvasWidth - 1, span.x1);
+            if (x0 > x1)
+                continue;
+            spans[kept++] = {span.y, x0, x1};
+        }
+        spans.resize(kept);
+
+        std::sort(spans.begin(), spans.end(), [](const PixelSpan& a, const PixelSpan& b) {
+            return a.y != b.y ? a.y < b.y : a.x0 < b.x0;
+        });
+
+        size_t merged = 0;
+        for (size_t i = 0; i < spans.size(); ++i)
+        {
+            if (merged > 0 && spans[merged - 1].y == spans[i].y && spans[i].x0 <= spans[merged - 1].x1 + 1)
+            {
+                spans[merged - 1].x1 = std::max(spans[merged - 1].x1, spans[i].x1);
+                continue;
+            }
+            spans[merged++] = spans[i];
+        }
+        spans.resize(merged);
+    }
+} // namespace
+
+void Symmetry::expandSpans(const std::vector<PixelSpan>& stamp,
+                           SymmetryMode mode,
+                           int folds,
+                           int canvasWidth,
+                           int canvasHeight,
+                           std::vector<PixelSpan>& out)
+{
+    out.clear();
+    out.reserve(stamp.size() * 4);
+    out.insert(out.end(), stamp.begin(), stamp.end());
+
+    const bool mirrorX = (mode == SymmetryMode::Horizontal || mode == SymmetryMode::Both);
+    const bool mirrorY = (mode == SymmetryMode::Vertical || mode == SymmetryMode::Both);
+    for (const PixelSpan& span : stamp)
+    {
+        const int mx0 = canvasWidth - 1 - span.x1;
+        const int mx1 = canvasWidth - 1 - span.x0;
+        const int my = canvasHeight - 1 - span.y;
+        if (mirrorX)
+            out.push_back({span.y, mx0, mx1});
+        if (mirrorY)
+            out.push_back({my, span.x0, span.x1});
+        if (mirrorX && mirrorY)
+            out.push_back({my, mx0, mx1});
+    }
+
+    if (mode == SymmetryMode::Radial)
+    {
+        const StampRows rows(stamp);
+        folds = std::clamp(folds, kMinRadialFolds, kMaxRadialFolds);
+        if (!rows.empty())
+        {
+            for (int k = 1; k < folds; ++k)
+                appendRotated(rows, 2.0f * kPi * static_cast<float>(k) / static_cast<float>(folds), canvasWidth, canvasHeight, out);
+        }
+    }
+
+    mergeSpans(out, canvasWidth, canvasHeight);
+}
+
+void Symmetry::expandPoints(int x,
+                            int y,
+                            SymmetryMode mode,
+                            int folds,
+                            int canvasWidth,
+                            int canvasHeight,
+                            std::vector<std::pair<int, int>>& out)
+{
+    out.clear();
+    out.emplace_back(x, y);
+
+    const bool mirrorX = (mode == SymmetryMode::Horizontal || mode == SymmetryMode::Both);
+    const bool mirrorY = (mode == SymmetryMode::Vertical || mode == SymmetryMode::Both);
+    if (mirrorX)
+        out.emplace_back(canvasWidth - 1 - x, y);
+    if (mirrorY)
+        out.emplace_back(x, canvasHeight - 1 - y);
+    if (mirrorX && mirrorY)
+        out.emplace_back(canvasWidth - 1 - x, canvasHeight - 1 - y);
+
+    if (mode == SymmetryMode::Radial)
+    {
+        folds = std::clamp(folds, kMinRadialFolds, kMaxRadialFolds);
+        const float cx = static_cast<float>(canvasWidth) * 0.5f;
+        const float cy = static_cast<float>(canvasHeight) * 0.5f;
+        const float px = static_cast<float>(x) + 0.5f - cx;
+        const float py = static_cast<float>(y) + 0.5f - cy;
+        for (int k = 1; k < folds; ++k)
+        {
+            const float radians = 2.0f * kPi * static_cast<float>(k) / static_cast<float>(folds);
+            const float c = std::cos(radians);
+            const float s = std::sin(radians);
+            out.emplace_back(static_cast<int>(std::floor(px * c - py * s + cx + kRoundBias)),
+                             static_cast<int>(std::floor(px * s + py * c + cy + kRoundBias)));
+        }
+    }
+
+    out.erase(std::remove_if(out.begin(), out.end(), [&](const std::pair<int, int>& p) {
+        return p.first < 0 || p.second < 0 || p.first >= canvasWidth || p.second >= canvasHeight;
+    }), out.end());
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+bool Symmetry::fillSpans(Project::Frame& frame, int canvasWidth, const std::vector<PixelSpan>& spans, uint32_t color)
+{
+    bool changed = false;
+    for (const PixelSpan& span : spans)
+    {
+        uint32_t* row = frame.pixels.data() + static_cast<size_t>(span.y) * static_cast<size_t>(canvasWidth);
+        for (int x = span.x0; x <= span.x1; ++x)
+        {
+            if (row[x] != color)
+            {
+                row[x] = color;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "core/Project.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 对称绘制模式
+ */
+enum class SymmetryMode : int
+{
+    None = 0,     // 关闭
+    Horizontal,   // 左右镜像（绕画布竖直中线）
+    Vertical,     // 上下镜像（绕画布水平中线）
+    Both,         // 左右 + 上下（四份）
+    Radial,       // 绕画布中心 N 等分旋转
+    Count
+};
+
+/**
+ * @brief 一行内的连续像素段 [x0, x1]（闭区间）
+ */
+struct PixelSpan
+{
+    int y = 0;
+    int x0 = 0;
+    int x1 = 0;
+};
+
+/**
+ * @brief 对称绘制的行段变换
+ *
+ * 笔刷印章先表示为若干行段，再按对称模式变换出所有镜像/旋转副本，
+ * 最后按 (y, x0) 排序并合并重叠、相邻的段，裁剪到画布内。
+ * 这样各副本重叠的像素只写一次，写入量不超过“副本数 x 印章面积”。
+ *
+ * - 镜像只翻转段的端点，开销与段数成正比
+ * - 径向旋转对旋转后的包围盒做反向映射（避免正向旋转产生的空洞），逐行输出连续段
+ */
+class Symmetry
+{
+public:
+    // 径向对称的份数范围
+    static constexpr int kMinRadialFolds = 2;
+    static constexpr int kMaxRadialFolds = 16;
+
+    /**
+     * @brief 把印章行段变换为包含全部对称副本的合并行段
+     * @param stamp   原始印章（可超出画布，未裁剪）
+     * @param folds   径向份数（仅 Radial 使用）
+     * @param out     输出：已裁剪到画布、按行排序、互不重叠的行段
+     */
+    static void expandSpans(const std::vector<PixelSpan>& stamp,
+                            SymmetryMode mode,
+                            int folds,
+                            int canvasWidth,
+                            int canvasHeight,
+                            std::vector<PixelSpan>& out);
+
+    // 单点工具（如填充）使用：输出 (x, y) 的全部对称位置（已去重、已裁剪）
+    static void expandPoints(int x,
+                             int y,
+                             SymmetryMode mode,
+                             int folds,
+                             int canvasWidth,
+                             int canvasHeight,
+                             std::vector<std::pair<int, int>>& out);
+
+    // 把行段写为指定颜色；返回 true 表示有像素发生了变化
+    static bool fillSpans(Project::Frame& frame, int canvasWidth, const std::vector<PixelSpan>& spans, uint32_t color);
+};
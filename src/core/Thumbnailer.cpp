@@ -0,0 +1,145 @@
+#include "core/Thumbnailer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+Thumbnailer::Thumbnailer(int maxSize)
+    : maxSize_(maxSize)
+{
+}
+
+Thumbnailer::~Thumbnailer()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable())
+        worker_.join();
+}
+
+bool Thumbnailer::submit(const Project& project, int frameIndex)
+{
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (isBusyLocked(frame.id))
+            return false;
+    }
+
+    // 该帧没有任务，副本此时只有 UI 线程访问：在锁外拷贝，工作线程取任务时不必等待
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    std::shared_ptr<Snapshot>& snapshot = snapshots_[frame.id];
+    Project::DirtyRect bounds{0, 0, width, height};
+    if (!snapshot || snapshot->width != width || snapshot->height != height)
+    {
+        // 第一次提交（或画布尺寸变了）：整帧拷贝
+        if (!snapshot)
+            snapshot = std::make_shared<Snapshot>();
+        snapshot->width = width;
+        snapshot->height = height;
+        snapshot->pixels = frame.pixels;
+        FramePreview& preview = snapshot->preview;
+        preview.factor = FramePreviewCache::chooseFactor(width, height, maxSize_);
+        preview.width = (width + preview.factor - 1) / preview.factor;
+        preview.height = (height + preview.factor - 1) / preview.factor;
+        preview.pixels.assign(static_cast<size_t>(preview.width) * static_cast<size_t>(preview.height), 0u);
+    }
+    else
+    {
+        // 只拷贝副本版本之后修改过的区域，重新缩小的范围取它们的包围盒
+        project.collectDirtyRects(frameIndex, snapshot->generation, rects_);
+        int minX = width, minY = height, maxX = 0, maxY = 0;
+        for (const Project::DirtyRect& rect : rects_)
+        {
+            for (int y = rect.y; y < rect.y + rect.height; ++y)
+            {
+                const size_t offset = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(rect.x);
+                std::memcpy(snapshot->pixels.data() + offset, frame.pixels.data() + offset, static_cast<size_t>(rect.width) * sizeof(uint32_t));
+            }
+            minX = std::min(minX, rect.x);
+            minY = std::min(minY, rect.y);
+            maxX = std::max(maxX, rect.x + rect.width);
+            maxY = std::max(maxY, rect.y + rect.height);
+        }
+        bounds = rects_.empty() ? Project::DirtyRect{} : Project::DirtyRect{minX, minY, maxX - minX, maxY - minY};
+    }
+    snapshot->generation = frame.generation;
+
+    Job job;
+    job.frameId = frame.id;
+    job.generation = frame.generation;
+    job.bounds = bounds;
+    job.snapshot = snapshot;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        jobs_.push_back(std::move(job));
+        if (!worker_.joinable())
+            worker_ = std::thread(&Thumbnailer::run, this);
+    }
+    wake_.notify_one();
+    return true;
+}
+
+bool Thumbnailer::isBusy(uint64_t frameId) const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return isBusyLocked(frameId);
+}
+
+bool Thumbnailer::isBusyLocked(uint64_t frameId) const
+{
+    if (activeFrameId_ == frameId)
+        return true;
+    for (const Job& queued : jobs_)
+    {
+        if (queued.frameId == frameId)
+            return true;
+    }
+    return false;
+}
+
+void Thumbnailer::forget(uint64_t frameId)
+{
+    snapshots_.erase(frameId);
+}
+
+void Thumbnailer::collect(std::vector<Result>& out)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (Result& result : finished_)
+        out.push_back(std::move(result));
+    finished_.clear();
+}
+
+void Thumbnailer::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+        if (stopping_)
+            return;
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        activeFrameId_ = job.frameId;
+        lock.unlock();
+
+        Snapshot& snapshot = *job.snapshot;
+        if (job.bounds.width > 0 && job.bounds.height > 0)
+            FramePreviewCache::downsample(snapshot.pixels.data(), snapshot.width, snapshot.height, job.bounds, snapshot.preview, false);
+        Result result;
+        result.frameId = job.frameId;
+        result.generation = job.generation;
+        result.preview = snapshot.preview;
+        job.snapshot.reset();
+
+        lock.lock();
+        activeFrameId_ = 0;
+        finished_.push_back(std::move(result));
+    }
+}
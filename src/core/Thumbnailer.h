@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/FramePreview.h"
+#include "core/Project.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 后台缩略图生成
+ *
+ * 每个被跟踪的帧（按帧编号）有一份工作线程使用的像素副本与缩小结果。UI 线程提交时（submit）
+ * 只把副本版本号之后的脏区域（Project::collectDirtyRects）拷进副本，工作线程再只重新缩小这部分，
+ * 结果由 UI 线程在下一次 collect 时取走并上传。工作线程不接触 Project，所以绘画不需要等待缩略图。
+ *
+ * 同一帧同时最多只有一个任务：排队中或正在处理时副本归工作线程读取，submit 直接拒绝。
+ * 不再需要的帧调用 forget 释放副本。工作线程在第一次提交时启动，析构时结束。
+ */
+class Thumbnailer
+{
+public:
+    struct Result
+    {
+        uint64_t frameId = 0;
+        uint64_t generation = 0;   // 快照对应的帧版本号
+        FramePreview preview;
+    };
+
+    // maxSize 为缩略图最大边长（像素）
+    explicit Thumbnailer(int maxSize);
+    ~Thumbnailer();
+
+    Thumbnailer(const Thumbnailer&) = delete;
+    Thumbnailer& operator=(const Thumbnailer&) = delete;
+
+    /**
+     * @brief 把第 frameIndex 帧的改动同步进副本并排队重新缩小
+     * @return false 表示该帧还有未完成的任务，本次没有提交
+     */
+    bool submit(const Project& project, int frameIndex);
+
+    // 该帧是否还有排队中或正在处理的任务
+    bool isBusy(uint64_t frameId) const;
+
+    // 释放该帧的副本（不再显示它的缩略图时调用；有未完成任务时由任务持有到结束）
+    void forget(uint64_t frameId);
+
+    // 取出已完成的缩略图（追加到 out）
+    void collect(std::vector<Result>& out);
+
+private:
+    // 一帧的副本：只在没有任务时由 UI 线程写入，有任务时只由工作线程读写
+    struct Snapshot
+    {
+        uint64_t generation = 0;   // 副本对应的帧版本号
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+        FramePreview preview;
+    };
+
+    struct Job
+    {
+        uint64_t frameId = 0;
+        uint64_t generation = 0;
+        Project::DirtyRect bounds;   // 需要重新缩小的区域（原图像素坐标）
+        std::shared_ptr<Snapshot> snapshot;
+    };
+
+    bool isBusyLocked(uint64_t frameId) const;
+    void run();
+
+    const int maxSize_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> jobs_;
+    std::vector<Result> finished_;
+    std::unordered_map<uint64_t, std::shared_ptr<Snapshot>> snapshots_;   // 帧编号 -> 副本（只由 UI 线程访问）
+    std::vector<Project::DirtyRect> rects_;                               // submit 的临时脏区域（只由 UI 线程访问）
+    uint64_t activeFrameId_ = 0;   // 正在处理的帧（0 表示空闲）
+    bool stopping_ = false;
+    std::thread worker_;
+};
@@ -0,0 +1,43 @@
+#include "core/Tiling.h"
+
+void Tiling::wrapSpans(std::vector<PixelSpan>& spans, TiledMode mode, int canvasWidth, int canvasHeight)
+{
+    if (mode == TiledMode::None || canvasWidth <= 0 || canvasHeight <= 0)
+        return;
+
+    const bool wrapX = wrapsX(mode);
+    const bool wrapY = wrapsY(mode);
+    const size_t count = spans.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        PixelSpan span = spans[i];
+        if (wrapY)
+            span.y = wrap(span.y, canvasHeight);
+
+        if (!wrapX)
+        {
+            spans[i] = span;
+            continue;
+        }
+
+        // 宽于画布的段覆盖整行
+        if (span.x1 - span.x0 + 1 >= canvasWidth)
+        {
+            spans[i] = {span.y, 0, canvasWidth - 1};
+            continue;
+        }
+
+        const int x0 = wrap(span.x0, canvasWidth);
+        const int x1 = x0 + (span.x1 - span.x0);
+        if (x1 < canvasWidth)
+        {
+            spans[i] = {span.y, x0, x1};
+        }
+        else
+        {
+            // 跨越右边界：拆成 [x0, w-1] 与 [0, x1-w]
+            spans[i] = {span.y, x0, canvasWidth - 1};
+            spans.push_back({span.y, 0, x1 - canvasWidth});
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/Symmetry.h"
+
+/**
+ * @brief 平铺（环绕）模式：用于制作可无缝拼接的贴图
+ */
+enum class TiledMode : int
+{
+    None = 0,   // 关闭
+    X,          // 仅水平方向平铺
+    Y,          // 仅垂直方向平铺
+    Both,       // 水平 + 垂直
+    Count
+};
+
+/**
+ * @brief 平铺模式下的坐标环绕
+ *
+ * 绘制工具先把印章行段按画布尺寸环绕（跨边部分拆成两段移到另一侧），
+ * 之后的对称变换、写像素都只面对画布内的坐标。
+ */
+class Tiling
+{
+public:
+    static bool wrapsX(TiledMode mode)
+    {
+        return mode == TiledMode::X || mode == TiledMode::Both;
+    }
+    static bool wrapsY(TiledMode mode)
+    {
+        return mode == TiledMode::Y || mode == TiledMode::Both;
+    }
+
+    // 取模到 [0, size)（支持负数）
+    static int wrap(int value, int size)
+    {
+        const int r = value % size;
+        return r < 0 ? r + size : r;
+    }
+
+    // 按模式环绕行段；不环绕的方向保持原样（由后续裁剪处理）
+    static void wrapSpans(std::vector<PixelSpan>& spans, TiledMode mode, int canvasWidth, int canvasHeight);
+};
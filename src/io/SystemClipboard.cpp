@@ -0,0 +1,99 @@
+#include "io/SystemClipboard.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // 当前声明给系统的图像与按需生成的 PNG 缓存
+    struct OfferState
+    {
+        std::shared_ptr<const ImageBuffer> image;
+        std::vector<uint8_t> encodedPng;
+    };
+
+    OfferState& offerState()
+    {
+        static OfferState state;
+        return state;
+    }
+
+    // 把 RGBA8888 图像编码为 PNG 字节流；失败时返回空数组
+    std::vector<uint8_t> encodePng(const ImageBuffer& image)
+    {
+        std::vector<uint8_t> bytes;
+        if (image.width <= 0 || image.height <= 0)
+            return bytes;
+
+        // R 在低字节的 uint32_t 在小端内存中的字节顺序即 RGBA32
+        SDL_Surface* surface = SDL_CreateSurfaceFrom(
+            image.width,
+            image.height,
+            SDL_PIXELFORMAT_RGBA32,
+            const_cast<uint32_t*>(image.pixels.data()),
+            image.width * static_cast<int>(sizeof(uint32_t)));
+        if (!surface)
+            return bytes;
+
+        SDL_IOStream* stream = SDL_IOFromDynamicMem();
+        if (stream && IMG_SavePNG_IO(surface, stream, false))
+        {
+            const Sint64 size = SDL_GetIOSize(stream);
+            const void* data = SDL_GetPointerProperty(
+                SDL_GetIOProperties(stream), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, nullptr);
+            if (data && size > 0)
+            {
+                const uint8_t* begin = static_cast<const uint8_t*>(data);
+                bytes.assign(begin, begin + size);
+            }
+        }
+        if (stream)
+            SDL_CloseIO(stream);
+        SDL_DestroySurface(surface);
+        return bytes;
+    }
+
+    // 其他应用请求数据时才会调用：首次请求编码，之后复用缓存
+    const void* SDLCALL provideClipboardData(void* userdata, const char* mimeType, size_t* size)
+    {
+        (void)userdata;
+        (void)mimeType;
+
+        OfferState& state = offerState();
+        if (state.encodedPng.empty() && state.image)
+            state.encodedPng = encodePng(*state.image);
+
+        *size = state.encodedPng.size();
+        return state.encodedPng.empty() ? nullptr : state.encodedPng.data();
+    }
+
+    // 剪贴板被清空或被其他内容替换时释放引用
+    void SDLCALL releaseClipboardData(void* userdata)
+    {
+        (void)userdata;
+        OfferState& state = offerState();
+        state.image.reset();
+        state.encodedPng.clear();
+        state.encodedPng.shrink_to_fit();
+    }
+} // namespace
+
+bool SystemClipboard::offerImage(std::shared_ptr<const ImageBuffer> image)
+{
+    if (!image)
+        return false;
+
+    // 先声明再保存引用：SDL_SetClipboardData 会对旧数据调用 releaseClipboardData
+    const char* mimeTypes[] = {"image/png"};
+    if (!SDL_SetClipboardData(provideClipboardData, releaseClipboardData, nullptr, mimeTypes, 1))
+        return false;
+
+    OfferState& state = offerState();
+    state.image = std::move(image);
+    state.encodedPng.clear();
+    return true;
+}
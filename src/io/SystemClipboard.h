@@ -0,0 +1,23 @@
+#pragma once
+
+#include "core/ImageBuffer.h"
+
+#include <memory>
+
+/**
+ * @brief 系统剪贴板导出（延迟编码）
+ *
+ * offerImage 只向操作系统声明“可以提供 image/png”，并不立即编码；
+ * 直到其他应用真正请求剪贴板数据时，才在回调中把图像编码为 PNG。
+ * 在应用内反复 Copy 不会产生任何编码开销。
+ */
+class SystemClipboard
+{
+public:
+    /**
+     * @brief 向系统剪贴板声明图像数据
+     * @param image 要导出的图像（共享引用，不复制像素）
+     * @return true 声明成功；false 表示 SDL 调用失败
+     */
+    static bool offerImage(std::shared_ptr<const ImageBuffer> image);
+};
@@ -0,0 +1,41 @@
+#include "tools/BrushStamp.h"
+
+#include "core/AppContext.h"
+#include "core/Tiling.h"
+#include "tools/StrokeSession.h"
+
+#include <algorithm>
+
+void BrushStamp::build(int x,
+                       int y,
+                       const AppContext& context,
+                       int canvasWidth,
+                       int canvasHeight,
+                       std::vector<PixelSpan>& stamp,
+                       std::vector<PixelSpan>& out)
+{
+    const int radius = std::max(0, context.getBrushSize() - 1);
+
+    // 方形印章按行表示（不预先裁剪：平铺模式下先环绕，镜像/旋转后再统一裁剪到画布）
+    stamp.clear();
+    for (int py = y - radius; py <= y + radius; ++py)
+        stamp.push_back({py, x - radius, x + radius});
+
+    Tiling::wrapSpans(stamp, context.getTiledMode(), canvasWidth, canvasHeight);
+    Symmetry::expandSpans(stamp, context.getSymmetryMode(), context.getRadialFolds(), canvasWidth, canvasHeight, out);
+}
+
+bool BrushStamp::paint(StrokeSession& session, const std::vector<StrokeFilter::Point>& points, uint32_t color)
+{
+    std::vector<PixelSpan>& stamp = session.getStampScratch();
+    std::vector<PixelSpan>& spans = session.getSpanScratch();
+    bool changed = false;
+    for (const StrokeFilter::Point& point : points)
+    {
+        build(point.first, point.second, session.getContext(), session.getWidth(), session.getHeight(), stamp, spans);
+        session.touchSpans(spans);
+        if (Symmetry::fillSpans(session.getFrame(), session.getWidth(), spans, color))
+            changed = true;
+    }
+    return changed;
+}
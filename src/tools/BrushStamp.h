@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/Symmetry.h"
+#include "tools/StrokeFilter.h"
+
+#include <cstdint>
+#include <vector>
+
+class AppContext;
+class StrokeSession;
+
+/**
+ * @brief 画笔/橡皮擦共用的印章生成与批量绘制
+ *
+ * 印章以行段表示：先按笔刷大小生成，再按平铺模式环绕、按对称模式展开，
+ * 得到画布内互不重叠的行段后一次写入。
+ */
+class BrushStamp
+{
+public:
+    // 以 (x, y) 为中心生成印章并展开；stamp 为临时缓冲，结果写入 out
+    static void build(int x,
+                      int y,
+                      const AppContext& context,
+                      int canvasWidth,
+                      int canvasHeight,
+                      std::vector<PixelSpan>& stamp,
+                      std::vector<PixelSpan>& out);
+
+    // 在会话中沿一批点绘制印章（复用会话缓冲、登记撤销区域）；返回 true 表示有像素变化
+    static bool paint(StrokeSession& session, const std::vector<StrokeFilter::Point>& points, uint32_t color);
+};
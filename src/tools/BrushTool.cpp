@@ -1,7 +1,45 @@
 #include "tools/BrushTool.h"
 
-#include <algorithm>
+#include "tools/BrushStamp.h"
+#include "tools/CustomBrush.h"
+#include "tools/StrokeSession.h"
+
 #include <cstdint>
+#include <memory>
+#include <vector>
+
+void BrushTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    // 按下位置会作为第一批点经 updateStroke 绘制，这里无需额外处理
+    (void)session;
+    (void)x;
+    (void)y;
+}
+
+void BrushTool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    AppContext& context = session.getContext();
+    const std::shared_ptr<const CustomBrush>& custom = context.getCustomBrush();
+    if (!custom)
+    {
+        BrushStamp::paint(session, points, context.getColorRGBA());
+        return;
+    }
+
+    // 自定义笔刷：按预先转换好的行段整段拷贝；平铺模式下印章跨边的部分环绕到另一侧，按环绕后的矩形登记
+    const TiledMode tiled = context.getTiledMode();
+    const uint32_t color = context.getColorRGBA();
+    const uint32_t* overrideColor = context.isCustomBrushUsingColor() ? &color : nullptr;
+    for (const StrokeFilter::Point& point : points)
+    {
+        session.touchWrappedRect(point.first + custom->getMinX(),
+                                 point.second + custom->getMinY(),
+                                 point.first + custom->getMaxX(),
+                                 point.second + custom->getMaxY(),
+                                 tiled);
+        custom->stamp(session.getFrame(), session.getWidth(), session.getHeight(), point.first, point.second, tiled, overrideColor);
+    }
+}
 
 bool BrushTool::apply(Project::Frame& frame,
                       int canvasWidth,
@@ -13,26 +51,20 @@ bool BrushTool::apply(Project::Frame& frame,
 {
     (void)isMouseClicked;
 
-    const uint32_t color = context.getColorRGBA();
-    const int radius = std::max(0, context.getBrushSize() - 1);
-    const int minX = std::max(0, x - radius);
-    const int maxX = std::min(canvasWidth - 1, x + radius);
-    const int minY = std::max(0, y - radius);
-    const int maxY = std::min(canvasHeight - 1, y + radius);
-
-    bool changed = false;
-    for (int py = minY; py <= maxY; ++py)
+    if (const std::shared_ptr<const CustomBrush>& custom = context.getCustomBrush())
     {
-        const size_t row = static_cast<size_t>(py) * static_cast<size_t>(canvasWidth);
-        for (int px = minX; px <= maxX; ++px)
-        {
-            uint32_t& pixel = frame.pixels[row + static_cast<size_t>(px)];
-            if (pixel != color)
-            {
-                pixel = color;
-                changed = true;
-            }
-        }
+        const uint32_t color = context.getColorRGBA();
+        return custom->stamp(frame,
+                             canvasWidth,
+                             canvasHeight,
+                             x,
+                             y,
+                             context.getTiledMode(),
+                             context.isCustomBrushUsingColor() ? &color : nullptr);
     }
-    return changed;
+
+    std::vector<PixelSpan> stamp;
+    std::vector<PixelSpan> spans;
+    BrushStamp::build(x, y, context, canvasWidth, canvasHeight, stamp, spans);
+    return Symmetry::fillSpans(frame, canvasWidth, spans, context.getColorRGBA());
 }
@@ -0,0 +1,121 @@
+#include "tools/CustomBrush.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // 把 [x, x + length) 的颜色写到一行中；返回 true 表示有像素变化
+    bool writeRun(uint32_t* row, int x, int length, const uint32_t* colors, const uint32_t* overrideColor)
+    {
+        uint32_t* dst = row + x;
+        if (overrideColor)
+        {
+            bool changed = false;
+            for (int i = 0; i < length; ++i)
+            {
+                if (dst[i] != *overrideColor)
+                {
+                    dst[i] = *overrideColor;
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        const size_t bytes = static_cast<size_t>(length) * sizeof(uint32_t);
+        if (std::memcmp(dst, colors, bytes) == 0)
+            return false;
+        std::memcpy(dst, colors, bytes);
+        return true;
+    }
+} // namespace
+
+std::shared_ptr<const CustomBrush> CustomBrush::fromImage(const ImageBuffer& image)
+{
+    auto brush = std::make_shared<CustomBrush>();
+    brush->width_ = image.width;
+    brush->height_ = image.height;
+    brush->originX_ = image.width / 2;
+    brush->originY_ = image.height / 2;
+
+    for (int y = 0; y < image.height; ++y)
+    {
+        const uint32_t* row = image.pixels.data() + static_cast<size_t>(y) * static_cast<size_t>(image.width);
+        int x = 0;
+        while (x < image.width)
+        {
+            if ((row[x] >> 24) == 0)
+            {
+                ++x;
+                continue;
+            }
+            const int start = x;
+            while (x < image.width && (row[x] >> 24) != 0)
+                ++x;
+
+            Span span;
+            span.y = y - brush->originY_;
+            span.x0 = start - brush->originX_;
+            span.length = x - start;
+            span.offset = static_cast<uint32_t>(brush->colors_.size());
+            brush->colors_.insert(brush->colors_.end(), row + start, row + x);
+            brush->spans_.push_back(span);
+        }
+    }
+
+    if (brush->spans_.empty())
+        return nullptr;
+    return brush;
+}
+
+bool CustomBrush::stamp(Project::Frame& frame,
+                        int canvasWidth,
+                        int canvasHeight,
+                        int x,
+                        int y,
+                        TiledMode tiled,
+                        const uint32_t* overrideColor) const
+{
+    const bool wrapX = Tiling::wrapsX(tiled);
+    const bool wrapY = Tiling::wrapsY(tiled);
+    bool changed = false;
+    for (const Span& span : spans_)
+    {
+        int py = y + span.y;
+        if (wrapY)
+            py = Tiling::wrap(py, canvasHeight);
+        else if (py < 0 || py >= canvasHeight)
+            continue;
+
+        uint32_t* row = frame.pixels.data() + static_cast<size_t>(py) * static_cast<size_t>(canvasWidth);
+        const uint32_t* colors = colors_.data() + span.offset;
+        int x0 = x + span.x0;
+        int length = span.length;
+
+        if (wrapX)
+        {
+            // 行段长度可能超过画布宽度（大笔刷小画布），按画布宽度分段环绕
+            while (length > 0)
+            {
+                const int start = Tiling::wrap(x0, canvasWidth);
+                const int run = std::min(length, canvasWidth - start);
+                if (writeRun(row, start, run, colors, overrideColor))
+                    changed = true;
+                x0 += run;
+                colors += run;
+                length -= run;
+            }
+            continue;
+        }
+
+        const int clipLeft = std::max(0, -x0);
+        const int clipRight = std::max(0, x0 + length - canvasWidth);
+        length -= clipLeft + clipRight;
+        if (length <= 0)
+            continue;
+        if (writeRun(row, x0 + clipLeft, length, colors + clipLeft, overrideColor))
+            changed = true;
+    }
+    return changed;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/ImageBuffer.h"
+#include "core/Project.h"
+#include "core/Tiling.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 从选区捕获的图像笔刷
+ *
+ * 捕获时一次性把图像转换为“不透明像素行段 + 颜色”：透明像素不进入行段，
+ * 落笔时只需按行段整段拷贝颜色，不再逐像素判断透明度。
+ * 行段坐标相对笔刷中心（落笔点对齐图像中心）。
+ */
+class CustomBrush
+{
+public:
+    struct Span
+    {
+        int y = 0;            // 相对中心的行
+        int x0 = 0;           // 相对中心的起始列
+        int length = 0;       // 像素数
+        uint32_t offset = 0;  // 在 colors 中的起始下标
+    };
+
+    // 从图像构建；图像中没有不透明像素时返回 nullptr
+    static std::shared_ptr<const CustomBrush> fromImage(const ImageBuffer& image);
+
+    int getWidth() const
+    {
+        return width_;
+    }
+    int getHeight() const
+    {
+        return height_;
+    }
+
+    // 笔刷覆盖范围（相对落笔点，闭区间）
+    int getMinX() const
+    {
+        return -originX_;
+    }
+    int getMinY() const
+    {
+        return -originY_;
+    }
+    int getMaxX() const
+    {
+        return width_ - 1 - originX_;
+    }
+    int getMaxY() const
+    {
+        return height_ - 1 - originY_;
+    }
+
+    /**
+     * @brief 以 (x, y) 为落点盖章
+     * @param tiled         平铺模式：对应方向越界部分环绕到另一侧，否则裁掉
+     * @param overrideColor 非空时忽略笔刷颜色，只用笔刷形状（例如“用前景色绘制”）
+     * @return true 表示帧像素发生了修改
+     */
+    bool stamp(Project::Frame& frame,
+               int canvasWidth,
+               int canvasHeight,
+               int x,
+               int y,
+               TiledMode tiled,
+               const uint32_t* overrideColor) const;
+
+private:
+    std::vector<Span> spans_;
+    std::vector<uint32_t> colors_;
+    int width_ = 0;
+    int height_ = 0;
+    int originX_ = 0;
+    int originY_ = 0;
+};
@@ -1,7 +1,23 @@
 #include "tools/EraserTool.h"
 
-#include <algorithm>
+#include "tools/BrushStamp.h"
+#include "tools/StrokeSession.h"
+
 #include <cstdint>
+#include <vector>
+
+void EraserTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    // 按下位置会作为第一批点经 updateStroke 绘制，这里无需额外处理
+    (void)session;
+    (void)x;
+    (void)y;
+}
+
+void EraserTool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    BrushStamp::paint(session, points, 0x00000000);
+}
 
 bool EraserTool::apply(Project::Frame& frame,
                        int canvasWidth,
@@ -13,26 +29,8 @@ bool EraserTool::apply(Project::Frame& frame,
 {
     (void)isMouseClicked;
 
-    const uint32_t eraseColor = 0x00000000;
-    const int radius = std::max(0, context.getBrushSize() - 1);
-    const int minX = std::max(0, x - radius);
-    const int maxX = std::min(canvasWidth - 1, x + radius);
-    const int minY = std::max(0, y - radius);
-    const int maxY = std::min(canvasHeight - 1, y + radius);
-
-    bool changed = false;
-    for (int py = minY; py <= maxY; ++py)
-    {
-        const size_t row = static_cast<size_t>(py) * static_cast<size_t>(canvasWidth);
-        for (int px = minX; px <= maxX; ++px)
-        {
-            uint32_t& pixel = frame.pixels[row + static_cast<size_t>(px)];
-            if (pixel != eraseColor)
-            {
-                pixel = eraseColor;
-                changed = true;
-            }
-        }
-    }
-    return changed;
+    std::vector<PixelSpan> stamp;
+    std::vector<PixelSpan> spans;
+    BrushStamp::build(x, y, context, canvasWidth, canvasHeight, stamp, spans);
+    return Symmetry::fillSpans(frame, canvasWidth, spans, 0x00000000);
 }
@@ -6,6 +6,10 @@ class EraserTool final : public Tool
 {
 public:
     ToolType type() const override { return ToolType::Eraser; }
+    bool isFreehand() const override { return true; }
+
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+    void updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const override;
 
     bool apply(Project::Frame& frame,
                int canvasWidth,
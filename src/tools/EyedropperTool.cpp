@@ -1,5 +1,119 @@
 #include "tools/EyedropperTool.h"
 
+#include "core/SimdConfig.h"
+#include "tools/StrokeSession.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // 合成结果中 (x, y) 处的像素：浮动选区的不透明像素覆盖帧像素
+    uint32_t mergedPixel(const Project::Frame& frame, int canvasWidth, const FloatingSelection* floating, int x, int y)
+    {
+        if (floating)
+        {
+            const ImageBuffer* image = floating->getImage();
+            const int fx = x - floating->getX();
+            const int fy = y - floating->getY();
+            if (fx >= 0 && fy >= 0 && fx < image->width && fy < image->height)
+            {
+                const uint32_t color = image->pixels[static_cast<size_t>(fy) * static_cast<size_t>(image->width) + static_cast<size_t>(fx)];
+                if ((color >> 24) != 0)
+                    return color;
+            }
+        }
+        return frame.pixels[static_cast<size_t>(y) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(x)];
+    }
+
+    /**
+     * @brief 求一组像素的平均色
+     *
+     * RGB 只在不透明像素上平均（透明像素的 RGB 没有意义），alpha 在全部像素上平均。
+     * SSE2 下每次把 4 个像素按字节解包为 16 位通道累加：每个累加通道约承担一半像素，
+     * N <= 9 时不会溢出 16 位。
+     */
+    uint32_t averageColor(const uint32_t* pixels, int count)
+    {
+        uint32_t sums[4] = {0, 0, 0, 0};   // 不透明像素的 R、G、B 和全部像素的 A
+        int opaque = 0;
+        int i = 0;
+#if PA_HAS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        __m128i acc = _mm_setzero_si128();   // 两组 16 位 RGBA 累加（像素 0/2 与 1/3）
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+            // 透明像素的 RGB 清零，只保留 alpha（为 0）
+            const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(v, alphaMask), zero);
+            v = _mm_andnot_si128(transparent, v);
+            const int bits = _mm_movemask_ps(_mm_castsi128_ps(transparent));
+            opaque += 4 - ((bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + ((bits >> 3) & 1));
+            acc = _mm_add_epi16(acc, _mm_unpacklo_epi8(v, zero));
+            acc = _mm_add_epi16(acc, _mm_unpackhi_epi8(v, zero));
+        }
+        alignas(16) uint16_t lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        for (int c = 0; c < 4; ++c)
+            sums[c] = static_cast<uint32_t>(lanes[c]) + static_cast<uint32_t>(lanes[c + 4]);
+#endif
+        for (; i < count; ++i)
+        {
+            const uint32_t color = pixels[i];
+            if ((color >> 24) == 0)
+                continue;
+            ++opaque;
+            for (int c = 0; c < 4; ++c)
+                sums[c] += (color >> (c * 8)) & 0xFFu;
+        }
+
+        if (opaque == 0)
+            return 0x00000000;
+        uint32_t result = 0;
+        for (int c = 0; c < 3; ++c)
+            result |= ((sums[c] + static_cast<uint32_t>(opaque) / 2) / static_cast<uint32_t>(opaque)) << (c * 8);
+        result |= ((sums[3] + static_cast<uint32_t>(count) / 2) / static_cast<uint32_t>(count)) << 24;
+        return result;
+    }
+} // namespace
+
+uint32_t EyedropperTool::sample(const Project::Frame& frame,
+                                int canvasWidth,
+                                int canvasHeight,
+                                int x,
+                                int y,
+                                const AppContext& context)
+{
+    const FloatingSelection& floatingSelection = context.getFloatingSelection();
+    const FloatingSelection* floating =
+        (context.getEyedropperMode() == EyedropperMode::Merged && floatingSelection.isActive()) ? &floatingSelection : nullptr;
+
+    const int radius = context.getEyedropperSize() / 2;
+    if (radius == 0)
+        return mergedPixel(frame, canvasWidth, floating, x, y);
+
+    // 先把窗口（裁剪到画布）收集为连续像素，再统一求平均
+    const int x0 = std::max(0, x - radius);
+    const int y0 = std::max(0, y - radius);
+    const int x1 = std::min(canvasWidth - 1, x + radius);
+    const int y1 = std::min(canvasHeight - 1, y + radius);
+    std::vector<uint32_t> window;
+    window.reserve(static_cast<size_t>(x1 - x0 + 1) * static_cast<size_t>(y1 - y0 + 1));
+    for (int py = y0; py <= y1; ++py)
+    {
+        if (!floating)
+        {
+            const uint32_t* row = frame.pixels.data() + static_cast<size_t>(py) * static_cast<size_t>(canvasWidth);
+            window.insert(window.end(), row + x0, row + x1 + 1);
+            continue;
+        }
+        for (int px = x0; px <= x1; ++px)
+            window.push_back(mergedPixel(frame, canvasWidth, floating, px, py));
+    }
+    return averageColor(window.data(), static_cast<int>(window.size()));
+}
+
 bool EyedropperTool::apply(Project::Frame& frame,
                            int canvasWidth,
                            int canvasHeight,
@@ -8,10 +122,13 @@ bool EyedropperTool::apply(Project::Frame& frame,
                            AppContext& context,
                            bool isMouseClicked) const
 {
-    (void)canvasHeight;
     (void)isMouseClicked;
 
-    const size_t index = static_cast<size_t>(y) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(x);
-    context.setColorRGBA(frame.pixels[index]);
+    context.setColorRGBA(sample(frame, canvasWidth, canvasHeight, x, y, context));
     return false;
 }
+
+void EyedropperTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    apply(session.getFrame(), session.getWidth(), session.getHeight(), x, y, session.getContext(), true);
+}
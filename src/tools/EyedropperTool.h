@@ -2,11 +2,19 @@
 
 #include "Tool.h"
 
+/**
+ * @brief 吸管：按下时把取到的颜色设为前景色
+ *
+ * 取色来源（当前帧 / 合成结果）与取样范围（N x N 平均）由 AppContext 决定。
+ */
 class EyedropperTool final : public Tool
 {
 public:
     ToolType type() const override { return ToolType::Eyedropper; }
 
+    // 不修改帧像素，按下时不需要记录撤销
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+
     bool apply(Project::Frame& frame,
                int canvasWidth,
                int canvasHeight,
@@ -14,4 +22,17 @@ public:
                int y,
                AppContext& context,
                bool isMouseClicked) const override;
+
+    /**
+     * @brief 按吸管设置取 (x, y) 处的颜色
+     *
+     * 合成模式下浮动选区中不透明的像素覆盖帧像素（与画布显示一致）；
+     * 取样窗口超出画布的部分忽略。
+     */
+    static uint32_t sample(const Project::Frame& frame,
+                           int canvasWidth,
+                           int canvasHeight,
+                           int x,
+                           int y,
+                           const AppContext& context);
 };
@@ -1,7 +1,60 @@
 #include "tools/FillTool.h"
 
+#include "core/Symmetry.h"
+#include "core/Tiling.h"
+
 #include <deque>
 #include <utility>
+#include <vector>
+
+namespace
+{
+    // 从 (x, y) 开始的 4 邻接填充；平铺模式下邻接关系跨边环绕
+    bool floodFill(Project::Frame& frame, int canvasWidth, int canvasHeight, int x, int y, uint32_t newColor, TiledMode tiled)
+    {
+        const size_t startIndex =
+            static_cast<size_t>(y) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(x);
+
+        const uint32_t oldColor = frame.pixels[startIndex];
+        if (oldColor == newColor)
+            return false;
+
+        std::deque<std::pair<int, int>> queue;
+        queue.emplace_back(x, y);
+        frame.pixels[startIndex] = newColor;
+
+        const int dx[4] = {1, -1, 0, 0};
+        const int dy[4] = {0, 0, 1, -1};
+
+        while (!queue.empty())
+        {
+            const auto [cx, cy] = queue.front();
+            queue.pop_front();
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int nx = cx + dx[i];
+                int ny = cy + dy[i];
+                if (Tiling::wrapsX(tiled))
+                    nx = Tiling::wrap(nx, canvasWidth);
+                if (Tiling::wrapsY(tiled))
+                    ny = Tiling::wrap(ny, canvasHeight);
+                if (nx < 0 || ny < 0 || nx >= canvasWidth || ny >= canvasHeight)
+                    continue;
+
+                const size_t index =
+                    static_cast<size_t>(ny) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(nx);
+                if (frame.pixels[index] != oldColor)
+                    continue;
+
+                frame.pixels[index] = newColor;
+                queue.emplace_back(nx, ny);
+            }
+        }
+
+        return true;
+    }
+} // namespace
 
 bool FillTool::apply(Project::Frame& frame,
                      int canvasWidth,
@@ -18,42 +71,15 @@ bool FillTool::apply(Project::Frame& frame,
     if (x < 0 || y < 0 || x >= canvasWidth || y >= canvasHeight)
         return false;
 
-    const size_t startIndex =
-        static_cast<size_t>(y) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(x);
-
-    const uint32_t oldColor = frame.pixels[startIndex];
-    const uint32_t newColor = context.getColorRGBA();
-    if (oldColor == newColor)
-        return false;
-
-    std::deque<std::pair<int, int>> queue;
-    queue.emplace_back(x, y);
-    frame.pixels[startIndex] = newColor;
+    // 对称模式下在每个对称种子点各填充一次；前一次已填到的区域颜色相同，会被直接跳过
+    std::vector<std::pair<int, int>> seeds;
+    Symmetry::expandPoints(x, y, context.getSymmetryMode(), context.getRadialFolds(), canvasWidth, canvasHeight, seeds);
 
-    const int dx[4] = {1, -1, 0, 0};
-    const int dy[4] = {0, 0, 1, -1};
-
-    while (!queue.empty())
+    bool changed = false;
+    for (const auto& [sx, sy] : seeds)
     {
-        const auto [cx, cy] = queue.front();
-        queue.pop_front();
-
-        for (int i = 0; i < 4; ++i)
-        {
-            const int nx = cx + dx[i];
-            const int ny = cy + dy[i];
-            if (nx < 0 || ny < 0 || nx >= canvasWidth || ny >= canvasHeight)
-                continue;
-
-            const size_t index =
-                static_cast<size_t>(ny) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(nx);
-            if (frame.pixels[index] != oldColor)
-                continue;
-
-            frame.pixels[index] = newColor;
-            queue.emplace_back(nx, ny);
-        }
+        if (floodFill(frame, canvasWidth, canvasHeight, sx, sy, context.getColorRGBA(), context.getTiledMode()))
+            changed = true;
     }
-
-    return true;
+    return changed;
 }
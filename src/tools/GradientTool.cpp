@@ -0,0 +1,83 @@
+#include "tools/GradientTool.h"
+
+#include "core/Dither.h"
+#include "core/Selection.h"
+#include "tools/StrokeSession.h"
+
+namespace
+{
+    // 绘制范围：有选区时为选区包围盒，否则为整帧
+    const Selection* paintRegion(StrokeSession& session, int& x0, int& y0, int& x1, int& y1)
+    {
+        const Selection& selection = session.getContext().getSelection();
+        x0 = 0;
+        y0 = 0;
+        x1 = session.getWidth() - 1;
+        y1 = session.getHeight() - 1;
+        if (selection.getWidth() != session.getWidth() || selection.getHeight() != session.getHeight())
+            return nullptr;
+        if (!selection.getBounds(x0, y0, x1, y1))
+        {
+            x0 = 0;
+            y0 = 0;
+            x1 = session.getWidth() - 1;
+            y1 = session.getHeight() - 1;
+            return nullptr;
+        }
+        return &selection;
+    }
+
+    void render(StrokeSession& session, int endX, int endY)
+    {
+        AppContext& context = session.getContext();
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = 0;
+        int y1 = 0;
+        const Selection* mask = paintRegion(session, x0, y0, x1, y1);
+
+        GradientParams params;
+        params.startX = session.getAnchorX();
+        params.startY = session.getAnchorY();
+        params.endX = endX;
+        params.endY = endY;
+        params.shape = context.getGradientShape();
+        params.matrix = context.getDitherMatrix();
+        params.startColor = context.getColorRGBA();
+        params.endColor = context.getSecondaryColorRGBA();
+
+        session.touchRect(x0, y0, x1, y1);
+        Dither::renderGradient(session.getFrame(), session.getWidth(), x0, y0, x1, y1, mask, params, context.getPaletteLut());
+    }
+} // namespace
+
+void GradientTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    session.setAnchor(x, y);
+    render(session, x, y);
+}
+
+void GradientTool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    // 整区重绘只取决于最新终点，本批中间的点无需逐个绘制
+    if (!points.empty())
+        render(session, points.back().first, points.back().second);
+}
+
+bool GradientTool::apply(Project::Frame& frame,
+                         int canvasWidth,
+                         int canvasHeight,
+                         int x,
+                         int y,
+                         AppContext& context,
+                         bool isMouseClicked) const
+{
+    (void)frame;
+    (void)canvasWidth;
+    (void)canvasHeight;
+    (void)x;
+    (void)y;
+    (void)context;
+    (void)isMouseClicked;
+    return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Tool.h"
+
+/**
+ * @brief 渐变工具：按下处为起点、拖动到的位置为终点
+ *
+ * 拖动期间每次更新都按最新终点整区重绘（选区存在时只绘制选区），
+ * 颜色从前景色过渡到背景色，经有序抖动量化到当前调色板。
+ */
+class GradientTool final : public Tool
+{
+public:
+    ToolType type() const override { return ToolType::Gradient; }
+    bool clampsStrokeToCanvas() const override { return true; }
+
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+    void updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const override;
+
+    // 渐变需要拖拽定义范围，单点调用不做任何修改
+    bool apply(Project::Frame& frame,
+               int canvasWidth,
+               int canvasHeight,
+               int x,
+               int y,
+               AppContext& context,
+               bool isMouseClicked) const override;
+};
@@ -0,0 +1,47 @@
+#include "tools/MagicWandTool.h"
+
+#include "core/Selection.h"
+#include "tools/StrokeSession.h"
+
+bool MagicWandTool::apply(Project::Frame& frame,
+                          int canvasWidth,
+                          int canvasHeight,
+                          int x,
+                          int y,
+                          AppContext& context,
+                          bool isMouseClicked) const
+{
+    // 与 Fill 相同，只在“按下瞬间”建立一次选区
+    if (!isMouseClicked)
+        return false;
+
+    if (x < 0 || y < 0 || x >= canvasWidth || y >= canvasHeight)
+        return false;
+
+    Selection picked;
+    if (context.isWandContiguous())
+    {
+        Selection::buildMagicWand(
+            frame.pixels.data(), canvasWidth, canvasHeight, x, y, context.getWandTolerance(), picked);
+    }
+    else
+    {
+        const size_t index =
+            static_cast<size_t>(y) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(x);
+        Selection::buildColorMask(
+            frame.pixels.data(), canvasWidth, canvasHeight, frame.pixels[index], context.getWandTolerance(), picked);
+    }
+
+    Selection& selection = context.getSelection();
+    if (selection.getWidth() != canvasWidth || selection.getHeight() != canvasHeight)
+        selection.resize(canvasWidth, canvasHeight);
+    selection.combine(picked, context.getSelectionMode());
+
+    // 选区不属于像素数据，不标记项目 dirty
+    return false;
+}
+
+void MagicWandTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    apply(session.getFrame(), session.getWidth(), session.getHeight(), x, y, session.getContext(), true);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Tool.h"
+
+class MagicWandTool final : public Tool
+{
+public:
+    ToolType type() const override { return ToolType::MagicWand; }
+
+    // 不修改帧像素，按下时不需要记录撤销
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+
+    bool apply(Project::Frame& frame,
+               int canvasWidth,
+               int canvasHeight,
+               int x,
+               int y,
+               AppContext& context,
+               bool isMouseClicked) const override;
+};
@@ -0,0 +1,102 @@
+#include "tools/ShadeTool.h"
+
+#include "core/ShadeRamp.h"
+#include "tools/BrushStamp.h"
+#include "tools/StrokeSession.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 对行段内的像素沿色带移动
+     * @param visited 非空时跳过已处理的像素并登记新处理的像素
+     */
+    bool shadeSpans(Project::Frame& frame,
+                    int canvasWidth,
+                    const std::vector<PixelSpan>& spans,
+                    const ShadeRamp& ramp,
+                    int steps,
+                    Selection* visited)
+    {
+        bool changed = false;
+        // 相邻像素多为同色，缓存上一次的映射结果以省去重复的哈希查找
+        uint32_t lastIn = 0;
+        uint32_t lastOut = ramp.shift(0, steps);
+        for (const PixelSpan& span : spans)
+        {
+            uint32_t* row = frame.pixels.data() + static_cast<size_t>(span.y) * static_cast<size_t>(canvasWidth);
+            uint64_t* words = visited ? visited->rowWords(span.y) : nullptr;
+            for (int x = span.x0; x <= span.x1; ++x)
+            {
+                if (words)
+                {
+                    uint64_t& word = words[x >> 6];
+                    const uint64_t bit = uint64_t(1) << (x & 63);
+                    if (word & bit)
+                        continue;
+                    word |= bit;
+                }
+                const uint32_t color = row[x];
+                if (color != lastIn)
+                {
+                    lastIn = color;
+                    lastOut = ramp.shift(color, steps);
+                }
+                if (lastOut != color)
+                {
+                    row[x] = lastOut;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+} // namespace
+
+void ShadeTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    // 按下位置会作为第一批点经 updateStroke 绘制，这里无需额外处理
+    (void)session;
+    (void)x;
+    (void)y;
+}
+
+void ShadeTool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    const AppContext& context = session.getContext();
+    const ShadeRamp& ramp = context.getShadeRamp();
+    if (ramp.isEmpty())
+        return;
+
+    std::vector<PixelSpan>& stamp = session.getStampScratch();
+    std::vector<PixelSpan>& spans = session.getSpanScratch();
+    Selection& visited = session.getVisitedMask();
+    for (const StrokeFilter::Point& point : points)
+    {
+        BrushStamp::build(point.first, point.second, context, session.getWidth(), session.getHeight(), stamp, spans);
+        session.touchSpans(spans);
+        shadeSpans(session.getFrame(), session.getWidth(), spans, ramp, context.getShadeStep(), &visited);
+    }
+}
+
+bool ShadeTool::apply(Project::Frame& frame,
+                      int canvasWidth,
+                      int canvasHeight,
+                      int x,
+                      int y,
+                      AppContext& context,
+                      bool isMouseClicked) const
+{
+    (void)isMouseClicked;
+
+    const ShadeRamp& ramp = context.getShadeRamp();
+    if (ramp.isEmpty())
+        return false;
+
+    std::vector<PixelSpan> stamp;
+    std::vector<PixelSpan> spans;
+    BrushStamp::build(x, y, context, canvasWidth, canvasHeight, stamp, spans);
+    return shadeSpans(frame, canvasWidth, spans, ramp, context.getShadeStep(), nullptr);
+}
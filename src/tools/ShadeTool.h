@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Tool.h"
+
+/**
+ * @brief 明暗笔：把笔刷覆盖的色带内颜色沿色带移动一级
+ *
+ * 印章与画笔相同（笔刷大小、平铺、对称）。同一笔画中每个像素只移动一次，
+ * 来回涂抹不会连续越级；不在色带中的颜色保持不变。
+ */
+class ShadeTool final : public Tool
+{
+public:
+    ToolType type() const override { return ToolType::Shade; }
+    bool isFreehand() const override { return true; }
+
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+    void updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const override;
+
+    bool apply(Project::Frame& frame,
+               int canvasWidth,
+               int canvasHeight,
+               int x,
+               int y,
+               AppContext& context,
+               bool isMouseClicked) const override;
+};
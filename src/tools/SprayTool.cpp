@@ -0,0 +1,116 @@
+#include "tools/SprayTool.h"
+
+#include "core/Noise.h"
+#include "core/Tiling.h"
+#include "tools/StrokeSession.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 以 (x, y) 为圆心喷一次
+     *
+     * StrokeFilter 逐像素给点，笔画划过时每个像素会被约 2r+1 个印章覆盖，
+     * 因此每个印章只在外接正方形内取 (2r+1) * density% 个随机点（落在圆外的丢弃），
+     * 使 density 大致对应“划过一次后的覆盖率”。
+     */
+    bool sprayAt(Project::Frame& frame,
+                 int canvasWidth,
+                 int canvasHeight,
+                 int x,
+                 int y,
+                 const AppContext& context,
+                 const std::vector<uint32_t>& colors,
+                 NoiseRng& rng,
+                 std::vector<uint32_t>& random)
+    {
+        const int radius = context.getSprayRadius();
+        const int side = radius * 2 + 1;
+        const int samples = std::max(1, side * context.getNoiseDensity() / Noise::kMaxDensity);
+        const TiledMode tiled = context.getTiledMode();
+        const uint64_t colorCount = colors.size();
+
+        // 每个点消耗 3 个随机数：dx、dy、颜色下标
+        random.resize(static_cast<size_t>(samples) * 3);
+        rng.generate(random.data(), samples * 3);
+
+        bool changed = false;
+        for (int i = 0; i < samples; ++i)
+        {
+            const uint32_t* r = random.data() + static_cast<size_t>(i) * 3;
+            const int dx = static_cast<int>((uint64_t(r[0]) * static_cast<uint64_t>(side)) >> 32) - radius;
+            const int dy = static_cast<int>((uint64_t(r[1]) * static_cast<uint64_t>(side)) >> 32) - radius;
+            if (dx * dx + dy * dy > radius * radius)
+                continue;
+
+            int px = x + dx;
+            int py = y + dy;
+            if (Tiling::wrapsX(tiled))
+                px = Tiling::wrap(px, canvasWidth);
+            if (Tiling::wrapsY(tiled))
+                py = Tiling::wrap(py, canvasHeight);
+            if (px < 0 || py < 0 || px >= canvasWidth || py >= canvasHeight)
+                continue;
+
+            const uint32_t color = colors[static_cast<size_t>((uint64_t(r[2]) * colorCount) >> 32)];
+            uint32_t& pixel = frame.pixels[static_cast<size_t>(py) * static_cast<size_t>(canvasWidth) + static_cast<size_t>(px)];
+            if (pixel != color)
+            {
+                pixel = color;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+} // namespace
+
+void SprayTool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    // 按下位置会作为第一批点经 updateStroke 绘制，这里只初始化随机数
+    (void)x;
+    (void)y;
+    session.getRng().reseed(session.getContext().getNoiseSeed());
+}
+
+void SprayTool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    AppContext& context = session.getContext();
+    std::vector<uint32_t> colors;
+    context.buildNoiseColors(colors);
+
+    // 平铺模式下喷点可能环绕到另一侧，按环绕后的 ±radius 矩形登记
+    const int radius = context.getSprayRadius();
+    const TiledMode tiled = context.getTiledMode();
+    std::vector<uint32_t> random;
+    for (const StrokeFilter::Point& point : points)
+    {
+        session.touchWrappedRect(point.first - radius, point.second - radius, point.first + radius, point.second + radius, tiled);
+        sprayAt(session.getFrame(), session.getWidth(), session.getHeight(), point.first, point.second, context, colors, session.getRng(), random);
+    }
+}
+
+void SprayTool::endStroke(StrokeSession& session) const
+{
+    session.getContext().advanceNoiseSeed();
+}
+
+bool SprayTool::apply(Project::Frame& frame,
+                      int canvasWidth,
+                      int canvasHeight,
+                      int x,
+                      int y,
+                      AppContext& context,
+                      bool isMouseClicked) const
+{
+    (void)isMouseClicked;
+
+    // 单点调用没有会话，按种子与落点派生随机序列
+    std::vector<uint32_t> colors;
+    context.buildNoiseColors(colors);
+    NoiseRng rng(Noise::mixSeed(context.getNoiseSeed(), (static_cast<uint64_t>(static_cast<uint32_t>(y)) << 32) | static_cast<uint32_t>(x)));
+    std::vector<uint32_t> random;
+    return sprayAt(frame, canvasWidth, canvasHeight, x, y, context, colors, rng, random);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Tool.h"
+
+/**
+ * @brief 喷枪：在圆形范围内按密度随机散布颜色
+ *
+ * 颜色来源、密度、半径取自 AppContext。每笔按当前种子初始化会话内的随机数发生器，
+ * 笔画结束后种子前进一步；同一种子沿同一路径喷涂得到完全相同的像素。
+ * 平铺模式下越界的点环绕到另一侧；对称模式不作用于喷枪。
+ */
+class SprayTool final : public Tool
+{
+public:
+    ToolType type() const override { return ToolType::Spray; }
+
+    void beginStroke(StrokeSession& session, int x, int y) const override;
+    void updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const override;
+    void endStroke(StrokeSession& session) const override;
+
+    bool apply(Project::Frame& frame,
+               int canvasWidth,
+               int canvasHeight,
+               int x,
+               int y,
+               AppContext& context,
+               bool isMouseClicked) const override;
+};
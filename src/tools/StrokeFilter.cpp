@@ -0,0 +1,89 @@
+#include "tools/StrokeFilter.h"
+
+#include <cstdlib>
+
+namespace
+{
+    // mid 是否为 prev -> next 之间的 L 形拐角
+    bool isLCorner(const StrokeFilter::Point& prev, const StrokeFilter::Point& mid, const StrokeFilter::Point& next)
+    {
+        const bool diagonal = std::abs(prev.first - next.first) == 1 && std::abs(prev.second - next.second) == 1;
+        if (!diagonal)
+            return false;
+        return (mid.first == prev.first || mid.first == next.first) &&
+            (mid.second == prev.second || mid.second == next.second);
+    }
+} // namespace
+
+void StrokeFilter::begin(int x, int y, bool pixelPerfect, std::vector<Point>& out)
+{
+    active_ = true;
+    pixelPerfect_ = pixelPerfect;
+    hasPending_ = false;
+    last_ = {x, y};
+    prev_ = last_;
+    out.push_back(last_);
+}
+
+void StrokeFilter::moveTo(int x, int y, std::vector<Point>& out)
+{
+    if (!active_ || (x == last_.first && y == last_.second))
+        return;
+
+    // Bresenham：从 last_ 走到 (x, y)，不含起点
+    int cx = last_.first;
+    int cy = last_.second;
+    const int dx = std::abs(x - cx);
+    const int dy = -std::abs(y - cy);
+    const int sx = cx < x ? 1 : -1;
+    const int sy = cy < y ? 1 : -1;
+    int err = dx + dy;
+    while (cx != x || cy != y)
+    {
+        const int e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            cx += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            cy += sy;
+        }
+        push({cx, cy}, out);
+    }
+    last_ = {x, y};
+}
+
+void StrokeFilter::end(std::vector<Point>& out)
+{
+    if (active_ && hasPending_)
+        out.push_back(pending_);
+    hasPending_ = false;
+    active_ = false;
+}
+
+void StrokeFilter::push(const Point& point, std::vector<Point>& out)
+{
+    if (!pixelPerfect_)
+    {
+        out.push_back(point);
+        prev_ = point;
+        return;
+    }
+
+    if (hasPending_)
+    {
+        // 候选点是拐角：直接用新点替换，拐角像素从未写入画布
+        if (isLCorner(prev_, pending_, point))
+        {
+            pending_ = point;
+            return;
+        }
+        out.push_back(pending_);
+        prev_ = pending_;
+    }
+    pending_ = point;
+    hasPending_ = true;
+}
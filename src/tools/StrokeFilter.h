@@ -0,0 +1,48 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 流式笔画处理：鼠标采样点 -> 连续像素点（可选 pixel-perfect 过滤）
+ *
+ * 位于鼠标输入与 Tool::apply 之间：
+ * - 相邻两次采样之间按 Bresenham 补齐像素，快速移动时笔画不断开
+ * - pixel-perfect 开启时丢弃 “L 形拐角” 像素：若 prev 与 next 对角相邻，
+ *   且中间点同时与两者正交相邻，则中间点是多余的拐角，不输出
+ *
+ * 只保存最近两个点（已输出的上一点 + 尚未确定的候选点），每次只处理新增的线段，
+ * 不会回头重算整条笔画。候选点要等下一个点到来后才能确定是否输出，
+ * 因此笔画结束时需要调用 end() 取出最后一个点。
+ */
+class StrokeFilter
+{
+public:
+    using Point = std::pair<int, int>;
+
+    // 开始新笔画；第一个点立即输出（它不可能是拐角）
+    void begin(int x, int y, bool pixelPerfect, std::vector<Point>& out);
+
+    // 鼠标移动到 (x, y)：补齐线段并把可以确定的点追加到 out
+    void moveTo(int x, int y, std::vector<Point>& out);
+
+    // 结束笔画：输出剩余的候选点
+    void end(std::vector<Point>& out);
+
+    // 是否处于笔画中
+    bool isActive() const
+    {
+        return active_;
+    }
+
+private:
+    // 经过过滤后输入一个像素点
+    void push(const Point& point, std::vector<Point>& out);
+
+    Point last_{0, 0};       // 最近一次输入的采样点（线段起点）
+    Point prev_{0, 0};       // 最近一次输出的点
+    Point pending_{0, 0};    // 等待下一个点确定去留的候选点
+    bool hasPending_ = false;
+    bool pixelPerfect_ = false;
+    bool active_ = false;
+};
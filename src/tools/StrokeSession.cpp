@@ -0,0 +1,142 @@
+#include "tools/StrokeSession.h"
+
+#include <algorithm>
+#include <utility>
+
+StrokeSession::StrokeSession(Project& project, int frameIndex, AppContext& context, std::string name)
+    : project_(project),
+      context_(context),
+      frameIndex_(frameIndex),
+      record_(std::make_unique<FramePatchCommand>(std::move(name), project.getWidth(), project.getHeight()))
+{
+}
+
+void StrokeSession::touchRect(int x0, int y0, int x1, int y1)
+{
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(getWidth() - 1, x1);
+    y1 = std::min(getHeight() - 1, y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    if (!frameTouched_)
+        record_->captureRect(project_, frameIndex_, x0, y0, x1, y1);
+    // 笔画进行中就要刷新画布，不能等到 finish
+    project_.markDirty(frameIndex_, x0, y0, x1, y1);
+
+    if (!hasDirty_)
+    {
+        dirtyX0_ = x0;
+        dirtyY0_ = y0;
+        dirtyX1_ = x1;
+        dirtyY1_ = y1;
+        hasDirty_ = true;
+        return;
+    }
+    dirtyX0_ = std::min(dirtyX0_, x0);
+    dirtyY0_ = std::min(dirtyY0_, y0);
+    dirtyX1_ = std::max(dirtyX1_, x1);
+    dirtyY1_ = std::max(dirtyY1_, y1);
+}
+
+void StrokeSession::touchWrappedRect(int x0, int y0, int x1, int y1, TiledMode mode)
+{
+    // 一个方向上的区间环绕后最多拆成两段；区间不短于画布时就是整个方向
+    struct Range
+    {
+        int lo = 0;
+        int hi = 0;
+    };
+    const auto split = [](int lo, int hi, int size, bool wraps, Range out[2]) {
+        if (!wraps)
+        {
+            out[0] = Range{lo, hi};
+            return 1;
+        }
+        if (hi - lo + 1 >= size)
+        {
+            out[0] = Range{0, size - 1};
+            return 1;
+        }
+        const int start = Tiling::wrap(lo, size);
+        const int end = start + (hi - lo);
+        if (end < size)
+        {
+            out[0] = Range{start, end};
+            return 1;
+        }
+        out[0] = Range{start, size - 1};
+        out[1] = Range{0, end - size};
+        return 2;
+    };
+
+    Range columns[2];
+    Range rows[2];
+    const int columnCount = split(x0, x1, getWidth(), Tiling::wrapsX(mode), columns);
+    const int rowCount = split(y0, y1, getHeight(), Tiling::wrapsY(mode), rows);
+    for (int r = 0; r < rowCount; ++r)
+    {
+        for (int c = 0; c < columnCount; ++c)
+            touchRect(columns[c].lo, rows[r].lo, columns[c].hi, rows[r].hi);
+    }
+}
+
+void StrokeSession::touchSpans(const std::vector<PixelSpan>& spans)
+{
+    if (spans.empty())
+        return;
+
+    // 行段已按行排序，合成一个包围盒即可（tile 粒度的记录本身也是按块的）
+    int x0 = spans.front().x0;
+    int x1 = spans.front().x1;
+    int y0 = spans.front().y;
+    int y1 = spans.front().y;
+    for (const PixelSpan& span : spans)
+    {
+        x0 = std::min(x0, span.x0);
+        x1 = std::max(x1, span.x1);
+        y0 = std::min(y0, span.y);
+        y1 = std::max(y1, span.y);
+    }
+
+    // 对称副本分散在画布各处时，包围盒会覆盖大量无关 tile，改为逐段记录
+    if (spans.size() > 1 && (x1 - x0 + 1) * (y1 - y0 + 1) > FramePatchCommand::kTileSize * FramePatchCommand::kTileSize * 4)
+    {
+        for (const PixelSpan& span : spans)
+            touchRect(span.x0, span.y, span.x1, span.y);
+        return;
+    }
+    touchRect(x0, y0, x1, y1);
+}
+
+void StrokeSession::touchFrame()
+{
+    touchRect(0, 0, getWidth() - 1, getHeight() - 1);
+    frameTouched_ = true;
+}
+
+Selection& StrokeSession::getVisitedMask()
+{
+    if (visited_.getWidth() != getWidth() || visited_.getHeight() != getHeight())
+        visited_.resize(getWidth(), getHeight());
+    return visited_;
+}
+
+bool StrokeSession::getDirtyRect(int& x0, int& y0, int& x1, int& y1) const
+{
+    if (!hasDirty_)
+        return false;
+    x0 = dirtyX0_;
+    y0 = dirtyY0_;
+    x1 = dirtyX1_;
+    y1 = dirtyY1_;
+    return true;
+}
+
+std::unique_ptr<Command> StrokeSession::finish()
+{
+    if (!record_ || !record_->finalize(project_))
+        return nullptr;
+    return std::move(record_);
+}
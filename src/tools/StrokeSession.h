@@ -0,0 +1,126 @@
+#pragma once
+
+#include "core/FramePatch.h"
+#include "core/Noise.h"
+#include "core/Project.h"
+#include "core/Selection.h"
+#include "core/Symmetry.h"
+#include "core/Tiling.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class AppContext;
+
+/**
+ * @brief 一次笔画（按下 -> 拖动 -> 松开）的会话状态
+ *
+ * 由画布在按下时创建、松开时结束，工具的 beginStroke/updateStroke/endStroke 共享同一个会话：
+ * - 撤销记录：工具写像素前调用 touch*，首次触及的 tile 会拷贝原像素；结束时整笔只产生一条撤销记录
+ * - 脏区域：本次会话中所有 touch 的并集包围盒，供画布只更新变化的部分
+ * - 临时缓冲：印章/行段等每个点都要用的容器在会话内复用，避免逐点分配
+ */
+class StrokeSession
+{
+public:
+    StrokeSession(Project& project, int frameIndex, AppContext& context, std::string name);
+
+    Project& getProject()
+    {
+        return project_;
+    }
+    Project::Frame& getFrame()
+    {
+        return project_.getFrame(frameIndex_);
+    }
+    int getFrameIndex() const
+    {
+        return frameIndex_;
+    }
+    int getWidth() const
+    {
+        return project_.getWidth();
+    }
+    int getHeight() const
+    {
+        return project_.getHeight();
+    }
+    AppContext& getContext()
+    {
+        return context_;
+    }
+
+    // 笔画起点（渐变等“拖拽定义范围”的工具在 beginStroke 中记录）
+    void setAnchor(int x, int y)
+    {
+        anchorX_ = x;
+        anchorY_ = y;
+    }
+    int getAnchorX() const
+    {
+        return anchorX_;
+    }
+    int getAnchorY() const
+    {
+        return anchorY_;
+    }
+
+    // 即将修改 [x0, x1] x [y0, y1]（闭区间，可超出画布）
+    void touchRect(int x0, int y0, int x1, int y1);
+
+    // 同 touchRect，但按平铺模式环绕：环绕方向超出画布的部分拆开移到另一侧再登记
+    void touchWrappedRect(int x0, int y0, int x1, int y1, TiledMode mode);
+
+    // 即将修改这些行段（已裁剪到画布）
+    void touchSpans(const std::vector<PixelSpan>& spans);
+
+    // 即将修改整帧（无法预知修改范围的工具使用，例如填充）
+    void touchFrame();
+
+    // 本次会话触及区域的包围盒；没有触及任何像素时返回 false
+    bool getDirtyRect(int& x0, int& y0, int& x1, int& y1) const;
+
+    // 复用的临时缓冲
+    std::vector<PixelSpan>& getStampScratch()
+    {
+        return stamp_;
+    }
+    std::vector<PixelSpan>& getSpanScratch()
+    {
+        return spans_;
+    }
+
+    // 本次笔画已处理过的像素（按需分配；供每个像素每笔只能处理一次的工具使用，如明暗笔）
+    Selection& getVisitedMask();
+
+    // 本次笔画的随机数发生器（喷枪在 beginStroke 中按种子初始化，整笔连续取数）
+    NoiseRng& getRng()
+    {
+        return rng_;
+    }
+
+    /**
+     * @brief 结束会话
+     * @return 有实际修改时返回撤销记录，否则返回 nullptr
+     */
+    std::unique_ptr<Command> finish();
+
+private:
+    Project& project_;
+    AppContext& context_;
+    int frameIndex_ = 0;
+    std::unique_ptr<FramePatchCommand> record_;
+    int anchorX_ = 0;
+    int anchorY_ = 0;
+    bool frameTouched_ = false;
+    bool hasDirty_ = false;
+    int dirtyX0_ = 0;
+    int dirtyY0_ = 0;
+    int dirtyX1_ = 0;
+    int dirtyY1_ = 0;
+    std::vector<PixelSpan> stamp_;
+    std::vector<PixelSpan> spans_;
+    Selection visited_;
+    NoiseRng rng_;
+};
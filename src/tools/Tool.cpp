@@ -0,0 +1,21 @@
+#include "tools/Tool.h"
+
+#include "tools/StrokeSession.h"
+
+void Tool::beginStroke(StrokeSession& session, int x, int y) const
+{
+    // 单点工具无法预知修改范围，按整帧记录撤销（未修改的 tile 在结束时会被丢弃）
+    session.touchFrame();
+    apply(session.getFrame(), session.getWidth(), session.getHeight(), x, y, session.getContext(), true);
+}
+
+void Tool::updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const
+{
+    for (const StrokeFilter::Point& point : points)
+        apply(session.getFrame(), session.getWidth(), session.getHeight(), point.first, point.second, session.getContext(), false);
+}
+
+void Tool::endStroke(StrokeSession& session) const
+{
+    (void)session;
+}
@@ -2,17 +2,27 @@
 
 #include "core/AppContext.h"
 #include "core/Project.h"
+#include "tools/StrokeFilter.h"
+
+#include <vector>
+
+class StrokeSession;
 
 /**
  * @brief 绘图工具统一接口。
  *
- * 各工具接收同一套输入参数：
+ * 画布以“笔画会话”驱动工具：
+ * - beginStroke：按下瞬间调用一次（x/y 为按下位置）
+ * - updateStroke：按住期间每帧调用，points 为本帧新增的像素点（已由 StrokeFilter 补齐线段/过滤）
+ * - endStroke：松开时调用
+ * 会话（StrokeSession）负责撤销记录、脏区域和临时缓冲，工具本身保持无状态。
+ *
+ * 默认实现把会话转发到单点接口 apply：
  * - frame/canvasWidth/canvasHeight：当前要修改的画布帧
  * - x/y：命中的像素坐标
  * - context：编辑器上下文（颜色、笔刷大小、当前工具等）
- * - isMouseClicked：本帧是否是“按下瞬间”，用于只触发一次的工具（如 Fill）
- *
- * @return true 表示画布像素发生了修改，需要标记项目 dirty。
+ * - isMouseClicked：是否是“按下瞬间”，用于只触发一次的工具（如 Fill）
+ * apply 返回 true 表示画布像素发生了修改。
  */
 class Tool
 {
@@ -21,6 +31,17 @@ public:
 
     virtual ToolType type() const = 0;
 
+    // 是否为按笔画连续绘制的工具（画笔、橡皮擦等），决定是否启用 pixel-perfect 过滤
+    virtual bool isFreehand() const { return false; }
+
+    // 拖到画布外（非平铺方向）时：true 表示钳制到画布边缘继续跟踪（只关心终点的工具），
+    // false 表示丢弃画布外的点（逐点绘制的工具，线段被裁剪到画布内）
+    virtual bool clampsStrokeToCanvas() const { return false; }
+
+    virtual void beginStroke(StrokeSession& session, int x, int y) const;
+    virtual void updateStroke(StrokeSession& session, const std::vector<StrokeFilter::Point>& points) const;
+    virtual void endStroke(StrokeSession& session) const;
+
     virtual bool apply(Project::Frame& frame,
                        int canvasWidth,
                        int canvasHeight,
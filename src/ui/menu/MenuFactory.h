@@ -46,8 +46,8 @@ public:
 
     // 创建 Edit 菜单（Undo/Redo 等通常依赖 AppContext）
     virtual Menu_Edit* createEditMenu(MenuManager* manager, AppContext* context) = 0;
-    // 创建 View 菜单
-    virtual Menu_View* createViewMenu(MenuManager* manager) = 0;
+    // 创建 View 菜单（对称、平铺等视图/绘制选项依赖 AppContext）
+    virtual Menu_View* createViewMenu(MenuManager* manager, AppContext* context) = 0;
     // 创建 Help 菜单
     virtual Menu_Help* createHelpMenu(MenuManager* manager) = 0;
 };
@@ -90,9 +90,9 @@ public:
         return menuEdit;
     }
 
-    Menu_View* createViewMenu(MenuManager* manager) override {
+    Menu_View* createViewMenu(MenuManager* manager, AppContext* context) override {
         Menu* viewMenu = manager->addMenu("View");
-        Menu_View* menuView = new Menu_View(viewMenu);
+        Menu_View* menuView = new Menu_View(viewMenu, context);
         menuView->initialize();
         return menuView;
     }
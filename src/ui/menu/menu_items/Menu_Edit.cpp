@@ -2,6 +2,7 @@
 #include "ui/menu/Menu.h"
 #include "ui/menu/MenuItem.h"
 #include "core/AppContext.h"
+#include "commands/EditCommands.h"
 
 Menu_Edit::Menu_Edit(Menu* menu, AppContext* context)
     : MenuOptionBase(menu), context_(context) {}
@@ -19,18 +20,30 @@ void Menu_Edit::initialize() {
     
     getMenu()->addSeparator();
     
-    getMenu()->addItem("Cut", "Ctrl+X");
-    getMenu()->addItem("Copy", "Ctrl+C");
-    getMenu()->addItem("Copy Merged", "Ctrl+Shift+C");
-    getMenu()->addItem("Paste", "Ctrl+V");
+    MenuItem* cutItem = getMenu()->addItem("Cut", "Ctrl+X");
+    cutItem->setCallback([this]() { if (context_) EditCommands::cut(*context_); });
+
+    MenuItem* copyItem = getMenu()->addItem("Copy", "Ctrl+C");
+    copyItem->setCallback([this]() { if (context_) EditCommands::copy(*context_); });
+
+    MenuItem* copyMergedItem = getMenu()->addItem("Copy Merged", "Ctrl+Shift+C");
+    copyMergedItem->setCallback([this]() { if (context_) EditCommands::copyMerged(*context_); });
+
+    MenuItem* pasteItem = getMenu()->addItem("Paste", "Ctrl+V");
+    pasteItem->setCallback([this]() { if (context_) EditCommands::paste(*context_); });
     
     // 添加 Paste Special 子菜单
     Menu* pasteSpecialMenu = new Menu("Paste Special");
+    MenuItem* pasteInPlaceItem = pasteSpecialMenu->addItem("Paste in Place");
+    pasteInPlaceItem->setCallback([this]() { if (context_) EditCommands::pasteInPlace(*context_); });
+    MenuItem* pasteNewFrameItem = pasteSpecialMenu->addItem("Paste as New Frame");
+    pasteNewFrameItem->setCallback([this]() { if (context_) EditCommands::pasteAsNewFrame(*context_); });
     getMenu()->addItem("Paste Special", pasteSpecialMenu);
     
     getMenu()->addSeparator();
     
-    getMenu()->addItem("Delete", "Del");
+    MenuItem* deleteItem = getMenu()->addItem("Delete", "Del");
+    deleteItem->setCallback([this]() { if (context_) EditCommands::deleteSelection(*context_); });
     
     getMenu()->addSeparator();
     
@@ -39,23 +52,57 @@ void Menu_Edit::initialize() {
     
     getMenu()->addSeparator();
     
-    getMenu()->addItem("Rotate");
-    getMenu()->addItem("Flip Horizontal", "Shift+H");
-    getMenu()->addItem("Flip Vertical", "Shift+V");
+    // 添加 Rotate 子菜单（无浮动选区时先抬起选区/时间线帧范围）
+    Menu* rotateMenu = new Menu("Rotate");
+    MenuItem* rotate180Item = rotateMenu->addItem("180");
+    rotate180Item->setCallback([this]() { transform(TransformOp::Rotate180); });
+    MenuItem* rotateCwItem = rotateMenu->addItem("90 CW");
+    rotateCwItem->setCallback([this]() { transform(TransformOp::Rotate90CW); });
+    MenuItem* rotateCcwItem = rotateMenu->addItem("90 CCW");
+    rotateCcwItem->setCallback([this]() { transform(TransformOp::Rotate90CCW); });
+    getMenu()->addItem("Rotate", rotateMenu);
+
+    MenuItem* flipHItem = getMenu()->addItem("Flip Horizontal", "Shift+H");
+    flipHItem->setCallback([this]() { transform(TransformOp::FlipHorizontal); });
+    MenuItem* flipVItem = getMenu()->addItem("Flip Vertical", "Shift+V");
+    flipVItem->setCallback([this]() { transform(TransformOp::FlipVertical); });
     
     // 添加 Transform 子菜单
     Menu* transformMenu = new Menu("Transform");
+    MenuItem* liftItem = transformMenu->addItem("Lift Selection");
+    liftItem->setCallback([this]() { if (context_) EditCommands::liftSelection(*context_); });
+    MenuItem* commitItem = transformMenu->addItem("Commit", "Enter");
+    commitItem->setCallback([this]() { if (context_) EditCommands::commitFloating(*context_); });
+    MenuItem* cancelItem = transformMenu->addItem("Cancel", "Esc");
+    cancelItem->setCallback([this]() { if (context_) EditCommands::cancelFloating(*context_); });
     getMenu()->addItem("Transform", transformMenu, "Ctrl+T");
     
-    // 添加 Shift 子菜单
+    // 添加 Shift 子菜单（作用于时间线帧范围内的整帧，每条命令一步撤销）
     Menu* shiftMenu = new Menu("Shift");
+    MenuItem* shiftLeftItem = shiftMenu->addItem("Left");
+    shiftLeftItem->setCallback([this]() { if (context_) EditCommands::shiftFrames(*context_, -1, 0, true); });
+    MenuItem* shiftRightItem = shiftMenu->addItem("Right");
+    shiftRightItem->setCallback([this]() { if (context_) EditCommands::shiftFrames(*context_, 1, 0, true); });
+    MenuItem* shiftUpItem = shiftMenu->addItem("Up");
+    shiftUpItem->setCallback([this]() { if (context_) EditCommands::shiftFrames(*context_, 0, -1, true); });
+    MenuItem* shiftDownItem = shiftMenu->addItem("Down");
+    shiftDownItem->setCallback([this]() { if (context_) EditCommands::shiftFrames(*context_, 0, 1, true); });
+    MenuItem* offsetItem = shiftMenu->addItem("Offset...");
+    offsetItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::ShiftFrames); });
+    shiftMenu->addSeparator();
+    MenuItem* flipFramesHItem = shiftMenu->addItem("Flip Frames Horizontal");
+    flipFramesHItem->setCallback([this]() { if (context_) EditCommands::flipFrames(*context_, true); });
+    MenuItem* flipFramesVItem = shiftMenu->addItem("Flip Frames Vertical");
+    flipFramesVItem->setCallback([this]() { if (context_) EditCommands::flipFrames(*context_, false); });
     getMenu()->addItem("Shift", shiftMenu);
     
     getMenu()->addSeparator();
     
-    getMenu()->addItem("New Brush", "Ctrl+B");
+    MenuItem* newBrushItem = getMenu()->addItem("New Brush", "Ctrl+B");
+    newBrushItem->setCallback([this]() { if (context_) EditCommands::newBrush(*context_); });
     getMenu()->addItem("New Sprite From Selection", "Ctrl+Alt+N");
-    getMenu()->addItem("Replace Color...", "Shift+R");
+    MenuItem* replaceColorItem = getMenu()->addItem("Replace Color...", "Shift+R");
+    replaceColorItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::ReplaceColor); });
     getMenu()->addItem("Invert");
     
     // 添加 Adjustments 子菜单
@@ -64,6 +111,14 @@ void Menu_Edit::initialize() {
     
     // 添加 FX 子菜单
     Menu* fxMenu = new Menu("FX");
+    MenuItem* outlineItem = fxMenu->addItem("Outline...");
+    outlineItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::Outline); });
+    MenuItem* dilateItem = fxMenu->addItem("Dilate...");
+    dilateItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::Dilate); });
+    MenuItem* erodeItem = fxMenu->addItem("Erode...");
+    erodeItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::Erode); });
+    MenuItem* shadowItem = fxMenu->addItem("Drop Shadow...");
+    shadowItem->setCallback([this]() { if (context_) context_->requestDialog(EditorDialog::DropShadow); });
     getMenu()->addItem("FX", fxMenu);
     
     getMenu()->addItem("Insert Text");
@@ -73,3 +128,10 @@ void Menu_Edit::initialize() {
     getMenu()->addItem("Keyboard Shortcuts...", "Ctrl+Alt+Shift+K");
     getMenu()->addItem("Preferences...", "Ctrl+K");
 }
+
+void Menu_Edit::transform(TransformOp op) {
+    if (!context_) return;
+    TransformStep step;
+    step.op = op;
+    EditCommands::transform(*context_, step);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MenuOptionBase.h"
+#include "core/ImageTransform.h"
 
 class AppContext;  // 前向声明
 
@@ -14,5 +15,8 @@ public:
     void setContext(AppContext* context) { context_ = context; }
 
 private:
+    // 对浮动选区（或抬起的选区）执行一次变换
+    void transform(TransformOp op);
+
     AppContext* context_ = nullptr;
 };
@@ -1,8 +1,41 @@
 #include "Menu_View.h"
+#include "ui/menu/Menu.h"
+#include "ui/menu/MenuItem.h"
+#include "core/AppContext.h"
+#include <string>
+
+namespace {
+    // 径向对称可选份数（与 foldChecks_ 一一对应）
+    const int kRadialFoldOptions[] = {2, 3, 4, 6, 8};
+}
 
 // 构造函数
-Menu_View::Menu_View(Menu* menu)
-    : MenuOptionBase(menu) {
+Menu_View::Menu_View(Menu* menu, AppContext* context)
+    : MenuOptionBase(menu), context_(context) {
+}
+
+void Menu_View::setContext(AppContext* context) {
+    context_ = context;
+    syncChecks();
+}
+
+void Menu_View::syncChecks() {
+    const SymmetryMode mode = context_ ? context_->getSymmetryMode() : SymmetryMode::None;
+    for (int i = 0; i < static_cast<int>(SymmetryMode::Count); ++i) {
+        symmetryChecks_[i] = (i == static_cast<int>(mode));
+    }
+    const TiledMode tiled = context_ ? context_->getTiledMode() : TiledMode::None;
+    for (int i = 0; i < static_cast<int>(TiledMode::Count); ++i) {
+        tiledChecks_[i] = (i == static_cast<int>(tiled));
+    }
+    const CanvasUploadMode upload = context_ ? context_->getCanvasUploadMode() : CanvasUploadMode::Direct;
+    for (int i = 0; i < static_cast<int>(CanvasUploadMode::Count); ++i) {
+        uploadChecks_[i] = (i == static_cast<int>(upload));
+    }
+    const int folds = context_ ? context_->getRadialFolds() : 0;
+    for (int i = 0; i < 5; ++i) {
+        foldChecks_[i] = (kRadialFoldOptions[i] == folds);
+    }
 }
 
 // 初始化菜单选项
@@ -18,11 +51,53 @@ void Menu_View::initialize() {
     
     getMenu()->addItem("Grid");
     
-    // 添加 Tiled Mode 子菜单
+    // 添加 Tiled Mode 子菜单（画布显示 3x3 环绕预览，绘制跨边环绕）
     Menu* tiledModeMenu = new Menu("Tiled Mode");
+    const char* tiledNames[] = {"None", "Tiled in X Axis", "Tiled in Y Axis", "Tiled in Both Axes"};
+    for (int i = 0; i < static_cast<int>(TiledMode::Count); ++i) {
+        MenuItem* item = tiledModeMenu->addItem(tiledNames[i], "", &tiledChecks_[i]);
+        item->setCallback([this, i]() {
+            if (context_) context_->setTiledMode(static_cast<TiledMode>(i));
+            syncChecks();
+        });
+    }
     getMenu()->addItem("Tiled Mode", tiledModeMenu);
+
+    // 添加 Canvas Upload 子菜单（画布纹理上传路径，耗时显示在画布标题栏）
+    Menu* uploadMenu = new Menu("Canvas Upload");
+    const char* uploadNames[] = {"Direct", "Pixel Buffer Ring"};
+    for (int i = 0; i < static_cast<int>(CanvasUploadMode::Count); ++i) {
+        MenuItem* item = uploadMenu->addItem(uploadNames[i], "", &uploadChecks_[i]);
+        item->setCallback([this, i]() {
+            if (context_) context_->setCanvasUploadMode(static_cast<CanvasUploadMode>(i));
+            syncChecks();
+        });
+    }
+    getMenu()->addItem("Canvas Upload", uploadMenu);
     
-    getMenu()->addItem("Symmetry Options");
+    // 添加 Symmetry Options 子菜单（单选：点击后按上下文重新同步勾选）
+    Menu* symmetryMenu = new Menu("Symmetry Options");
+    const char* symmetryNames[] = {"None", "Horizontal", "Vertical", "Both Axes", "Radial"};
+    for (int i = 0; i < static_cast<int>(SymmetryMode::Count); ++i) {
+        MenuItem* item = symmetryMenu->addItem(symmetryNames[i], "", &symmetryChecks_[i]);
+        item->setCallback([this, i]() {
+            if (context_) context_->setSymmetryMode(static_cast<SymmetryMode>(i));
+            syncChecks();
+        });
+    }
+    symmetryMenu->addSeparator();
+    Menu* foldsMenu = new Menu("Radial Folds");
+    for (int i = 0; i < 5; ++i) {
+        const int folds = kRadialFoldOptions[i];
+        MenuItem* item = foldsMenu->addItem(std::to_string(folds), "", &foldChecks_[i]);
+        item->setCallback([this, folds]() {
+            if (context_) context_->setRadialFolds(folds);
+            syncChecks();
+        });
+    }
+    symmetryMenu->addItem("Radial Folds", foldsMenu);
+    getMenu()->addItem("Symmetry Options", symmetryMenu);
+    syncChecks();
     
     getMenu()->addSeparator();
     
@@ -1,13 +1,31 @@
 #pragma once
 
 #include "MenuOptionBase.h"
+#include "core/AppContext.h"
+#include "core/Symmetry.h"
+#include "core/Tiling.h"
+
+class AppContext;  // 前向声明
 
 // View 菜单类
 class Menu_View : public MenuOptionBase {
 public:
     // 构造函数
-    Menu_View(Menu* menu);
+    Menu_View(Menu* menu, AppContext* context = nullptr);
     
     // 初始化菜单选项
     void initialize() override;
-};
\ No newline at end of file
+
+    // 切换活动上下文时同步勾选状态
+    void setContext(AppContext* context);
+
+private:
+    // 按当前上下文刷新对称/平铺/上传方式选项的勾选状态
+    void syncChecks();
+
+    AppContext* context_ = nullptr;
+    bool symmetryChecks_[static_cast<int>(SymmetryMode::Count)] = {};  // 各对称模式的勾选状态
+    bool foldChecks_[5] = {};                                          // 径向份数选项的勾选状态
+    bool tiledChecks_[static_cast<int>(TiledMode::Count)] = {};        // 各平铺模式的勾选状态
+    bool uploadChecks_[static_cast<int>(CanvasUploadMode::Count)] = {}; // 各画布上传方式的勾选状态
+};
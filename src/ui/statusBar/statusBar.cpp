@@ -8,14 +8,18 @@
 
 namespace
 {
-const std::array<const char*, 7> kToolNames = {
+const std::array<const char*, 11> kToolNames = {
     "Brush",
     "Eraser",
     "Eyedropper",
     "Fill",
     "Line",
     "Rect",
-    "RectFilled"
+    "RectFilled",
+    "MagicWand",
+    "Gradient",
+    "Shade",
+    "Spray"
 };
 
 const char* getToolName(const AppContext& ctx)
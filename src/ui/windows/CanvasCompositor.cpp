@@ -0,0 +1,293 @@
+#include "CanvasCompositor.h"
+
+#include "GlFunctions.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+// 四个顶点由 gl_VertexID 生成，不需要顶点缓冲
+const char* kVertexShader = R"(#version 330 core
+uniform vec4 uRect;      // 预览区域 (minX, minY, maxX, maxY)，ImGui 坐标
+uniform vec4 uDisplay;   // 视口 (DisplayPos, DisplaySize)
+uniform vec2 uImageMin;  // 实际画布左上角
+out vec2 vScreen;        // 相对实际画布左上角的屏幕偏移
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec2 pos = mix(uRect.xy, uRect.zw, corner);
+    vScreen = pos - uImageMin;
+    vec2 ndc = (pos - uDisplay.xy) / uDisplay.zw * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+}
+)";
+
+const char* kFragmentShader = R"(#version 330 core
+uniform sampler2D uFrame;
+uniform sampler2DArray uLayers;   // 全部帧的纹理数组（洋葱皮直接取邻帧）
+uniform sampler2D uOnion;         // CPU 合成的洋葱皮
+uniform int uOnionMode;           // 0 无，1 从纹理数组取邻帧，2 取 CPU 合成结果
+uniform int uOnionCount;
+uniform int uOnionLayer[8];       // 由远到近
+uniform vec4 uOnionTint[8];       // rgb 色调，a 不透明度
+uniform sampler2D uMip;           // 带 mip 链的当前帧（缩小显示，预乘 alpha）
+uniform float uMipLod;            // < 0 表示不用 mip，按纹素直接取
+uniform ivec2 uOrigin;      // 帧在纹理中的像素偏移（图集格子）
+uniform ivec2 uCanvasSize;
+uniform float uZoom;
+uniform int uChecker;
+uniform int uGrid;
+in vec2 vScreen;
+out vec4 outColor;
+
+const float kCheckerCell = 8.0;                 // 棋盘格边长（屏幕像素）
+const vec3 kCheckerDark = vec3(70.0 / 255.0);
+const vec3 kCheckerLight = vec3(90.0 / 255.0);
+const float kWrapShade = 60.0 / 255.0;          // 平铺副本压暗比例
+const vec4 kGridColor = vec4(vec3(80.0 / 255.0), 120.0 / 255.0);
+const float kTintStrength = 0.6;                // 与 OnionSkin::kTintStrength 一致
+
+void main()
+{
+    vec2 local = vScreen / uZoom;
+    ivec2 pixel = ivec2(floor(local));
+    ivec2 tile = ivec2(floor(vec2(pixel) / vec2(uCanvasSize)));
+    ivec2 wrapped = pixel - tile * uCanvasSize;
+    // 当前帧统一换成预乘 alpha：mip 链本身按预乘存储，插值不会把透明纹素的颜色混进边缘
+    vec4 texel;
+    if (uMipLod >= 0.0)
+    {
+        texel = textureLod(uMip, (local - vec2(tile * uCanvasSize)) / vec2(uCanvasSize), uMipLod);
+    }
+    else
+    {
+        texel = texelFetch(uFrame, uOrigin + wrapped, 0);
+        texel.rgb *= texel.a;
+    }
+
+    vec3 background = vec3(1.0);
+    if (uChecker != 0)
+    {
+        ivec2 cell = ivec2(floor(vScreen / kCheckerCell));
+        background = ((cell.x + cell.y) & 1) == 0 ? kCheckerDark : kCheckerLight;
+    }
+    vec3 color = background;
+
+    // 洋葱皮在当前帧下方；背景不透明，所以逐层 over 与先合成再叠加结果相同
+    if (uOnionMode == 1)
+    {
+        for (int i = 0; i < uOnionCount; ++i)
+        {
+            vec4 neighbor = texelFetch(uLayers, ivec3(wrapped, uOnionLayer[i]), 0);
+            vec3 tinted = mix(neighbor.rgb, uOnionTint[i].rgb, kTintStrength);
+            color = mix(color, tinted, neighbor.a * uOnionTint[i].a);
+        }
+    }
+    else if (uOnionMode == 2)
+    {
+        vec4 onion = texelFetch(uOnion, wrapped, 0);
+        color = mix(color, onion.rgb, onion.a);
+    }
+    color = color * (1.0 - texel.a) + texel.rgb;
+
+    bool center = tile == ivec2(0);
+    if (!center)
+        color *= 1.0 - kWrapShade;
+
+    // 网格线画在像素左/上边缘，画布外框不画（与原先逐条 AddLine 一致）
+    if (uGrid != 0 && center)
+    {
+        vec2 inPixel = vScreen - vec2(pixel) * uZoom;
+        if ((inPixel.x < 1.0 && pixel.x > 0) || (inPixel.y < 1.0 && pixel.y > 0))
+            color = mix(color, kGridColor.rgb, kGridColor.a);
+    }
+    outColor = vec4(color, 1.0);
+}
+)";
+
+unsigned int compileShader(unsigned int type, const char* source)
+{
+    const GlFunctions& gl = glFunctions();
+    const GLuint shader = gl.createShader(type);
+    gl.shaderSource(shader, 1, &source, nullptr);
+    gl.compileShader(shader);
+    GLint ok = 0;
+    gl.getShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok)
+    {
+        char log[1024] = {};
+        gl.getShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::fprintf(stderr, "CanvasCompositor: shader compile failed: %s\n", log);
+        gl.deleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// 找到 drawList 所属视口的绘制数据（多视口时每个平台窗口各有一份）
+const ImDrawData* findDrawData(const ImDrawList* drawList)
+{
+    for (ImGuiViewport* viewport : ImGui::GetPlatformIO().Viewports)
+    {
+        const ImDrawData* drawData = viewport->DrawData;
+        if (!drawData)
+            continue;
+        for (const ImDrawList* list : drawData->CmdLists)
+        {
+            if (list == drawList)
+                return drawData;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+CanvasCompositor::~CanvasCompositor()
+{
+    if (!built_)
+        return;
+    const GlFunctions& gl = glFunctions();
+    if (program_ != 0)
+        gl.deleteProgram(program_);
+    if (vertexArray_ != 0)
+        gl.deleteVertexArrays(1, &vertexArray_);
+}
+
+bool CanvasCompositor::isAvailable()
+{
+    if (!built_)
+    {
+        built_ = true;
+        available_ = glFunctions().hasShaders && build();
+    }
+    return available_;
+}
+
+bool CanvasCompositor::build()
+{
+    const GlFunctions& gl = glFunctions();
+    const GLuint vertex = compileShader(GL_VERTEX_SHADER, kVertexShader);
+    const GLuint fragment = compileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+    if (vertex == 0 || fragment == 0)
+    {
+        if (vertex != 0)
+            gl.deleteShader(vertex);
+        if (fragment != 0)
+            gl.deleteShader(fragment);
+        return false;
+    }
+
+    program_ = gl.createProgram();
+    gl.attachShader(program_, vertex);
+    gl.attachShader(program_, fragment);
+    gl.linkProgram(program_);
+    gl.deleteShader(vertex);
+    gl.deleteShader(fragment);
+    GLint ok = 0;
+    gl.getProgramiv(program_, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        char log[1024] = {};
+        gl.getProgramInfoLog(program_, sizeof(log), nullptr, log);
+        std::fprintf(stderr, "CanvasCompositor: program link failed: %s\n", log);
+        gl.deleteProgram(program_);
+        program_ = 0;
+        return false;
+    }
+
+    rectLocation_ = gl.getUniformLocation(program_, "uRect");
+    displayLocation_ = gl.getUniformLocation(program_, "uDisplay");
+    imageMinLocation_ = gl.getUniformLocation(program_, "uImageMin");
+    zoomLocation_ = gl.getUniformLocation(program_, "uZoom");
+    canvasSizeLocation_ = gl.getUniformLocation(program_, "uCanvasSize");
+    originLocation_ = gl.getUniformLocation(program_, "uOrigin");
+    checkerLocation_ = gl.getUniformLocation(program_, "uChecker");
+    gridLocation_ = gl.getUniformLocation(program_, "uGrid");
+    frameLocation_ = gl.getUniformLocation(program_, "uFrame");
+    layersLocation_ = gl.getUniformLocation(program_, "uLayers");
+    onionLocation_ = gl.getUniformLocation(program_, "uOnion");
+    onionModeLocation_ = gl.getUniformLocation(program_, "uOnionMode");
+    onionCountLocation_ = gl.getUniformLocation(program_, "uOnionCount");
+    onionLayerLocation_ = gl.getUniformLocation(program_, "uOnionLayer");
+    onionTintLocation_ = gl.getUniformLocation(program_, "uOnionTint");
+    mipLocation_ = gl.getUniformLocation(program_, "uMip");
+    mipLodLocation_ = gl.getUniformLocation(program_, "uMipLod");
+
+    // core profile 绘制必须绑定 VAO（即使不读取任何顶点属性）
+    gl.genVertexArrays(1, &vertexArray_);
+    return true;
+}
+
+void CanvasCompositor::draw(ImDrawList* drawList, const Params& params)
+{
+    params_ = params;
+    drawList->AddCallback(&CanvasCompositor::renderCallback, this);
+    // 让后端恢复自己的着色器、VAO 与纹理绑定
+    drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void CanvasCompositor::renderCallback(const ImDrawList* drawList, const ImDrawCmd* command)
+{
+    static_cast<const CanvasCompositor*>(command->UserCallbackData)->render(drawList, command);
+}
+
+void CanvasCompositor::render(const ImDrawList* drawList, const ImDrawCmd* command) const
+{
+    const ImDrawData* drawData = findDrawData(drawList);
+    if (!drawData)
+        return;
+
+    // 后端只为普通绘制命令设置裁剪矩形，回调需要自己设置（OpenGL 的 y 轴向上）
+    const ImVec2 scale = drawData->FramebufferScale;
+    const ImVec2 offset = drawData->DisplayPos;
+    const float framebufferHeight = drawData->DisplaySize.y * scale.y;
+    const ImVec2 clipMin((command->ClipRect.x - offset.x) * scale.x, (command->ClipRect.y - offset.y) * scale.y);
+    const ImVec2 clipMax((command->ClipRect.z - offset.x) * scale.x, (command->ClipRect.w - offset.y) * scale.y);
+    if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+        return;
+    glScissor(static_cast<GLint>(clipMin.x),
+              static_cast<GLint>(framebufferHeight - clipMax.y),
+              static_cast<GLsizei>(clipMax.x - clipMin.x),
+              static_cast<GLsizei>(clipMax.y - clipMin.y));
+
+    const Params& p = params_;
+    const float imageW = static_cast<float>(p.width) * p.zoom;
+    const float imageH = static_cast<float>(p.height) * p.zoom;
+    const GlFunctions& gl = glFunctions();
+    gl.useProgram(program_);
+    gl.uniform4f(rectLocation_,
+                 p.imageMin.x - static_cast<float>(p.tilesX) * imageW,
+                 p.imageMin.y - static_cast<float>(p.tilesY) * imageH,
+                 p.imageMin.x + static_cast<float>(1 + p.tilesX) * imageW,
+                 p.imageMin.y + static_cast<float>(1 + p.tilesY) * imageH);
+    gl.uniform4f(displayLocation_, offset.x, offset.y, drawData->DisplaySize.x, drawData->DisplaySize.y);
+    gl.uniform2f(imageMinLocation_, p.imageMin.x, p.imageMin.y);
+    gl.uniform1f(zoomLocation_, p.zoom);
+    gl.uniform2i(canvasSizeLocation_, p.width, p.height);
+    gl.uniform2i(originLocation_, p.frame.x, p.frame.y);
+    gl.uniform1i(checkerLocation_, p.checkerboard ? 1 : 0);
+    gl.uniform1i(gridLocation_, p.grid ? 1 : 0);
+    // 不同类型的采样器必须用不同的纹理单元（即使本次不读取）
+    gl.uniform1i(frameLocation_, 0);
+    gl.uniform1i(layersLocation_, 1);
+    gl.uniform1i(onionLocation_, 2);
+    gl.uniform1i(mipLocation_, 3);
+    gl.uniform1f(mipLodLocation_, p.mipTexture != 0 ? p.mipLod : -1.0f);
+    const int onionMode = p.layerTexture != 0 && p.onionCount > 0 ? 1 : (p.onionTexture != 0 ? 2 : 0);
+    gl.uniform1i(onionModeLocation_, onionMode);
+    gl.uniform1i(onionCountLocation_, onionMode == 1 ? p.onionCount : 0);
+    gl.uniform1iv(onionLayerLocation_, kMaxOnionLayers, p.onionLayers);
+    gl.uniform4fv(onionTintLocation_, kMaxOnionLayers, &p.onionTints[0][0]);
+
+    gl.activeTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, onionMode == 1 ? p.layerTexture : 0);
+    gl.activeTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, onionMode == 2 ? p.onionTexture : 0);
+    gl.activeTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, p.mipTexture);
+    gl.activeTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, p.frame.texture);
+    gl.bindVertexArray(vertexArray_);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
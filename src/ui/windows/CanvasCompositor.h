@@ -0,0 +1,92 @@
+#pragma once
+
+#include "FrameTextureCache.h"
+#include "core/OnionSkin.h"
+#include "imgui.h"
+
+/**
+ * @brief 用着色器一次绘制画布底图
+ *
+ * 原先的棋盘格、帧图像、平铺副本压暗和像素网格都是 ImDrawList 图元，网格每个 UI 帧要
+ * width + height 条线。这里改为通过 ImDrawList::AddCallback 插入一次自定义绘制：
+ * 一个覆盖预览区域的四边形，片元着色器逐像素算出棋盘格、叠加洋葱皮、取帧纹素（平铺副本取模环绕）、
+ * 压暗副本并叠加网格。draw list 中只多两条命令，与画布尺寸无关。
+ *
+ * 洋葱皮两种来源：帧纹理常驻在纹理数组中时，着色器直接按层取邻帧并着色（一次绘制完成）；
+ * 否则使用 CPU 合成好的洋葱皮纹理。缩放小于 1 倍时当前帧从带 mip 链的纹理采样，避免锯齿与闪烁。
+ *
+ * 着色器入口不可用或编译失败时 isAvailable() 返回 false，调用方继续使用图元绘制。
+ * 回调在 ImGui 渲染阶段执行，所以参数在 draw 时拷贝保存，直到下一次 draw。
+ */
+class CanvasCompositor
+{
+public:
+    static constexpr int kMaxOnionLayers = OnionSkinSettings::kMaxFrames * 2;
+
+    struct Params
+    {
+        FrameTextureCache::View frame;   // 当前帧纹理（只用 texture 与像素偏移）
+        ImVec2 imageMin;                 // 实际画布左上角（屏幕坐标）
+        float zoom = 1.0f;               // 每个画布像素的屏幕尺寸
+        int width = 0;                   // 画布尺寸（像素）
+        int height = 0;
+        int tilesX = 0;                  // 两侧各显示几份平铺副本（0 或 1）
+        int tilesY = 0;
+        bool checkerboard = true;        // false 时背景为纯白
+        bool grid = false;               // 是否叠加像素网格（只画在实际画布上）
+
+        // 洋葱皮：layerTexture 非 0 时从纹理数组取 onionCount 层（由远到近）；
+        // 否则 onionTexture 非 0 时取 CPU 合成结果
+        unsigned int layerTexture = 0;
+        int onionCount = 0;
+        int onionLayers[kMaxOnionLayers] = {};
+        float onionTints[kMaxOnionLayers][4] = {};   // RGB 色调 + 不透明度，均为 0~1
+        unsigned int onionTexture = 0;
+
+        // 缩小显示：mipTexture 非 0 时当前帧改为按 mipLod 层级三线性采样（带 mip 链、预乘 alpha 的 2D 纹理）
+        unsigned int mipTexture = 0;
+        float mipLod = 0.0f;
+    };
+
+    CanvasCompositor() = default;
+    ~CanvasCompositor();
+
+    CanvasCompositor(const CanvasCompositor&) = delete;
+    CanvasCompositor& operator=(const CanvasCompositor&) = delete;
+
+    // 第一次调用时编译着色器（需要当前线程持有 OpenGL 上下文）
+    bool isAvailable();
+
+    // 把画布底图的绘制命令加入 drawList
+    void draw(ImDrawList* drawList, const Params& params);
+
+private:
+    static void renderCallback(const ImDrawList* drawList, const ImDrawCmd* command);
+    void render(const ImDrawList* drawList, const ImDrawCmd* command) const;
+    bool build();
+
+    Params params_;
+    unsigned int program_ = 0;
+    unsigned int vertexArray_ = 0;
+    bool built_ = false;
+    bool available_ = false;
+
+    // uniform 位置
+    int rectLocation_ = -1;
+    int displayLocation_ = -1;
+    int imageMinLocation_ = -1;
+    int zoomLocation_ = -1;
+    int canvasSizeLocation_ = -1;
+    int originLocation_ = -1;
+    int checkerLocation_ = -1;
+    int gridLocation_ = -1;
+    int frameLocation_ = -1;
+    int layersLocation_ = -1;
+    int onionLocation_ = -1;
+    int onionModeLocation_ = -1;
+    int onionCountLocation_ = -1;
+    int onionLayerLocation_ = -1;
+    int onionTintLocation_ = -1;
+    int mipLocation_ = -1;
+    int mipLodLocation_ = -1;
+};
@@ -0,0 +1,313 @@
+#include "FrameTextureCache.h"
+
+#include "GlFunctions.h"
+
+#include <algorithm>
+
+namespace
+{
+// 帧数增长时多预留约 1/4 的层数（按 8 帧一档取整），避免每插入几帧就重建全部纹理
+constexpr int kCapacityStep = 8;
+
+void setSamplerParameters(GLenum target)
+{
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+} // namespace
+
+FrameTextureCache::~FrameTextureCache()
+{
+    release();
+}
+
+void FrameTextureCache::release()
+{
+    for (Slot& slot : slots_)
+    {
+        if (slot.view != 0)
+            glDeleteTextures(1, &slot.view);
+    }
+    slots_.clear();
+    freeSlots_.clear();
+    layers_.clear();
+    frameLayers_.clear();
+    if (texture_ != 0)
+    {
+        glDeleteTextures(1, &texture_);
+        texture_ = 0;
+    }
+    storage_ = Storage::None;
+    width_ = 0;
+    height_ = 0;
+    capacity_ = 0;
+    syncedRevision_ = 0;
+    syncedFrameListRevision_ = 0;
+    pending_ = false;
+}
+
+bool FrameTextureCache::sync(const Project& project, int currentFrame, TextureUploader& uploader, CanvasUploadMode mode)
+{
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    const int frameCount = project.getFrameCount();
+    if (width != width_ || height != height_ || frameCount > capacity_)
+    {
+        if (width == rejectedWidth_ && height == rejectedHeight_ && frameCount == rejectedFrameCount_)
+            return false;
+        if (!allocate(width, height, frameCount))
+        {
+            rejectedWidth_ = width;
+            rejectedHeight_ = height;
+            rejectedFrameCount_ = frameCount;
+            return false;
+        }
+    }
+
+    if (project.getFrameListRevision() != syncedFrameListRevision_)
+        remap(project);
+
+    // 当前帧不受预算限制，保证显示的总是最新内容
+    size_t unlimited = static_cast<size_t>(-1);
+    if (currentFrame >= 0 && currentFrame < frameCount)
+        uploadFrame(project, currentFrame, uploader, mode, unlimited);
+
+    if (project.getRevision() == syncedRevision_ && !pending_)
+        return true;
+
+    size_t budget = kUploadBudgetBytes;
+    pending_ = false;
+    for (int i = 0; i < frameCount; ++i)
+    {
+        if (!uploadFrame(project, i, uploader, mode, budget))
+            pending_ = true;
+    }
+    syncedRevision_ = project.getRevision();
+    return true;
+}
+
+/**
+ * @brief 帧列表变化后重建 帧下标 -> 层 的对应
+ *
+ * 仍在项目中的帧保留原来的层（内容不用重传）；已删除帧的层回收，分给新帧。
+ * 容量不小于帧数，所以空闲层总是够用。
+ */
+void FrameTextureCache::remap(const Project& project)
+{
+    const int frameCount = project.getFrameCount();
+    std::unordered_map<uint64_t, int> layers;
+    layers.reserve(static_cast<size_t>(frameCount));
+    frameLayers_.assign(static_cast<size_t>(frameCount), -1);
+    for (int i = 0; i < frameCount; ++i)
+    {
+        const uint64_t id = project.getFrame(i).id;
+        const auto it = layers_.find(id);
+        if (it == layers_.end())
+            continue;
+        frameLayers_[static_cast<size_t>(i)] = it->second;
+        layers.emplace(id, it->second);
+        layers_.erase(it);
+    }
+
+    // 剩下的是已删除帧
+    for (const auto& item : layers_)
+    {
+        Slot& slot = slots_[static_cast<size_t>(item.second)];
+        slot.frameId = 0;
+        slot.generation = 0;
+        freeSlots_.push_back(item.second);
+    }
+
+    for (int i = 0; i < frameCount; ++i)
+    {
+        if (frameLayers_[static_cast<size_t>(i)] >= 0)
+            continue;
+        const int layer = freeSlots_.back();
+        freeSlots_.pop_back();
+        Slot& slot = slots_[static_cast<size_t>(layer)];
+        slot.frameId = project.getFrame(i).id;
+        slot.generation = 0;
+        frameLayers_[static_cast<size_t>(i)] = layer;
+        layers.emplace(slot.frameId, layer);
+    }
+    layers_.swap(layers);
+    syncedFrameListRevision_ = project.getFrameListRevision();
+}
+
+/**
+ * @brief 把一帧同步到它的层
+ *
+ * 已上传过的帧只上传版本号更新过的脏块，没上传过的整帧上传。
+ * budget 用完时返回 false（留到下一个 UI 帧）；最后一次上传允许超出预算，保证每个 UI 帧都有进展。
+ */
+bool FrameTextureCache::uploadFrame(const Project& project,
+                                    int frameIndex,
+                                    TextureUploader& uploader,
+                                    CanvasUploadMode mode,
+                                    size_t& budget)
+{
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    const int layer = frameLayers_[static_cast<size_t>(frameIndex)];
+    Slot& slot = slots_[static_cast<size_t>(layer)];
+    if (slot.generation == frame.generation)
+        return true;
+    if (budget == 0)
+        return false;
+
+    const size_t framePixels = static_cast<size_t>(width_) * static_cast<size_t>(height_);
+    size_t dirtyPixels = framePixels;
+    dirtyRects_.clear();
+    if (slot.generation != 0)
+        dirtyPixels = project.collectDirtyRects(frameIndex, slot.generation, dirtyRects_);
+    budget -= std::min(budget, dirtyPixels * sizeof(uint32_t));
+    if (dirtyPixels * 2 >= framePixels || dirtyRects_.size() > 64)
+        dirtyRects_.clear();
+    uploader.upload(getTarget(layer), frame.pixels.data(), width_, height_, dirtyRects_, mode);
+    slot.generation = frame.generation;
+    return true;
+}
+
+FrameTextureCache::View FrameTextureCache::getView(int frameIndex) const
+{
+    const int layer = frameLayers_[static_cast<size_t>(frameIndex)];
+    View view;
+    if (storage_ == Storage::TextureArray)
+    {
+        view.texture = slots_[static_cast<size_t>(layer)].view;
+        return view;
+    }
+
+    const float atlasW = static_cast<float>(atlasColumns_ * width_);
+    const float atlasH = static_cast<float>(atlasRows_ * height_);
+    const TextureUploader::Target target = getTarget(layer);
+    view.texture = texture_;
+    view.x = target.offsetX;
+    view.y = target.offsetY;
+    view.u0 = static_cast<float>(target.offsetX) / atlasW;
+    view.v0 = static_cast<float>(target.offsetY) / atlasH;
+    view.u1 = static_cast<float>(target.offsetX + width_) / atlasW;
+    view.v1 = static_cast<float>(target.offsetY + height_) / atlasH;
+    return view;
+}
+
+int FrameTextureCache::getLayer(int frameIndex) const
+{
+    if (frameIndex < 0 || frameIndex >= static_cast<int>(frameLayers_.size()))
+        return -1;
+    const int layer = frameLayers_[static_cast<size_t>(frameIndex)];
+    return slots_[static_cast<size_t>(layer)].generation != 0 ? layer : -1;
+}
+
+TextureUploader::Target FrameTextureCache::getTarget(int slot) const
+{
+    TextureUploader::Target target;
+    target.texture = texture_;
+    if (storage_ == Storage::TextureArray)
+    {
+        target.layer = slot;
+        return target;
+    }
+    target.offsetX = (slot % atlasColumns_) * width_;
+    target.offsetY = (slot / atlasColumns_) * height_;
+    return target;
+}
+
+bool FrameTextureCache::allocate(int width, int height, int frameCount)
+{
+    release();
+
+    const size_t frameBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * sizeof(uint32_t);
+    const int maxFrames = static_cast<int>(std::min<size_t>(kMaxResidentBytes / frameBytes, 1u << 16));
+    if (frameCount > maxFrames)
+        return false;
+
+    width_ = width;
+    height_ = height;
+    const int wanted = frameCount + frameCount / 4;
+    const int capacity = std::min(maxFrames, (wanted + kCapacityStep - 1) / kCapacityStep * kCapacityStep);
+    const bool allocated = (glFunctions().hasTextureArray && allocateArray(capacity)) || allocateAtlas(capacity);
+    if (!allocated)
+    {
+        release();
+        return false;
+    }
+    capacity_ = capacity;
+    // 空闲层从 0 开始分配
+    for (int layer = capacity - 1; layer >= 0; --layer)
+        freeSlots_.push_back(layer);
+    return true;
+}
+
+bool FrameTextureCache::allocateArray(int capacity)
+{
+    GLint maxSize = 0;
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (width_ > maxSize || height_ > maxSize || capacity > maxLayers)
+        return false;
+
+    const GlFunctions& gl = glFunctions();
+    // 清掉之前残留的错误，下面据此判断分配是否成功
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_);
+    setSamplerParameters(GL_TEXTURE_2D_ARRAY);
+    // 纹理视图要求不可变存储
+    gl.texStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, width_, height_, capacity);
+
+    slots_.resize(static_cast<size_t>(capacity));
+    for (int layer = 0; layer < capacity; ++layer)
+    {
+        Slot& slot = slots_[static_cast<size_t>(layer)];
+        glGenTextures(1, &slot.view);
+        gl.textureView(slot.view, GL_TEXTURE_2D, texture_, GL_RGBA8, 0, 1, static_cast<GLuint>(layer), 1);
+        glBindTexture(GL_TEXTURE_2D, slot.view);
+        setSamplerParameters(GL_TEXTURE_2D);
+    }
+    if (glGetError() != GL_NO_ERROR)
+    {
+        // 交给图集重试前先删掉半成品
+        for (Slot& slot : slots_)
+            glDeleteTextures(1, &slot.view);
+        slots_.clear();
+        glDeleteTextures(1, &texture_);
+        texture_ = 0;
+        return false;
+    }
+
+    storage_ = Storage::TextureArray;
+    return true;
+}
+
+bool FrameTextureCache::allocateAtlas(int capacity)
+{
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    const int columns = std::min(capacity, maxSize / width_);
+    if (columns <= 0)
+        return false;
+    const int rows = (capacity + columns - 1) / columns;
+    if (rows * height_ > maxSize)
+        return false;
+
+    atlasColumns_ = columns;
+    atlasRows_ = rows;
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    setSamplerParameters(GL_TEXTURE_2D);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, columns * width_, rows * height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    if (glGetError() != GL_NO_ERROR)
+        return false;
+
+    slots_.resize(static_cast<size_t>(capacity));
+    storage_ = Storage::Atlas;
+    return true;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "TextureUploader.h"
+#include "core/AppContext.h"
+#include "core/Project.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 常驻显存的全部帧纹理
+ *
+ * 项目的每一帧占纹理数组的一层（GL_TEXTURE_2D_ARRAY）；每层另建一个 2D 纹理视图
+ * （glTextureView，与数组共享存储），ImGui 可以直接绘制。纹理数组/视图不可用时，
+ * 退回把所有帧排成网格的一张图集纹理，显示时用纹理坐标选出对应的格子。
+ *
+ * 层按帧编号分配（帧编号 -> 层），插入/删除帧只是重新对应，已上传的层原样保留。
+ * 每个 UI 帧调用 sync：项目版本号没变时只检查当前帧；变了才逐帧比较已上传的版本号，
+ * 只上传变化帧的脏区域，所以播放/切帧只是换一层显示，不产生任何上传。
+ * 当前帧总是立即同步；其余帧（首次加载、扩容重建后）每个 UI 帧最多上传约
+ * kUploadBudgetBytes，分摊到之后的若干 UI 帧完成。
+ * 总显存超过 kMaxResidentBytes（或超出纹理尺寸/层数上限）时 sync 返回 false，
+ * 调用方改用单张画布纹理按需上传。
+ */
+class FrameTextureCache
+{
+public:
+    static constexpr size_t kMaxResidentBytes = static_cast<size_t>(256) << 20;
+    static constexpr size_t kUploadBudgetBytes = static_cast<size_t>(16) << 20;
+
+    enum class Storage : int
+    {
+        None = 0,       // 未分配（项目放不下时调用方改走单纹理上传）
+        TextureArray,   // 纹理数组 + 每层一个 2D 视图
+        Atlas           // 单张图集纹理
+    };
+
+    // 一帧在显存中的位置：ImGui 用 texture 与 [uv0, uv1] 绘制，着色器按像素偏移 (x, y) 直接取纹素
+    struct View
+    {
+        unsigned int texture = 0;
+        int x = 0;
+        int y = 0;
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 1.0f;
+        float v1 = 1.0f;
+    };
+
+    FrameTextureCache() = default;
+    ~FrameTextureCache();
+
+    FrameTextureCache(const FrameTextureCache&) = delete;
+    FrameTextureCache& operator=(const FrameTextureCache&) = delete;
+
+    /**
+     * @brief 把项目的帧同步到显存
+     * @param currentFrame 正在显示的帧（不受上传预算限制）
+     * @return false 表示项目放不下，未常驻
+     */
+    bool sync(const Project& project, int currentFrame, TextureUploader& uploader, CanvasUploadMode mode);
+
+    // 调用前须 sync 成功；frameIndex 须为 sync 时的当前帧（其余帧可能还没上传，先用 getLayer 判断）
+    View getView(int frameIndex) const;
+
+    // 帧所在的层/格子；该帧还没有上传过时返回 -1
+    int getLayer(int frameIndex) const;
+
+    Storage getStorage() const
+    {
+        return storage_;
+    }
+
+    // 纹理数组或图集纹理本身（着色器按层/格子采样时使用）
+    unsigned int getTexture() const
+    {
+        return texture_;
+    }
+
+    // 释放全部纹理
+    void release();
+
+private:
+    struct Slot
+    {
+        uint64_t frameId = 0;      // 已上传内容所属帧的编号（0 表示无效）
+        uint64_t generation = 0;   // 已上传内容对应的帧版本号
+        unsigned int view = 0;     // 纹理数组模式下该层的 2D 视图
+    };
+
+    bool allocate(int width, int height, int frameCount);
+    bool allocateArray(int capacity);
+    bool allocateAtlas(int capacity);
+    void remap(const Project& project);
+    bool uploadFrame(const Project& project, int frameIndex, TextureUploader& uploader, CanvasUploadMode mode, size_t& budget);
+    TextureUploader::Target getTarget(int slot) const;
+
+    Storage storage_ = Storage::None;
+    unsigned int texture_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    int capacity_ = 0;       // 可容纳的帧数
+    int atlasColumns_ = 0;   // 图集每行的帧数
+    int atlasRows_ = 0;
+    std::vector<Slot> slots_;
+    std::vector<int> freeSlots_;
+    std::unordered_map<uint64_t, int> layers_;   // 帧编号 -> 层
+    std::vector<int> frameLayers_;               // 帧下标 -> 层（帧列表变化时重建）
+    std::vector<Project::DirtyRect> dirtyRects_;
+
+    uint64_t syncedRevision_ = 0;            // 上次完整同步时的项目版本号
+    uint64_t syncedFrameListRevision_ = 0;   // frameLayers_ 对应的帧列表版本号
+    bool pending_ = false;                   // 还有因预算推迟的上传
+
+    // 上次分配失败时的尺寸与帧数：条件不变就不再每个 UI 帧重试
+    int rejectedWidth_ = 0;
+    int rejectedHeight_ = 0;
+    int rejectedFrameCount_ = 0;
+};
@@ -0,0 +1,59 @@
+#include "GlFunctions.h"
+
+#include <SDL3/SDL.h>
+
+namespace
+{
+template <typename Fn>
+bool loadFunction(Fn& out, const char* name)
+{
+    out = reinterpret_cast<Fn>(SDL_GL_GetProcAddress(name));
+    return out != nullptr;
+}
+} // namespace
+
+const GlFunctions& glFunctions()
+{
+    static GlFunctions functions;
+    static bool loaded = false;
+    if (!loaded)
+    {
+        loaded = true;
+        functions.hasBuffers = loadFunction(functions.genBuffers, "glGenBuffers")
+            && loadFunction(functions.deleteBuffers, "glDeleteBuffers")
+            && loadFunction(functions.bindBuffer, "glBindBuffer")
+            && loadFunction(functions.bufferData, "glBufferData")
+            && loadFunction(functions.mapBufferRange, "glMapBufferRange")
+            && loadFunction(functions.unmapBuffer, "glUnmapBuffer");
+        functions.hasTextureArray = loadFunction(functions.texStorage3D, "glTexStorage3D")
+            && loadFunction(functions.texSubImage3D, "glTexSubImage3D")
+            && loadFunction(functions.textureView, "glTextureView");
+        functions.hasCopyImage = loadFunction(functions.copyImageSubData, "glCopyImageSubData");
+        functions.hasShaders = loadFunction(functions.createShader, "glCreateShader")
+            && loadFunction(functions.shaderSource, "glShaderSource")
+            && loadFunction(functions.compileShader, "glCompileShader")
+            && loadFunction(functions.getShaderiv, "glGetShaderiv")
+            && loadFunction(functions.getShaderInfoLog, "glGetShaderInfoLog")
+            && loadFunction(functions.deleteShader, "glDeleteShader")
+            && loadFunction(functions.createProgram, "glCreateProgram")
+            && loadFunction(functions.attachShader, "glAttachShader")
+            && loadFunction(functions.linkProgram, "glLinkProgram")
+            && loadFunction(functions.getProgramiv, "glGetProgramiv")
+            && loadFunction(functions.getProgramInfoLog, "glGetProgramInfoLog")
+            && loadFunction(functions.deleteProgram, "glDeleteProgram")
+            && loadFunction(functions.useProgram, "glUseProgram")
+            && loadFunction(functions.getUniformLocation, "glGetUniformLocation")
+            && loadFunction(functions.uniform1i, "glUniform1i")
+            && loadFunction(functions.uniform1f, "glUniform1f")
+            && loadFunction(functions.uniform2i, "glUniform2i")
+            && loadFunction(functions.uniform2f, "glUniform2f")
+            && loadFunction(functions.uniform4f, "glUniform4f")
+            && loadFunction(functions.uniform1iv, "glUniform1iv")
+            && loadFunction(functions.uniform4fv, "glUniform4fv")
+            && loadFunction(functions.genVertexArrays, "glGenVertexArrays")
+            && loadFunction(functions.bindVertexArray, "glBindVertexArray")
+            && loadFunction(functions.deleteVertexArrays, "glDeleteVertexArrays")
+            && loadFunction(functions.activeTexture, "glActiveTexture");
+    }
+    return functions;
+}
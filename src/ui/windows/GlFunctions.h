@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL3/SDL_opengl.h>
+
+/**
+ * @brief 运行时加载的 OpenGL 入口
+ *
+ * Windows 的 opengl32 只导出 1.1 函数，缓冲对象、纹理数组等入口需要通过
+ * SDL_GL_GetProcAddress 加载。第一次调用 glFunctions() 时加载（需要当前线程持有上下文），
+ * 各功能组按是否全部加载成功分别标记可用。
+ */
+struct GlFunctions
+{
+    // 像素缓冲对象（PBO）
+    PFNGLGENBUFFERSPROC genBuffers = nullptr;
+    PFNGLDELETEBUFFERSPROC deleteBuffers = nullptr;
+    PFNGLBINDBUFFERPROC bindBuffer = nullptr;
+    PFNGLBUFFERDATAPROC bufferData = nullptr;
+    PFNGLMAPBUFFERRANGEPROC mapBufferRange = nullptr;
+    PFNGLUNMAPBUFFERPROC unmapBuffer = nullptr;
+    bool hasBuffers = false;
+
+    // 纹理数组与纹理视图（每层可作为独立的 2D 纹理交给 ImGui 绘制）
+    PFNGLTEXSTORAGE3DPROC texStorage3D = nullptr;
+    PFNGLTEXSUBIMAGE3DPROC texSubImage3D = nullptr;
+    PFNGLTEXTUREVIEWPROC textureView = nullptr;
+    bool hasTextureArray = false;
+
+    // 纹理之间直接拷贝（图集扩容时保留旧内容）
+    PFNGLCOPYIMAGESUBDATAPROC copyImageSubData = nullptr;
+    bool hasCopyImage = false;
+
+    // 着色器程序（画布合成用）
+    PFNGLCREATESHADERPROC createShader = nullptr;
+    PFNGLSHADERSOURCEPROC shaderSource = nullptr;
+    PFNGLCOMPILESHADERPROC compileShader = nullptr;
+    PFNGLGETSHADERIVPROC getShaderiv = nullptr;
+    PFNGLGETSHADERINFOLOGPROC getShaderInfoLog = nullptr;
+    PFNGLDELETESHADERPROC deleteShader = nullptr;
+    PFNGLCREATEPROGRAMPROC createProgram = nullptr;
+    PFNGLATTACHSHADERPROC attachShader = nullptr;
+    PFNGLLINKPROGRAMPROC linkProgram = nullptr;
+    PFNGLGETPROGRAMIVPROC getProgramiv = nullptr;
+    PFNGLGETPROGRAMINFOLOGPROC getProgramInfoLog = nullptr;
+    PFNGLDELETEPROGRAMPROC deleteProgram = nullptr;
+    PFNGLUSEPROGRAMPROC useProgram = nullptr;
+    PFNGLGETUNIFORMLOCATIONPROC getUniformLocation = nullptr;
+    PFNGLUNIFORM1IPROC uniform1i = nullptr;
+    PFNGLUNIFORM1FPROC uniform1f = nullptr;
+    PFNGLUNIFORM2IPROC uniform2i = nullptr;
+    PFNGLUNIFORM2FPROC uniform2f = nullptr;
+    PFNGLUNIFORM4FPROC uniform4f = nullptr;
+    PFNGLUNIFORM1IVPROC uniform1iv = nullptr;
+    PFNGLUNIFORM4FVPROC uniform4fv = nullptr;
+    PFNGLGENVERTEXARRAYSPROC genVertexArrays = nullptr;
+    PFNGLBINDVERTEXARRAYPROC bindVertexArray = nullptr;
+    PFNGLDELETEVERTEXARRAYSPROC deleteVertexArrays = nullptr;
+    PFNGLACTIVETEXTUREPROC activeTexture = nullptr;
+    bool hasShaders = false;
+};
+
+const GlFunctions& glFunctions();
@@ -0,0 +1,96 @@
+#include "MipTextureCache.h"
+
+#include "GlFunctions.h"
+
+#include <vector>
+
+MipTextureCache::~MipTextureCache()
+{
+    release();
+}
+
+void MipTextureCache::release()
+{
+    for (auto& item : entries_)
+    {
+        if (item.second.texture != 0)
+            glDeleteTextures(1, &item.second.texture);
+    }
+    entries_.clear();
+    bytes_ = 0;
+}
+
+unsigned int MipTextureCache::sync(const Project& project, int frameIndex, TextureUploader& uploader, CanvasUploadMode mode)
+{
+    const uint64_t frameId = project.getFrame(frameIndex).id;
+    Entry& entry = entries_[frameId];
+    entry.lastUsed = ++useCounter_;
+
+    const size_t before = entry.chain.getByteSize();
+    if (!entry.chain.update(project, frameIndex))
+        return entry.texture;
+    bytes_ = bytes_ - before + entry.chain.getByteSize();
+    upload(entry, uploader, mode);
+    evict(frameId);
+    return entry.texture;
+}
+
+/**
+ * @brief 把 mip 链的变化上传到条目的纹理
+ *
+ * 帧编号在调整尺寸时重新分配，所以同一条目的尺寸不会变：纹理只在第一次时分配全部层级，
+ * 之后只上传各层变化的矩形。
+ */
+void MipTextureCache::upload(Entry& entry, TextureUploader& uploader, CanvasUploadMode mode) const
+{
+    const MipChain& chain = entry.chain;
+    const int levelCount = chain.getLevelCount();
+    const bool created = entry.texture == 0;
+    if (created)
+    {
+        glGenTextures(1, &entry.texture);
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+        for (int level = 0; level < levelCount; ++level)
+        {
+            const MipChain::Level& mip = chain.getLevel(level);
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    // 新建纹理时传空矩形列表表示整层上传
+    const bool whole = created || chain.wasRebuilt();
+    const std::vector<Project::DirtyRect> wholeLevel;
+    for (int level = 0; level < levelCount; ++level)
+    {
+        const std::vector<Project::DirtyRect>& rects = whole ? wholeLevel : chain.getChangedRects(level);
+        if (!whole && rects.empty())
+            continue;
+        TextureUploader::Target target;
+        target.texture = entry.texture;
+        target.level = level;
+        const MipChain::Level& mip = chain.getLevel(level);
+        uploader.upload(target, mip.pixels.data(), mip.width, mip.height, rects, mode);
+    }
+}
+
+void MipTextureCache::evict(uint64_t keepFrameId)
+{
+    while ((bytes_ > kMaxCacheBytes || entries_.size() > kMaxEntries) && entries_.size() > 1)
+    {
+        auto oldest = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->first != keepFrameId && (oldest == entries_.end() || it->second.lastUsed < oldest->second.lastUsed))
+                oldest = it;
+        }
+        if (oldest->second.texture != 0)
+            glDeleteTextures(1, &oldest->second.texture);
+        bytes_ -= oldest->second.chain.getByteSize();
+        entries_.erase(oldest);
+    }
+}
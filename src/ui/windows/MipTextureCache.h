@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TextureUploader.h"
+#include "core/AppContext.h"
+#include "core/MipChain.h"
+#include "core/Project.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief 缩小显示用的 mip 纹理缓存（按帧编号）
+ *
+ * 每一帧各有一条 MipChain 与一张带 mip 链的纹理。切帧（播放、拖动时间轴、洋葱皮导航）时
+ * 回到缓存中的帧只需按版本号补算脏区域，没有变化就不产生任何上传；
+ * 只有第一次显示的帧才整链生成并上传。
+ * 总字节数超过 kMaxCacheBytes（或条目超过 kMaxEntries）时淘汰最久没用过的帧；
+ * 已删除帧的条目不会再被访问，同样由淘汰回收。
+ */
+class MipTextureCache
+{
+public:
+    static constexpr size_t kMaxCacheBytes = static_cast<size_t>(64) << 20;
+    static constexpr size_t kMaxEntries = 256;
+
+    MipTextureCache() = default;
+    ~MipTextureCache();
+
+    MipTextureCache(const MipTextureCache&) = delete;
+    MipTextureCache& operator=(const MipTextureCache&) = delete;
+
+    // 同步指定帧的 mip 链并返回其纹理（预乘 alpha，三线性过滤）
+    unsigned int sync(const Project& project, int frameIndex, TextureUploader& uploader, CanvasUploadMode mode);
+
+    // 释放全部纹理与 mip 链
+    void release();
+
+private:
+    struct Entry
+    {
+        MipChain chain;
+        unsigned int texture = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    void upload(Entry& entry, TextureUploader& uploader, CanvasUploadMode mode) const;
+    void evict(uint64_t keepFrameId);
+
+    std::unordered_map<uint64_t, Entry> entries_;   // 帧编号 -> mip 链与纹理
+    uint64_t useCounter_ = 0;
+    size_t bytes_ = 0;
+};
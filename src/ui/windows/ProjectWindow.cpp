@@ -1,8 +1,10 @@
 #include "ProjectWindow.h"
 
 #include "core/AppContext.h"
+#include "core/FloatingSelection.h"
 #include "core/Project.h"
 #include "imgui.h"
+#include "tools/Tool.h"
 
 #include <SDL3/SDL_opengl.h>
 
@@ -11,10 +13,18 @@
 
 ProjectWindow::~ProjectWindow()
 {
-    if (canvasTexture_.texture != 0)
+    releaseCanvasTexture();
+    releaseOnionTexture();
+    mipTextures_.release();
+    if (navigatorState_.texture != 0)
     {
-        glDeleteTextures(1, &canvasTexture_.texture);
-        canvasTexture_.texture = 0;
+        glDeleteTextures(1, &navigatorState_.texture);
+        navigatorState_.texture = 0;
+    }
+    if (floatingTexture_.texture != 0)
+    {
+        glDeleteTextures(1, &floatingTexture_.texture);
+        floatingTexture_.texture = 0;
     }
     if (timelineState_.playIconTexture != 0)
     {
@@ -75,46 +85,187 @@ void ProjectWindow::ensureCanvasTexture(int width, int height)
     {
         canvasTexture_.width = width;
         canvasTexture_.height = height;
+        canvasTexture_.frameId = 0;
         glBindTexture(GL_TEXTURE_2D, canvasTexture_.texture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     }
 }
 
 /**
- * @brief 将像素数据上传到画布纹理中
- * 
- * 该函数将给定的像素数据上传到OpenGL纹理对象中，用于更新画布的显示内容。
- * 像素数据以RGBA格式存储，每个像素占用4个字节（uint32_t）。
- * 
- * @param pixels 包含RGBA像素数据的向量，数据按行优先顺序排列
+ * @brief 同步显存中的帧纹理并返回当前帧的显示位置
+ *
+ * 常驻模式：全部帧在 FrameTextureCache 中，切帧/播放只是换一层，不产生上传。
+ * 项目超出显存上限（即画布很大）时改用单张画布纹理，并且只维护可见部分：
+ * 纹理按脏块记住已上传内容的版本号，每个 UI 帧只检查 visible 覆盖的脏块，
+ * 上传其中过期的块；看不见的块保持过期，滚动到视口内时再补传。
+ * 放大查看大画布时，检查与上传的开销只与视口大小有关，与画布总尺寸无关。
+ * 实际上传（直接上传或 PBO 环）与耗时统计由 TextureUploader 完成。
+ *
+ * @param project 当前项目
+ * @param frameIndex 要显示的帧下标
+ * @param visible 可见的画布像素范围（平铺预览已折算回画布内）
  */
-void ProjectWindow::uploadCanvasPixels(const std::vector<uint32_t>& pixels) const
+FrameTextureCache::View ProjectWindow::syncCanvasTexture(const Project& project, int frameIndex, const Project::DirtyRect& visible)
 {
-    // 绑定画布纹理对象，后续操作将针对此纹理进行
-    glBindTexture(GL_TEXTURE_2D, canvasTexture_.texture);
+    const CanvasUploadMode mode = context->getCanvasUploadMode();
+    if (frameTextures_.sync(project, frameIndex, canvasUploader_, mode))
+    {
+        releaseCanvasTexture();
+        return frameTextures_.getView(frameIndex);
+    }
 
-    // 设置像素存储模式，确保数据按1字节对齐，避免因对齐问题导致的数据错误
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    ensureCanvasTexture(width, height);
+
+    FrameTextureCache::View view;
+    view.texture = canvasTexture_.texture;
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    const int tilesPerRow = project.getTilesPerRow();
+    if (canvasTexture_.frameId != frame.id)
+    {
+        // 换帧或纹理重建：已上传的内容全部作废
+        canvasTexture_.frameId = frame.id;
+        canvasTexture_.tileGenerations.assign(frame.tileGenerations.size(), 0);
+    }
+    if (visible.width <= 0 || visible.height <= 0)
+        return view;
+
+    const int tileSize = Project::kDirtyTileSize;
+    const int tx0 = visible.x / tileSize;
+    const int ty0 = visible.y / tileSize;
+    const int tx1 = (visible.x + visible.width + tileSize - 1) / tileSize;
+    const int ty1 = (visible.y + visible.height + tileSize - 1) / tileSize;
+
+    // 可见范围内过期的块：行内连续段合并成矩形，横向范围相同的段再向下合并
+    std::vector<Project::DirtyRect>& rects = canvasTexture_.dirtyRects;
+    rects.clear();
+    std::vector<size_t> open;   // 下边缘恰好在上一块行底部的矩形（可继续向下延伸）
+    std::vector<size_t> nextOpen;
+    for (int ty = ty0; ty < ty1; ++ty)
+    {
+        const size_t rowOffset = static_cast<size_t>(ty) * static_cast<size_t>(tilesPerRow);
+        const uint64_t* current = frame.tileGenerations.data() + rowOffset;
+        uint64_t* uploaded = canvasTexture_.tileGenerations.data() + rowOffset;
+        const int y = ty * tileSize;
+        const int h = std::min(tileSize, height - y);
+        nextOpen.clear();
+        for (int tx = tx0; tx < tx1;)
+        {
+            if (uploaded[tx] == current[tx])
+            {
+                ++tx;
+                continue;
+            }
+            const int runStart = tx;
+            while (tx < tx1 && uploaded[tx] != current[tx])
+            {
+                uploaded[tx] = current[tx];
+                ++tx;
+            }
+
+            Project::DirtyRect rect;
+            rect.x = runStart * tileSize;
+            rect.y = y;
+            rect.width = std::min(tx * tileSize, width) - rect.x;
+            rect.height = h;
+            size_t target = rects.size();
+            for (size_t i : open)
+            {
+                if (rects[i].x == rect.x && rects[i].width == rect.width)
+                {
+                    target = i;
+                    break;
+                }
+            }
+            if (target < rects.size())
+                rects[target].height += h;
+            else
+                rects.push_back(rect);
+            nextOpen.push_back(target);
+        }
+        open.swap(nextOpen);
+    }
+    if (rects.empty())
+        return view;
 
-    // 将像素数据上传到纹理中，替换纹理的全部内容
-    // 参数说明：
-    // - GL_TEXTURE_2D: 指定目标纹理类型为2D纹理
-    // - 0: 指定纹理的mipmap级别为0（基础级别）
-    // - 0, 0: 指定纹理更新的起始坐标为(0, 0)
-    // - canvasTexture_.width, canvasTexture_.height: 指定更新区域的宽度和高度
-    // - GL_RGBA: 指定像素数据的格式为RGBA
-    // - GL_UNSIGNED_BYTE: 指定每个颜色分量的数据类型为无符号字节
-    // - pixels.data(): 指向像素数据的指针
-    glTexSubImage2D(
-        GL_TEXTURE_2D,
-        0,
-        0,
-        0,
-        canvasTexture_.width,
-        canvasTexture_.height,
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        pixels.data());
+    // 矩形过碎时合并成一个外接矩形，一次上传比多次小上传更省驱动开销
+    if (rects.size() > 64)
+    {
+        int minX = width, minY = height, maxX = 0, maxY = 0;
+        for (const Project::DirtyRect& rect : rects)
+        {
+            minX = std::min(minX, rect.x);
+            minY = std::min(minY, rect.y);
+            maxX = std::max(maxX, rect.x + rect.width);
+            maxY = std::max(maxY, rect.y + rect.height);
+        }
+        rects.assign(1, Project::DirtyRect{minX, minY, maxX - minX, maxY - minY});
+    }
+    TextureUploader::Target target;
+    target.texture = canvasTexture_.texture;
+    canvasUploader_.upload(target, frame.pixels.data(), width, height, rects, mode);
+    return view;
+}
+
+void ProjectWindow::releaseCanvasTexture()
+{
+    if (canvasTexture_.texture != 0)
+    {
+        glDeleteTextures(1, &canvasTexture_.texture);
+        canvasTexture_ = CanvasTextureState();
+    }
+}
+
+/**
+ * @brief 结束当前笔画会话。
+ *
+ * 通知工具笔画结束，并把整笔的撤销记录压入命令栈（没有实际修改时不产生记录）。
+ */
+void ProjectWindow::finishStroke()
+{
+    if (!strokeSession_)
+        return;
+
+    if (strokeTool_)
+        strokeTool_->endStroke(*strokeSession_);
+    std::unique_ptr<Command> record = strokeSession_->finish();
+    if (record)
+    {
+        context->pushCommand(std::move(record));
+        context->setProjectDirty(true);
+    }
+    strokeSession_.reset();
+    strokeTool_ = nullptr;
+}
+
+/**
+ * @brief 同步浮动选区纹理。
+ *
+ * 仅当 FloatingSelection 的版本号变化（新粘贴、图像被替换）时才上传，
+ * 拖动浮动选区只改变绘制位置，不产生任何纹理上传。
+ */
+void ProjectWindow::syncFloatingTexture()
+{
+    const FloatingSelection& floating = context->getFloatingSelection();
+    if (!floating.isActive() || floatingTexture_.revision == floating.getRevision())
+        return;
+
+    if (floatingTexture_.texture == 0)
+    {
+        glGenTextures(1, &floatingTexture_.texture);
+        glBindTexture(GL_TEXTURE_2D, floatingTexture_.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    const ImageBuffer* image = floating.getImage();
+    glBindTexture(GL_TEXTURE_2D, floatingTexture_.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels.data());
+    floatingTexture_.revision = floating.getRevision();
 }
 
 /**
@@ -217,6 +368,7 @@ void ProjectWindow::render()
             ImGui::TableSetColumnIndex(3);
             if (ImGui::BeginChild("##ToolPropsPanel", ImVec2(0.0f, 0.0f), true))
             {
+                renderNavigatorPanel(project);
                 renderRightPanel(project);
             }
             ImGui::EndChild();
@@ -253,6 +405,66 @@ void ProjectWindow::render()
     // 结束时间轴面板的子窗口
     ImGui::EndChild();
 
+    // 菜单请求的对话框（弹窗挂在本窗口下，打开期间画布不响应绘制）
+    renderDialogs(project);
+
     // 结束ImGui窗口
     ImGui::End();
 }
+
+/**
+ * @brief 更新 CPU 合成的洋葱皮并返回其纹理
+ *
+ * OnionSkinCache 只在邻帧内容或设置变化时重新合成；合成结果不变的 UI 帧不产生上传。
+ *
+ * @param project 当前项目
+ * @param frameIndex 当前帧下标
+ */
+unsigned int ProjectWindow::syncOnionTexture(const Project& project, int frameIndex)
+{
+    const bool changed = onionCache_.update(project, frameIndex, context->getOnionSkinSettings());
+    if (onionCache_.isEmpty())
+        return 0;
+
+    const int width = project.getWidth();
+    const int height = project.getHeight();
+    bool upload = changed;
+    if (onionTexture_.texture == 0)
+    {
+        glGenTextures(1, &onionTexture_.texture);
+        glBindTexture(GL_TEXTURE_2D, onionTexture_.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    if (width != onionTexture_.width || height != onionTexture_.height)
+    {
+        onionTexture_.width = width;
+        onionTexture_.height = height;
+        glBindTexture(GL_TEXTURE_2D, onionTexture_.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        upload = true;
+    }
+
+    if (upload)
+    {
+        TextureUploader::Target target;
+        target.texture = onionTexture_.texture;
+        onionTexture_.dirtyRects.clear();
+        onionUploader_.upload(
+            target, onionCache_.getPixels().data(), width, height, onionTexture_.dirtyRects, context->getCanvasUploadMode());
+    }
+    return onionTexture_.texture;
+}
+
+void ProjectWindow::releaseOnionTexture()
+{
+    onionCache_.clear();
+    if (onionTexture_.texture != 0)
+    {
+        glDeleteTextures(1, &onionTexture_.texture);
+        onionTexture_ = CanvasTextureState();
+    }
+}
+
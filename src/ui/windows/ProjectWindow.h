@@ -1,14 +1,27 @@
 #ifndef PROJECTWINDOW_H
 #define PROJECTWINDOW_H
 
+#include "CanvasCompositor.h"
+#include "FrameTextureCache.h"
+#include "MipTextureCache.h"
+#include "TextureUploader.h"
+#include "ThumbnailAtlas.h"
 #include "Window.h"
+#include "core/FramePreview.h"
+#include "core/Morphology.h"
+#include "core/OnionSkin.h"
+#include "tools/StrokeFilter.h"
+#include "tools/StrokeSession.h"
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 class AppContext;
 class Project;
+class Tool;
 
 /**
  * @brief ProjectWindow 类继承自 Window，用于管理项目窗口的渲染和状态。
@@ -60,16 +73,49 @@ private:
         unsigned int texture = 0; ///< OpenGL 纹理 ID。
         int width = 0;            ///< 纹理宽度。
         int height = 0;           ///< 纹理高度。
+        uint64_t frameId = 0;     ///< 纹理内容所属帧的编号（0 表示内容无效）。
+        std::vector<uint64_t> tileGenerations; ///< 每个脏块已上传内容的版本号（0 表示未上传）。
+        std::vector<Project::DirtyRect> dirtyRects; ///< 局部上传时复用的脏矩形缓冲。
     };
 
-    // 调色板状态结构体，用于存储用户自定义调色板及选中颜色的信息。
+    // 浮动选区纹理状态结构体：浮动图像独立于画布纹理绘制，移动时无需改写帧。
+    struct FloatingTextureState
+    {
+        unsigned int texture = 0; ///< OpenGL 纹理 ID。
+        uint64_t revision = 0;    ///< 已上传内容对应的 FloatingSelection 版本号。
+        bool dragging = false;    ///< 是否正在拖动浮动选区。
+        int grabOffsetX = 0;      ///< 拖动起点相对浮动图像左上角的像素偏移 X。
+        int grabOffsetY = 0;      ///< 拖动起点相对浮动图像左上角的像素偏移 Y。
+    };
+
+    // 调色板状态结构体，用于存储选中颜色的信息（调色板颜色本身由 AppContext 持有）。
     struct PaletteState
     {
-        std::vector<uint32_t> userPalette; ///< 用户自定义调色板颜色列表。
-        int selectedIndex = 0;             ///< 当前选中的颜色索引。
+        int selectedIndex = 0;             ///< 当前选中的颜色索引（在所属分组内）。
         bool selectedIsUser = false;       ///< 标记当前选中的颜色是否来自用户调色板。
     };
 
+    // FX 对话框状态：参数在两次打开之间保留
+    struct FxDialogState
+    {
+        MorphologyParams morphology;        ///< 描边/扩张/腐蚀/投影参数。
+        bool colorInitialized = false;      ///< 首次打开时用前景色初始化颜色。
+    };
+
+    // Shift > Offset 对话框状态
+    struct ShiftDialogState
+    {
+        int offsetX = 0;                    ///< 水平偏移（像素，向右为正）。
+        int offsetY = 0;                    ///< 垂直偏移（像素，向下为正）。
+        bool wrap = true;                   ///< 移出的像素是否从另一侧移入。
+    };
+
+    // Replace Color 对话框状态：源色 -> 目标色列表在两次打开之间保留
+    struct ReplaceColorDialogState
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    };
+
     // 时间轴状态结构体，用于管理动画播放相关状态。
     struct TimelineState
     {
@@ -84,6 +130,17 @@ private:
         bool iconsLoaded = false;           ///< 图标是否已加载。
     };
 
+    // 导航器状态：缩小预览纹理与画布面板的视口尺寸（由画布面板每帧写入）
+    struct NavigatorState
+    {
+        unsigned int texture = 0;           ///< 预览纹理 ID。
+        int width = 0;                      ///< 预览纹理尺寸。
+        int height = 0;
+        uint64_t revision = 0;              ///< 已上传预览的版本号。
+        float viewWidth = 0.0f;             ///< 画布面板的可见区域尺寸（屏幕像素）。
+        float viewHeight = 0.0f;
+    };
+
     
     // 工具栏状态结构体，用于管理工具栏图标的状态
     struct ToolbarState
@@ -103,8 +160,32 @@ private:
      */
     void ensureCanvasTexture(int width, int height);
 
-    // 将像素数据上传到画布纹理
-    void uploadCanvasPixels(const std::vector<uint32_t>& pixels) const;
+    /**
+     * @brief 同步显存中的帧纹理并返回当前帧的显示位置
+     *
+     * 优先让全部帧常驻显存（FrameTextureCache）；放不下时退回单张画布纹理，
+     * 只上传 visible（画布像素坐标）范围内过期的脏块。
+     */
+    FrameTextureCache::View syncCanvasTexture(const Project& project, int frameIndex, const Project::DirtyRect& visible);
+
+    // 释放单张画布纹理（帧纹理常驻时不再需要）
+    void releaseCanvasTexture();
+
+    /**
+     * @brief 更新 CPU 合成的洋葱皮并返回其纹理（没有邻帧时返回 0）
+     *
+     * 着色器能直接从纹理数组取邻帧时不需要调用。
+     */
+    unsigned int syncOnionTexture(const Project& project, int frameIndex);
+
+    // 释放洋葱皮缓存与纹理
+    void releaseOnionTexture();
+
+    // 浮动图像内容变化时重新上传浮动选区纹理
+    void syncFloatingTexture();
+
+    // 结束当前笔画会话：通知工具并把撤销记录入栈
+    void finishStroke();
 
     // 渲染工具栏面板
     void renderToolbarPanel();
@@ -115,21 +196,53 @@ private:
     // 渲染画布面板
     void renderCanvasPanel(Project* project);
 
+    // 渲染导航器：整帧缩略图 + 当前视口矩形，点击拖动平移画布
+    void renderNavigatorPanel(Project* project);
+
     // 渲染右侧面板
     void renderRightPanel(Project* project);
 
     // 渲染时间轴面板。
     void renderTimelinePanel(Project* project);
 
+    // 处理菜单登记的对话框请求并渲染对话框
+    void renderDialogs(Project* project);
+    void renderFxDialog();
+    void renderShiftDialog();
+    void renderReplaceColorDialog();
+
     AppContext* context = nullptr;                  // 应用上下文指针
     std::string windowLabel_;                       // 窗口标签字符串
     std::function<void(AppContext*)> onFocused_;    // 窗口获得焦点时的回调函数
     CanvasTextureState canvasTexture_;              // 画布纹理状态
+    TextureUploader canvasUploader_;                // 画布纹理上传（直接上传 / PBO 环）；画布上方显示的耗时只统计它
+    FrameTextureCache frameTextures_;               // 常驻显存的全部帧纹理
+    CanvasCompositor canvasCompositor_;             // 着色器绘制画布底图（棋盘格/帧/网格）
+    OnionSkinCache onionCache_;                     // CPU 合成的洋葱皮
+    CanvasTextureState onionTexture_;               // 洋葱皮纹理（只用纹理与尺寸）
+    TextureUploader onionUploader_;                 // 洋葱皮纹理上传
+    std::vector<OnionSkinNeighbor> onionNeighbors_; // 着色器直接取邻帧时的邻帧列表
+    MipTextureCache mipTextures_;                   // 缩小显示用的各帧 mip 纹理（最近使用的若干帧）
+    TextureUploader mipUploader_;                   // mip 纹理上传
+    FloatingTextureState floatingTexture_;          // 浮动选区纹理状态
     PaletteState paletteState_;                     // 调色板状态
     TimelineState timelineState_;                   // 时间轴状态
     ToolbarState toolbarState_;                     // 工具栏状态
+    NavigatorState navigatorState_;                 // 导航器状态
+    FramePreviewCache navigatorPreviews_;           // 导航器用的帧缩小预览
+    TextureUploader navigatorUploader_;             // 导航器预览纹理上传
+    ThumbnailAtlas timelineThumbnails_;             // 时间轴帧缩略图（后台生成）
+    TextureUploader thumbnailUploader_;             // 缩略图图集上传
+    FxDialogState fxDialog_;                        // FX 对话框状态
+    ShiftDialogState shiftDialog_;                  // Shift > Offset 对话框状态
+    ReplaceColorDialogState replaceColorDialog_;    // Replace Color 对话框状态
     int pendingCanvasWidth_ = 0;                    // 待处理的画布宽度
     int pendingCanvasHeight_ = 0;                   // 待处理的画布高度
+    float rotateAngle_ = 15.0f;                     // 浮动选区任意角度旋转的角度（度）
+    StrokeFilter strokeFilter_;                     // 自由绘制笔画的流式补线/过滤
+    std::vector<StrokeFilter::Point> strokePoints_; // 本帧待交给工具的笔画像素（复用缓冲）
+    std::unique_ptr<StrokeSession> strokeSession_;  // 进行中的笔画会话（未按下时为空）
+    const Tool* strokeTool_ = nullptr;              // 进行中的笔画所用工具
 };
 
 #endif // PROJECTWINDOW_H
\ No newline at end of file
@@ -1,25 +1,45 @@
 #include "ProjectWindow.h"
 
+#include "commands/EditCommands.h"
 #include "core/AppContext.h"
+#include "core/FloatingSelection.h"
 #include "core/Project.h"
+#include "core/Tiling.h"
 #include "imgui.h"
 #include "tools/BrushTool.h"
 #include "tools/EraserTool.h"
 #include "tools/EyedropperTool.h"
 #include "tools/FillTool.h"
+#include "tools/GradientTool.h"
+#include "tools/MagicWandTool.h"
+#include "tools/ShadeTool.h"
+#include "tools/SprayTool.h"
+#include "tools/StrokeSession.h"
 #include "tools/Tool.h"
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
 #include <vector>
 
 namespace
 {
+    // 撤销记录中显示的笔画名称，与 ToolType 一一对应
+    const char* const kToolStrokeNames[] = {
+        "Brush", "Eraser", "Eyedropper", "Fill", "Line", "Rect", "Filled Rect", "Magic Wand", "Gradient", "Shade", "Spray"};
+    static_assert(sizeof(kToolStrokeNames) / sizeof(kToolStrokeNames[0]) == static_cast<size_t>(ToolType::Count),
+                  "kToolStrokeNames must match ToolType");
+
     const Tool* resolveTool(ToolType toolType)
     {
         static const BrushTool kBrushTool;
         static const EraserTool kEraserTool;
         static const EyedropperTool kEyedropperTool;
         static const FillTool kFillTool;
+        static const MagicWandTool kMagicWandTool;
+        static const GradientTool kGradientTool;
+        static const ShadeTool kShadeTool;
+        static const SprayTool kSprayTool;
 
         switch (toolType)
         {
@@ -31,59 +51,181 @@ namespace
             return &kEyedropperTool;
         case ToolType::Fill:
             return &kFillTool;
+        case ToolType::MagicWand:
+            return &kMagicWandTool;
+        case ToolType::Gradient:
+            return &kGradientTool;
+        case ToolType::Shade:
+            return &kShadeTool;
+        case ToolType::Spray:
+            return &kSprayTool;
         default:
             return nullptr;
         }
     }
+
+    /**
+     * @brief 一个方向上可见的画布像素范围 [begin, end)
+     *
+     * clipMin/clipMax 为屏幕上的可见区间，origin 为画布起点，zoom 为每像素的屏幕尺寸。
+     * wraps 为 true 时（平铺预览两侧各有一份副本）把范围折算回画布内：
+     * 跨越画布边界或超过一份画布宽度时取整个方向。
+     */
+    void visibleSpan(float clipMin, float clipMax, float origin, float zoom, int size, bool wraps, int& begin, int& end)
+    {
+        const float lo = std::floor((clipMin - origin) / zoom);
+        const float hi = std::ceil((clipMax - origin) / zoom);
+        const float limitLo = wraps ? -static_cast<float>(size) : 0.0f;
+        const float limitHi = wraps ? static_cast<float>(size) * 2.0f : static_cast<float>(size);
+        begin = static_cast<int>(std::max(lo, limitLo));
+        end = static_cast<int>(std::min(hi, limitHi));
+        if (begin >= end)
+        {
+            begin = end = 0;
+            return;
+        }
+        if (end - begin >= size)
+        {
+            begin = 0;
+            end = size;
+            return;
+        }
+        const int shift = begin < 0 ? size : (begin >= size ? -size : 0);
+        begin += shift;
+        end += shift;
+        if (end > size)
+        {
+            begin = 0;
+            end = size;
+        }
+    }
+
+    // 屏幕区域 [clipMin, clipMax] 内可见的画布像素矩形（可能为空）
+    Project::DirtyRect visibleCanvasRect(const ImVec2& clipMin,
+                                         const ImVec2& clipMax,
+                                         const ImVec2& origin,
+                                         float zoom,
+                                         int width,
+                                         int height,
+                                         bool wrapX,
+                                         bool wrapY)
+    {
+        int x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+        visibleSpan(clipMin.x, clipMax.x, origin.x, zoom, width, wrapX, x0, x1);
+        visibleSpan(clipMin.y, clipMax.y, origin.y, zoom, height, wrapY, y0, y1);
+        Project::DirtyRect rect;
+        if (x0 < x1 && y0 < y1)
+            rect = Project::DirtyRect{x0, y0, x1 - x0, y1 - y0};
+        return rect;
+    }
+
+    // 把选区按行内连续段绘制为半透明色块（只遍历 visible 范围内的非零掩码字）
+    void drawSelectionOverlay(ImDrawList* drawList,
+                              const Selection& selection,
+                              const ImVec2& origin,
+                              float zoom,
+                              const Project::DirtyRect& visible)
+    {
+        const ImU32 fillColor = IM_COL32(80, 160, 255, 70);
+        const int clipX0 = visible.x;
+        const int clipX1 = std::min(visible.x + visible.width, selection.getWidth());
+        const int wordBegin = clipX0 / 64;
+        const int wordEnd = std::min(selection.getWordsPerRow(), (clipX1 + 63) / 64);
+        const auto emitRun = [&](int y, int x0, int x1) {
+            x0 = std::max(x0, clipX0);
+            x1 = std::min(x1, clipX1 - 1);
+            if (x0 > x1)
+                return;
+            const ImVec2 p0(origin.x + x0 * zoom, origin.y + y * zoom);
+            const ImVec2 p1(origin.x + (x1 + 1) * zoom, p0.y + zoom);
+            drawList->AddRectFilled(p0, p1, fillColor);
+        };
+
+        const int yEnd = std::min(visible.y + visible.height, selection.getHeight());
+        for (int y = visible.y; y < yEnd; ++y)
+        {
+            const uint64_t* row = selection.rowWords(y);
+            int runStart = -1;
+            for (int w = wordBegin; w < wordEnd; ++w)
+            {
+                const uint64_t bits = row[w];
+                // 整字全空或全满且不改变当前段状态时直接跳过
+                if ((runStart < 0 && bits == 0) || (runStart >= 0 && bits == ~uint64_t(0)))
+                    continue;
+                for (int b = 0; b < 64; ++b)
+                {
+                    const bool on = ((bits >> b) & 1u) != 0;
+                    const int x = w * 64 + b;
+                    if (on && runStart < 0)
+                    {
+                        runStart = x;
+                    }
+                    else if (!on && runStart >= 0)
+                    {
+                        emitRun(y, runStart, x - 1);
+                        runStart = -1;
+                    }
+                }
+            }
+            if (runStart >= 0)
+                emitRun(y, runStart, clipX1 - 1);
+        }
+    }
 } // namespace
 
 void ProjectWindow::renderCanvasPanel(Project* project)
 {
     const int width = project->getWidth();
     const int height = project->getHeight();
-    int zoom = context->getCanvasZoom();
     const int frameIndex = context->getCurrentFrameIndex();
     const int frameCount = project->getFrameCount();
-    ImGui::Text("Canvas  %dx%d   Zoom %dx   Frame %d/%d", width, height, zoom, frameIndex + 1, frameCount);
+    ImGui::Text("Canvas  %dx%d   Zoom %.0f%%   Frame %d/%d",
+                width,
+                height,
+                context->getCanvasZoom() * 100.0f,
+                frameIndex + 1,
+                frameCount);
+    // 最近一次纹理上传的耗时（切换 View > Canvas Upload 对比两条路径）
+    const CanvasUploadMode uploadMode = canvasUploader_.getLastMode();
+    const TextureUploader::Stats& uploadStats = canvasUploader_.getStats(uploadMode);
+    if (uploadStats.uploads > 0)
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("   Upload %.3f ms (avg %.3f, %u KB, %s)",
+                            uploadStats.lastMs,
+                            uploadStats.averageMs,
+                            static_cast<unsigned>((uploadStats.lastBytes + 1023) / 1024),
+                            uploadMode == CanvasUploadMode::PixelBuffer ? "PBO" : "direct");
+    }
     ImGui::Separator();
 
-    Project::Frame& frame = project->getFrame(frameIndex);
-    ensureCanvasTexture(width, height);
-    uploadCanvasPixels(frame.pixels);
+    // 选区尺寸跟随画布（调整画布尺寸后旧选区失效）
+    Selection& selection = context->getSelection();
+    if (selection.getWidth() != width || selection.getHeight() != height)
+        selection.resize(width, height);
 
     const ImVec2 panelPos = ImGui::GetCursorScreenPos();
     const ImVec2 panelAvail = ImGui::GetContentRegionAvail();
-    const float imageW = static_cast<float>(width * zoom);
-    const float imageH = static_cast<float>(height * zoom);
-    const ImVec2 centerOffset((panelAvail.x - imageW) * 0.5f, (panelAvail.y - imageH) * 0.5f);
-    const float panX = context->getCanvasPanX();
-    const float panY = context->getCanvasPanY();
-    const ImVec2 imagePos(panelPos.x + centerOffset.x + panX, panelPos.y + centerOffset.y + panY);
-
     const ImVec2 hitboxSize(std::max(1.0f, panelAvail.x), std::max(1.0f, panelAvail.y));
+    navigatorState_.viewWidth = hitboxSize.x;
+    navigatorState_.viewHeight = hitboxSize.y;
     ImGui::InvisibleButton(
         "##CanvasHitbox",
         hitboxSize,
         ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle | ImGuiButtonFlags_MouseButtonRight);
+    const bool canvasHovered = ImGui::IsItemHovered();
 
+    // 滚轮连续缩放，以光标为锚点（光标下的画布像素保持不动）
     if (ImGui::IsItemHovered())
     {
         const float wheel = ImGui::GetIO().MouseWheel;
         if (wheel != 0.0f)
         {
-            const int zoomLevels[] = {1, 2, 4, 8, 16, 32};
-            int zoomIndex = 0;
-            for (int i = 0; i < 6; ++i)
-            {
-                if (zoomLevels[i] == zoom)
-                {
-                    zoomIndex = i;
-                    break;
-                }
-            }
-            zoomIndex = std::clamp(zoomIndex + (wheel > 0.0f ? 1 : -1), 0, 5);
-            zoom = zoomLevels[zoomIndex];
-            context->setCanvasZoom(zoom);
+            const ImVec2 mouse = ImGui::GetIO().MousePos;
+            const ImVec2 panelCenter(panelPos.x + panelAvail.x * 0.5f, panelPos.y + panelAvail.y * 0.5f);
+            context->zoomCanvasAt(context->getCanvasZoom() * std::pow(2.0f, wheel * 0.25f),
+                                  mouse.x - panelCenter.x,
+                                  mouse.y - panelCenter.y);
         }
     }
 
@@ -93,93 +235,386 @@ void ProjectWindow::renderCanvasPanel(Project* project)
         context->addCanvasPan(delta.x, delta.y);
     }
 
+    // 布局在缩放/平移之后计算，本帧立即生效
+    const float zoom = context->getCanvasZoom();
+    const float imageW = static_cast<float>(width) * zoom;
+    const float imageH = static_cast<float>(height) * zoom;
+    const ImVec2 centerOffset((panelAvail.x - imageW) * 0.5f, (panelAvail.y - imageH) * 0.5f);
+    const float panX = context->getCanvasPanX();
+    const float panY = context->getCanvasPanY();
+    const ImVec2 imagePos(panelPos.x + centerOffset.x + panX, panelPos.y + centerOffset.y + panY);
+
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     const ImVec2 imageMin = imagePos;
     const ImVec2 imageMax = ImVec2(imagePos.x + imageW, imagePos.y + imageH);
 
-    if (context->isCheckerboardBackgroundEnabled())
+    // 平铺模式：中心为实际画布，两侧各多显示一份环绕预览
+    const TiledMode tiledMode = context->getTiledMode();
+    const int tilesX = Tiling::wrapsX(tiledMode) ? 1 : 0;
+    const int tilesY = Tiling::wrapsY(tiledMode) ? 1 : 0;
+    const ImVec2 previewMin(imageMin.x - tilesX * imageW, imageMin.y - tilesY * imageH);
+    const ImVec2 previewMax(imageMax.x + tilesX * imageW, imageMax.y + tilesY * imageH);
+
+    // 视口裁剪：只上传、只画可见的画布像素（放大查看大画布时与画布总尺寸无关）
+    const ImVec2 clipMin(std::max(panelPos.x, drawList->GetClipRectMin().x), std::max(panelPos.y, drawList->GetClipRectMin().y));
+    const ImVec2 clipMax(std::min(panelPos.x + hitboxSize.x, drawList->GetClipRectMax().x),
+                         std::min(panelPos.y + hitboxSize.y, drawList->GetClipRectMax().y));
+    const Project::DirtyRect visibleTexels =
+        visibleCanvasRect(clipMin, clipMax, imageMin, zoom, width, height, tilesX > 0, tilesY > 0);
+    const Project::DirtyRect visiblePixels = visibleCanvasRect(clipMin, clipMax, imageMin, zoom, width, height, false, false);
+    // 缩小显示时当前帧改用 mip 链纹理，单张画布纹理不再需要为可见区域上传。
+    // mip 链按预乘 alpha 存储，只有着色器合成能正确混合；退回图元绘制时仍按纹素显示
+    const bool composited = canvasCompositor_.isAvailable();
+    const bool minified = zoom < 1.0f && composited;
+    unsigned int mipTexture = 0;
+    if (minified)
+        mipTexture = mipTextures_.sync(*project, frameIndex, mipUploader_, context->getCanvasUploadMode());
+    else
+        mipTextures_.release();
+    FrameTextureCache::View canvasView =
+        syncCanvasTexture(*project, frameIndex, minified ? Project::DirtyRect() : visibleTexels);
+    if (minified)
+    {
+        canvasView.texture = mipTexture;
+        canvasView.u0 = 0.0f;
+        canvasView.v0 = 0.0f;
+        canvasView.u1 = 1.0f;
+        canvasView.v1 = 1.0f;
+    }
+
+    // 着色器一次画出棋盘格、帧图像、平铺副本与网格；不可用时退回逐个图元绘制
+    const bool gridVisible = context->isGridVisible() && zoom >= 4;
+
+    // 洋葱皮：帧纹理常驻在纹理数组中时由着色器直接取邻帧，否则用 CPU 合成的纹理
+    const bool onionSkin = context->isOnionSkinEnabled();
+    const bool onionFromLayers =
+        onionSkin && composited && frameTextures_.getStorage() == FrameTextureCache::Storage::TextureArray;
+    unsigned int onionTexture = 0;
+    if (onionFromLayers)
+    {
+        releaseOnionTexture();
+        OnionSkin::collectNeighbors(project->getFrameCount(), frameIndex, context->getOnionSkinSettings(), onionNeighbors_);
+    }
+    else if (onionSkin)
     {
-        const ImU32 c1 = IM_COL32(70, 70, 70, 255);
-        const ImU32 c2 = IM_COL32(90, 90, 90, 255);
-        const float tileW = imageW * 0.5f;
-        const float tileH = imageH * 0.5f;
-        for (int ty = 0; ty < 2; ++ty)
+        onionTexture = syncOnionTexture(*project, frameIndex);
+    }
+    else
+    {
+        releaseOnionTexture();
+    }
+
+    if (composited)
+    {
+        CanvasCompositor::Params params;
+        params.frame = canvasView;
+        params.imageMin = imageMin;
+        params.zoom = zoom;
+        if (minified)
+        {
+            params.mipTexture = mipTexture;
+            params.mipLod = std::log2(1.0f / zoom);
+        }
+        params.width = width;
+        params.height = height;
+        params.tilesX = tilesX;
+        params.tilesY = tilesY;
+        params.checkerboard = context->isCheckerboardBackgroundEnabled();
+        params.grid = gridVisible;
+        if (onionFromLayers)
         {
-            for (int tx = 0; tx < 2; ++tx)
+            params.layerTexture = frameTextures_.getTexture();
+            params.onionCount = 0;
+            for (const OnionSkinNeighbor& neighbor : onionNeighbors_)
             {
-                const ImU32 col = ((tx + ty) % 2 == 0) ? c1 : c2;
-                const ImVec2 p0(imageMin.x + tx * tileW, imageMin.y + ty * tileH);
-                const ImVec2 p1(p0.x + tileW, p0.y + tileH);
-                drawList->AddRectFilled(p0, p1, col);
+                // 还没上传到显存的邻帧（刚加载或扩容后分批上传中）这一帧先不画
+                const int layer = frameTextures_.getLayer(neighbor.frameIndex);
+                if (layer < 0 || params.onionCount >= CanvasCompositor::kMaxOnionLayers)
+                    continue;
+                const int i = params.onionCount++;
+                params.onionLayers[i] = layer;
+                params.onionTints[i][0] = static_cast<float>(neighbor.layer.tint & 0xFFu) / 255.0f;
+                params.onionTints[i][1] = static_cast<float>((neighbor.layer.tint >> 8) & 0xFFu) / 255.0f;
+                params.onionTints[i][2] = static_cast<float>((neighbor.layer.tint >> 16) & 0xFFu) / 255.0f;
+                params.onionTints[i][3] = static_cast<float>(std::clamp(neighbor.layer.opacity, 0, 100)) / 100.0f;
             }
         }
+        params.onionTexture = onionTexture;
+        canvasCompositor_.draw(drawList, params);
     }
     else
     {
-        drawList->AddRectFilled(imageMin, imageMax, IM_COL32(255, 255, 255, 255));
-    }
+        for (int tileY = -tilesY; tileY <= tilesY; ++tileY)
+        {
+            for (int tileX = -tilesX; tileX <= tilesX; ++tileX)
+            {
+                const ImVec2 tileMin(imageMin.x + tileX * imageW, imageMin.y + tileY * imageH);
+                if (context->isCheckerboardBackgroundEnabled())
+                {
+                    const ImU32 c1 = IM_COL32(70, 70, 70, 255);
+                    const ImU32 c2 = IM_COL32(90, 90, 90, 255);
+                    const float tileW = imageW * 0.5f;
+                    const float tileH = imageH * 0.5f;
+                    for (int ty = 0; ty < 2; ++ty)
+                    {
+                        for (int tx = 0; tx < 2; ++tx)
+                        {
+                            const ImU32 col = ((tx + ty) % 2 == 0) ? c1 : c2;
+                            const ImVec2 p0(tileMin.x + tx * tileW, tileMin.y + ty * tileH);
+                            const ImVec2 p1(p0.x + tileW, p0.y + tileH);
+                            drawList->AddRectFilled(p0, p1, col);
+                        }
+                    }
+                }
+                else
+                {
+                    drawList->AddRectFilled(tileMin, ImVec2(tileMin.x + imageW, tileMin.y + imageH), IM_COL32(255, 255, 255, 255));
+                }
+            }
+        }
 
-    drawList->AddImage(
-        reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(canvasTexture_.texture)),
-        imageMin,
-        imageMax,
-        ImVec2(0, 0),
-        ImVec2(1, 1));
+        // 环绕副本逐份绘制同一纹理区域（图集中的帧不能靠 GL_REPEAT 重复），洋葱皮在帧下方
+        for (int tileY = -tilesY; tileY <= tilesY; ++tileY)
+        {
+            for (int tileX = -tilesX; tileX <= tilesX; ++tileX)
+            {
+                const ImVec2 tileMin(imageMin.x + tileX * imageW, imageMin.y + tileY * imageH);
+                if (onionTexture != 0)
+                {
+                    drawList->AddImage(
+                        reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(onionTexture)),
+                        tileMin,
+                        ImVec2(tileMin.x + imageW, tileMin.y + imageH));
+                }
+                drawList->AddImage(
+                    reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(canvasView.texture)),
+                    tileMin,
+                    ImVec2(tileMin.x + imageW, tileMin.y + imageH),
+                    ImVec2(canvasView.u0, canvasView.v0),
+                    ImVec2(canvasView.u1, canvasView.v1));
+            }
+        }
+
+        // 周围的预览副本稍微压暗，突出实际画布
+        for (int tileY = -tilesY; tileY <= tilesY; ++tileY)
+        {
+            for (int tileX = -tilesX; tileX <= tilesX; ++tileX)
+            {
+                if (tileX == 0 && tileY == 0)
+                    continue;
+                const ImVec2 tileMin(imageMin.x + tileX * imageW, imageMin.y + tileY * imageH);
+                drawList->AddRectFilled(tileMin, ImVec2(tileMin.x + imageW, tileMin.y + imageH), IM_COL32(0, 0, 0, 60));
+            }
+        }
+    }
     drawList->AddRect(imageMin, imageMax, IM_COL32(180, 180, 180, 255));
 
-    if (context->isGridVisible() && zoom >= 4)
+    // 浮动选区以独立纹理叠加绘制，移动时不改写帧像素
+    FloatingSelection& floating = context->getFloatingSelection();
+    if (floating.isActive())
+    {
+        floating.syncPreview(context->getCurrentFrameIndex());
+        syncFloatingTexture();
+        const ImageBuffer* floatingImage = floating.getImage();
+        const ImVec2 floatMin(imagePos.x + floating.getX() * zoom, imagePos.y + floating.getY() * zoom);
+        const ImVec2 floatMax(floatMin.x + floatingImage->width * zoom, floatMin.y + floatingImage->height * zoom);
+        drawList->PushClipRect(imageMin, imageMax, true);
+        drawList->AddImage(
+            reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(floatingTexture_.texture)),
+            floatMin,
+            floatMax,
+            ImVec2(0, 0),
+            ImVec2(1, 1));
+        drawList->PopClipRect();
+        drawList->AddRect(floatMin, floatMax, IM_COL32(255, 220, 40, 255));
+    }
+
+    drawSelectionOverlay(drawList, selection, imagePos, zoom, visiblePixels);
+
+    if (gridVisible && !composited)
     {
+        // 只画可见范围内的网格线，线段也只覆盖可见部分
         const ImU32 gridColor = IM_COL32(80, 80, 80, 120);
-        for (int x = 1; x < width; ++x)
+        const int gridX0 = std::max(1, visiblePixels.x);
+        const int gridX1 = std::min(width, visiblePixels.x + visiblePixels.width + 1);
+        const int gridY0 = std::max(1, visiblePixels.y);
+        const int gridY1 = std::min(height, visiblePixels.y + visiblePixels.height + 1);
+        const float lineTop = imagePos.y + visiblePixels.y * zoom;
+        const float lineBottom = imagePos.y + (visiblePixels.y + visiblePixels.height) * zoom;
+        const float lineLeft = imagePos.x + visiblePixels.x * zoom;
+        const float lineRight = imagePos.x + (visiblePixels.x + visiblePixels.width) * zoom;
+        for (int x = gridX0; x < gridX1; ++x)
         {
             const float gx = imagePos.x + x * zoom;
-            drawList->AddLine(ImVec2(gx, imagePos.y), ImVec2(gx, imagePos.y + imageH), gridColor);
+            drawList->AddLine(ImVec2(gx, lineTop), ImVec2(gx, lineBottom), gridColor);
         }
-        for (int y = 1; y < height; ++y)
+        for (int y = gridY0; y < gridY1; ++y)
         {
             const float gy = imagePos.y + y * zoom;
-            drawList->AddLine(ImVec2(imagePos.x, gy), ImVec2(imagePos.x + imageW, gy), gridColor);
+            drawList->AddLine(ImVec2(lineLeft, gy), ImVec2(lineRight, gy), gridColor);
         }
     }
 
+    // 对称轴参考线（径向对称只标出中心点）
+    const SymmetryMode symmetryMode = context->getSymmetryMode();
+    if (symmetryMode != SymmetryMode::None)
+    {
+        const ImU32 axisColor = IM_COL32(255, 90, 200, 200);
+        const ImVec2 center(imagePos.x + imageW * 0.5f, imagePos.y + imageH * 0.5f);
+        if (symmetryMode == SymmetryMode::Horizontal || symmetryMode == SymmetryMode::Both)
+            drawList->AddLine(ImVec2(center.x, imageMin.y), ImVec2(center.x, imageMax.y), axisColor);
+        if (symmetryMode == SymmetryMode::Vertical || symmetryMode == SymmetryMode::Both)
+            drawList->AddLine(ImVec2(imageMin.x, center.y), ImVec2(imageMax.x, center.y), axisColor);
+        if (symmetryMode == SymmetryMode::Radial)
+            drawList->AddCircle(center, 4.0f, axisColor);
+    }
+
     const ImVec2 mousePos = ImGui::GetMousePos();
     const bool anyPopupOpen = ImGui::IsPopupOpen(nullptr, ImGuiPopupFlags_AnyPopupId);
     const bool hovered =
-        mousePos.x >= imagePos.x &&
-        mousePos.y >= imagePos.y &&
-        mousePos.x < (imagePos.x + imageW) &&
-        mousePos.y < (imagePos.y + imageH);
+        mousePos.x >= previewMin.x &&
+        mousePos.y >= previewMin.y &&
+        mousePos.x < previewMax.x &&
+        mousePos.y < previewMax.y;
 
+    // 鼠标所在的画布像素：平铺方向取模环绕，其余方向钳制到画布内
+    const auto canvasPixel = [&](float local, int size, bool wraps) {
+        const int pixel = static_cast<int>(std::floor(local / zoom));
+        return wraps ? Tiling::wrap(pixel, size) : std::clamp(pixel, 0, size - 1);
+    };
+
+    // 浮动选区存在时，左键用于拖动/落地浮动选区，不再交给绘图工具
+    if (floating.isActive() && !anyPopupOpen)
+    {
+        finishStroke();
+        const int mouseX = static_cast<int>(std::floor((mousePos.x - imagePos.x) / zoom));
+        const int mouseY = static_cast<int>(std::floor((mousePos.y - imagePos.y) / zoom));
+        const bool eyedropper = context->getTool() == ToolType::Eyedropper;
+        if (eyedropper && hovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+        {
+            // 吸管可以在浮动选区存在时取色（合成模式下取到的是浮动图像的颜色），不落地也不拖动
+            context->setColorRGBA(EyedropperTool::sample(project->getFrame(frameIndex),
+                                                         width,
+                                                         height,
+                                                         canvasPixel(mousePos.x - imagePos.x, width, tilesX > 0),
+                                                         canvasPixel(mousePos.y - imagePos.y, height, tilesY > 0),
+                                                         *context));
+        }
+        else if (canvasHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+        {
+            if (floating.hitTest(mouseX, mouseY))
+            {
+                floatingTexture_.dragging = true;
+                floatingTexture_.grabOffsetX = mouseX - floating.getX();
+                floatingTexture_.grabOffsetY = mouseY - floating.getY();
+            }
+            else
+            {
+                // 点击浮动选区以外的位置：写回当前帧
+                EditCommands::commitFloating(*context);
+            }
+        }
+
+        if (floatingTexture_.dragging && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+            floating.setPosition(mouseX - floatingTexture_.grabOffsetX, mouseY - floatingTexture_.grabOffsetY);
+        if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+            floatingTexture_.dragging = false;
+
+        if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows))
+        {
+            if (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter))
+                EditCommands::commitFloating(*context);
+            else if (ImGui::IsKeyPressed(ImGuiKey_Escape))
+                EditCommands::cancelFloating(*context);
+        }
+    }
     // 只在“无弹窗”时才处理画布编辑输入，避免弹窗期间误绘制。
-    if (!anyPopupOpen && hovered && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    else if (!anyPopupOpen)
     {
-        const float localX = mousePos.x - imagePos.x;
-        const float localY = mousePos.y - imagePos.y;
-        const int pixelX = std::clamp(static_cast<int>(localX / zoom), 0, width - 1);
-        const int pixelY = std::clamp(static_cast<int>(localY / zoom), 0, height - 1);
+        const bool mouseDown = ImGui::IsMouseDown(ImGuiMouseButton_Left);
 
+        // 笔画坐标既不环绕也不钳制：平铺时跨边的线段保持连续，拖出画布时线段在交给工具前再裁剪
+        const int strokeX = static_cast<int>(std::floor((mousePos.x - imagePos.x) / zoom));
+        const int strokeY = static_cast<int>(std::floor((mousePos.y - imagePos.y) / zoom));
+
+        strokePoints_.clear();
         const Tool* tool = resolveTool(context->getTool());
-        if (tool)
+        if (!strokeSession_ && tool && hovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
         {
-            const bool changed = tool->apply(
-                frame,
-                width,
-                height,
-                pixelX,
-                pixelY,
-                *context,
-                ImGui::IsMouseClicked(ImGuiMouseButton_Left));
-            if (changed)
-                context->setProjectDirty(true);
+            // 按下：开启笔画会话，整笔共享撤销记录与临时缓冲
+            strokeSession_ = std::make_unique<StrokeSession>(*project, frameIndex, *context, kToolStrokeNames[static_cast<int>(tool->type())]);
+            strokeTool_ = tool;
+            const bool pixelPerfect = tool->isFreehand() && context->isPixelPerfect() && context->getBrushSize() == 1;
+            strokeFilter_.begin(strokeX, strokeY, pixelPerfect, strokePoints_);
+            tool->beginStroke(*strokeSession_,
+                              canvasPixel(mousePos.x - imagePos.x, width, tilesX > 0),
+                              canvasPixel(mousePos.y - imagePos.y, height, tilesY > 0));
+        }
+        else if (strokeSession_ && mouseDown)
+        {
+            strokeFilter_.moveTo(strokeX, strokeY, strokePoints_);
         }
+        if (strokeSession_ && !mouseDown)
+            strokeFilter_.end(strokePoints_);
+
+        if (strokeSession_)
+        {
+            // 本帧新增的点作为一批提交给工具：平铺方向映射回画布；其余方向超出画布的点
+            // 对逐点绘制的工具直接丢弃（拖出画布不会沿边缘画线），对渐变等钳制到边缘
+            const bool clamps = strokeTool_->clampsStrokeToCanvas();
+            size_t kept = 0;
+            for (StrokeFilter::Point point : strokePoints_)
+            {
+                if (tilesX > 0)
+                    point.first = Tiling::wrap(point.first, width);
+                else if (clamps)
+                    point.first = std::clamp(point.first, 0, width - 1);
+                else if (point.first < 0 || point.first >= width)
+                    continue;
+                if (tilesY > 0)
+                    point.second = Tiling::wrap(point.second, height);
+                else if (clamps)
+                    point.second = std::clamp(point.second, 0, height - 1);
+                else if (point.second < 0 || point.second >= height)
+                    continue;
+                strokePoints_[kept++] = point;
+            }
+            strokePoints_.resize(kept);
+            if (!strokePoints_.empty())
+                strokeTool_->updateStroke(*strokeSession_, strokePoints_);
+            if (!mouseDown)
+                finishStroke();
+        }
+
+        // 渐变拖动中画出起点到鼠标的引导线
+        if (strokeSession_ && strokeTool_->type() == ToolType::Gradient)
+        {
+            const ImVec2 anchor(imagePos.x + (strokeSession_->getAnchorX() + 0.5f) * zoom,
+                                imagePos.y + (strokeSession_->getAnchorY() + 0.5f) * zoom);
+            drawList->AddLine(anchor, mousePos, IM_COL32(255, 255, 255, 220), 1.5f);
+            drawList->AddCircleFilled(anchor, 3.0f, IM_COL32(255, 255, 255, 220));
+        }
+
+        // 撤销/重做快捷键（笔画进行中不响应）
+        if (!strokeSession_ && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows))
+        {
+            if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Z))
+                context->undo();
+            else if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Y) ||
+                     ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_Z))
+                context->redo();
+        }
+    }
+    else
+    {
+        finishStroke();
     }
 
     if (!anyPopupOpen && hovered)
     {
-        const float localX = mousePos.x - imagePos.x;
-        const float localY = mousePos.y - imagePos.y;
-        const int pixelX = std::clamp(static_cast<int>(localX / zoom), 0, width - 1);
-        const int pixelY = std::clamp(static_cast<int>(localY / zoom), 0, height - 1);
+        // 高亮跟随鼠标所在的副本，不映射回中心画布
+        const int pixelX = static_cast<int>(std::floor((mousePos.x - imagePos.x) / zoom));
+        const int pixelY = static_cast<int>(std::floor((mousePos.y - imagePos.y) / zoom));
         const ImVec2 hlMin(imagePos.x + pixelX * zoom, imagePos.y + pixelY * zoom);
         const ImVec2 hlMax(hlMin.x + zoom, hlMin.y + zoom);
         drawList->AddRect(hlMin, hlMax, IM_COL32(255, 255, 0, 200));
@@ -0,0 +1,218 @@
+#include "ProjectWindow.h"
+
+#include "commands/EditCommands.h"
+#include "commands/FilterCommands.h"
+#include "core/AppContext.h"
+#include "core/Project.h"
+#include "imgui.h"
+
+#include <algorithm>
+
+namespace
+{
+const char* const kFxPopupId = "FX###ProjectFxDialog";
+const char* const kShiftPopupId = "Offset Frames###ProjectShiftDialog";
+const char* const kReplaceColorPopupId = "Replace Color###ProjectReplaceColorDialog";
+
+// 帧范围提示（对话框作用于时间线帧范围）
+void frameRangeText(const AppContext& context)
+{
+    int first = 0;
+    int last = 0;
+    context.getFrameRange(first, last);
+    if (first == last)
+        ImGui::Text("Frame %d", first + 1);
+    else
+        ImGui::Text("Frames %d-%d", first + 1, last + 1);
+}
+} // namespace
+
+void ProjectWindow::renderDialogs(Project* project)
+{
+    (void)project;
+
+    // 菜单点击后只登记请求；真正 OpenPopup 放在本窗口的渲染帧中执行
+    const auto openFx = [this](MorphologyOp op) {
+        MorphologyParams& params = fxDialog_.morphology;
+        params.op = op;
+        if (!fxDialog_.colorInitialized)
+        {
+            params.color = context->getColorRGBA();
+            fxDialog_.colorInitialized = true;
+        }
+        ImGui::OpenPopup(kFxPopupId);
+    };
+    switch (context->takeDialogRequest())
+    {
+    case EditorDialog::Outline:
+        openFx(MorphologyOp::Outline);
+        break;
+    case EditorDialog::Dilate:
+        openFx(MorphologyOp::Dilate);
+        break;
+    case EditorDialog::Erode:
+        openFx(MorphologyOp::Erode);
+        break;
+    case EditorDialog::DropShadow:
+        openFx(MorphologyOp::DropShadow);
+        break;
+    case EditorDialog::ShiftFrames:
+        ImGui::OpenPopup(kShiftPopupId);
+        break;
+    case EditorDialog::ReplaceColor:
+        // 首次打开时以前景色 -> 背景色作为第一项
+        if (replaceColorDialog_.pairs.empty())
+            replaceColorDialog_.pairs.emplace_back(context->getColorRGBA(), context->getSecondaryColorRGBA());
+        ImGui::OpenPopup(kReplaceColorPopupId);
+        break;
+    default:
+        break;
+    }
+
+    renderFxDialog();
+    renderShiftDialog();
+    renderReplaceColorDialog();
+}
+
+void ProjectWindow::renderFxDialog()
+{
+    MorphologyParams& params = fxDialog_.morphology;
+    if (!ImGui::BeginPopupModal(kFxPopupId, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        return;
+
+    const char* opLabels[] = {"Outline", "Dilate", "Erode", "Drop Shadow"};
+    int op = static_cast<int>(params.op);
+    ImGui::SetNextItemWidth(160.0f);
+    if (ImGui::Combo("Filter", &op, opLabels, static_cast<int>(MorphologyOp::Count)))
+        params.op = static_cast<MorphologyOp>(op);
+    ImGui::Separator();
+
+    if (params.op != MorphologyOp::DropShadow)
+    {
+        int connectivity = params.eightConnected ? 1 : 0;
+        ImGui::RadioButton("4-connected", &connectivity, 0);
+        ImGui::SameLine();
+        ImGui::RadioButton("8-connected", &connectivity, 1);
+        params.eightConnected = (connectivity == 1);
+
+        ImGui::SetNextItemWidth(160.0f);
+        ImGui::SliderInt("Thickness", &params.thickness, 1, Morphology::kMaxThickness);
+    }
+    if (params.op == MorphologyOp::Outline)
+    {
+        int placement = params.inside ? 1 : 0;
+        ImGui::RadioButton("Outside", &placement, 0);
+        ImGui::SameLine();
+        ImGui::RadioButton("Inside", &placement, 1);
+        params.inside = (placement == 1);
+    }
+    if (params.op == MorphologyOp::DropShadow)
+    {
+        ImGui::SetNextItemWidth(160.0f);
+        ImGui::SliderInt("Offset X", &params.offsetX, -Morphology::kMaxShadowOffset, Morphology::kMaxShadowOffset);
+        ImGui::SetNextItemWidth(160.0f);
+        ImGui::SliderInt("Offset Y", &params.offsetY, -Morphology::kMaxShadowOffset, Morphology::kMaxShadowOffset);
+    }
+    if (params.op == MorphologyOp::Outline || params.op == MorphologyOp::DropShadow)
+    {
+        ImVec4 color = ImGui::ColorConvertU32ToFloat4(params.color);
+        if (ImGui::ColorEdit4("Color", &color.x, ImGuiColorEditFlags_AlphaBar))
+            params.color = ImGui::ColorConvertFloat4ToU32(color);
+    }
+    params.thickness = std::clamp(params.thickness, 1, Morphology::kMaxThickness);
+
+    frameRangeText(*context);
+
+    ImGui::Separator();
+    if (ImGui::Button("Apply", ImVec2(120.0f, 0.0f)))
+    {
+        FilterCommands::applyMorphology(*context, params);
+        ImGui::CloseCurrentPopup();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Cancel", ImVec2(120.0f, 0.0f)))
+        ImGui::CloseCurrentPopup();
+
+    ImGui::EndPopup();
+}
+
+void ProjectWindow::renderShiftDialog()
+{
+    if (!ImGui::BeginPopupModal(kShiftPopupId, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        return;
+
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::InputInt("Offset X", &shiftDialog_.offsetX);
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::InputInt("Offset Y", &shiftDialog_.offsetY);
+
+    int edge = shiftDialog_.wrap ? 0 : 1;
+    ImGui::RadioButton("Wrap", &edge, 0);
+    ImGui::SameLine();
+    ImGui::RadioButton("Clear", &edge, 1);
+    shiftDialog_.wrap = (edge == 0);
+
+    frameRangeText(*context);
+
+    ImGui::Separator();
+    if (ImGui::Button("Apply", ImVec2(120.0f, 0.0f)))
+    {
+        EditCommands::shiftFrames(*context, shiftDialog_.offsetX, shiftDialog_.offsetY, shiftDialog_.wrap);
+        ImGui::CloseCurrentPopup();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Cancel", ImVec2(120.0f, 0.0f)))
+        ImGui::CloseCurrentPopup();
+
+    ImGui::EndPopup();
+}
+
+void ProjectWindow::renderReplaceColorDialog()
+{
+    if (!ImGui::BeginPopupModal(kReplaceColorPopupId, nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        return;
+
+    std::vector<std::pair<uint32_t, uint32_t>>& pairs = replaceColorDialog_.pairs;
+    const ImGuiColorEditFlags flags = ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_AlphaBar;
+    int removeIndex = -1;
+    for (int i = 0; i < static_cast<int>(pairs.size()); ++i)
+    {
+        std::pair<uint32_t, uint32_t>& pair = pairs[static_cast<size_t>(i)];
+        ImGui::PushID(i);
+        ImVec4 from = ImGui::ColorConvertU32ToFloat4(pair.first);
+        if (ImGui::ColorEdit4("##from", &from.x, flags))
+            pair.first = ImGui::ColorConvertFloat4ToU32(from);
+        ImGui::SameLine();
+        ImGui::TextUnformatted("->");
+        ImGui::SameLine();
+        ImVec4 to = ImGui::ColorConvertU32ToFloat4(pair.second);
+        if (ImGui::ColorEdit4("##to", &to.x, flags))
+            pair.second = ImGui::ColorConvertFloat4ToU32(to);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove"))
+            removeIndex = i;
+        ImGui::PopID();
+    }
+    if (removeIndex >= 0)
+        pairs.erase(pairs.begin() + removeIndex);
+
+    if (ImGui::Button("Add (Foreground -> Secondary)"))
+        pairs.emplace_back(context->getColorRGBA(), context->getSecondaryColorRGBA());
+    ImGui::SameLine();
+    if (ImGui::Button("Clear"))
+        pairs.clear();
+
+    if (const Project* current = context->getProject())
+        ImGui::Text("Applies to all %d frames", current->getFrameCount());
+    ImGui::Separator();
+    if (ImGui::Button("Apply", ImVec2(120.0f, 0.0f)))
+    {
+        FilterCommands::replaceColors(*context, pairs);
+        ImGui::CloseCurrentPopup();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Cancel", ImVec2(120.0f, 0.0f)))
+        ImGui::CloseCurrentPopup();
+
+    ImGui::EndPopup();
+}
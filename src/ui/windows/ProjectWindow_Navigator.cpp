@@ -0,0 +1,90 @@
+#include "ProjectWindow.h"
+
+#include "core/AppContext.h"
+#include "core/FramePreview.h"
+#include "core/Project.h"
+#include "imgui.h"
+
+#include <SDL3/SDL_opengl.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    constexpr float kNavigatorMaxHeight = 180.0f;   // 缩略图最大高度（屏幕像素）
+} // namespace
+
+void ProjectWindow::renderNavigatorPanel(Project* project)
+{
+    if (!ImGui::CollapsingHeader("Navigator", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    const int width = project->getWidth();
+    const int height = project->getHeight();
+    const FramePreview& preview = navigatorPreviews_.update(*project, context->getCurrentFrameIndex());
+
+    // 预览只有在内容变化时才重新上传（最大 256x256，整张上传即可）
+    NavigatorState& state = navigatorState_;
+    if (state.texture == 0)
+    {
+        glGenTextures(1, &state.texture);
+        glBindTexture(GL_TEXTURE_2D, state.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    if (preview.width != state.width || preview.height != state.height)
+    {
+        state.width = preview.width;
+        state.height = preview.height;
+        state.revision = 0;
+        glBindTexture(GL_TEXTURE_2D, state.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, preview.width, preview.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    if (preview.revision != state.revision)
+    {
+        TextureUploader::Target target;
+        target.texture = state.texture;
+        const std::vector<Project::DirtyRect> wholePreview;
+        navigatorUploader_.upload(
+            target, preview.pixels.data(), preview.width, preview.height, wholePreview, context->getCanvasUploadMode());
+        state.revision = preview.revision;
+    }
+
+    // 缩略图占满面板宽度，按画布比例缩放
+    const float availWidth = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    const float scale = std::min(availWidth / static_cast<float>(width), kNavigatorMaxHeight / static_cast<float>(height));
+    const ImVec2 size(static_cast<float>(width) * scale, static_cast<float>(height) * scale);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 originMax(origin.x + size.x, origin.y + size.y);
+    ImGui::InvisibleButton("##Navigator", ImVec2(std::max(1.0f, size.x), std::max(1.0f, size.y)));
+
+    // 点击或拖动：把指向的画布位置移到画布面板中心
+    const float zoom = context->getCanvasZoom();
+    if (ImGui::IsItemActive() && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+        const float canvasX = std::clamp((mouse.x - origin.x) / scale, 0.0f, static_cast<float>(width));
+        const float canvasY = std::clamp((mouse.y - origin.y) / scale, 0.0f, static_cast<float>(height));
+        context->setCanvasPan((static_cast<float>(width) * 0.5f - canvasX) * zoom,
+                              (static_cast<float>(height) * 0.5f - canvasY) * zoom);
+    }
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(origin, originMax, IM_COL32(70, 70, 70, 255));
+    drawList->AddImage(reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(state.texture)), origin, originMax);
+
+    // 视口矩形：画布面板中心对应画布点 (width / 2 - panX / zoom, height / 2 - panY / zoom)
+    const float viewLeft = static_cast<float>(width) * 0.5f - (state.viewWidth * 0.5f + context->getCanvasPanX()) / zoom;
+    const float viewTop = static_cast<float>(height) * 0.5f - (state.viewHeight * 0.5f + context->getCanvasPanY()) / zoom;
+    const ImVec2 viewMin(origin.x + viewLeft * scale, origin.y + viewTop * scale);
+    const ImVec2 viewMax(viewMin.x + state.viewWidth / zoom * scale, viewMin.y + state.viewHeight / zoom * scale);
+    drawList->PushClipRect(origin, originMax, true);
+    drawList->AddRect(viewMin, viewMax, IM_COL32(255, 220, 40, 255), 0.0f, 0, 2.0f);
+    drawList->PopClipRect();
+    drawList->AddRect(origin, originMax, IM_COL32(180, 180, 180, 255));
+
+    ImGui::Separator();
+}
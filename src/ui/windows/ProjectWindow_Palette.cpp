@@ -5,6 +5,7 @@
 #include "imgui.h"
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace
@@ -34,18 +35,19 @@ void ProjectWindow::renderLeftPanel(Project* project)
 {
     (void)project;
 
-    static const uint32_t kDefaultPalette[] = {
-        0xFF000000, 0xFFFFFFFF, 0xFF404040, 0xFFC0C0C0,
-        0xFF0000FF, 0xFF00FF00, 0xFFFF0000, 0xFF00FFFF,
-        0xFFFF00FF, 0xFFFFFF00, 0xFF804000, 0xFFFFA500,
-        0xFF8B4513, 0xFF800080, 0xFF008080, 0xFF1E90FF
-    };
-    std::vector<uint32_t>& userPalette = paletteState_.userPalette;
+    // 调色板由 AppContext 持有（渐变等工具按调色板量化）；前 defaultCount 个为内置颜色
+    const std::vector<uint32_t>& palette = context->getPalette();
     int& selectedIndex = paletteState_.selectedIndex;
     bool& selectedIsUser = paletteState_.selectedIsUser;
 
-    const int defaultCount = static_cast<int>(sizeof(kDefaultPalette) / sizeof(kDefaultPalette[0]));
-    const int userCount = static_cast<int>(userPalette.size());
+    const int defaultCount = context->getDefaultPaletteSize();
+    const int userCount = static_cast<int>(palette.size()) - defaultCount;
+
+    const auto appendToShadeRamp = [&](uint32_t swatch) {
+        std::vector<uint32_t> colors = context->getShadeRampColors();
+        colors.push_back(swatch);
+        context->setShadeRampColors(std::move(colors));
+    };
 
     if (!selectedIsUser)
     {
@@ -66,32 +68,44 @@ void ProjectWindow::renderLeftPanel(Project* project)
     }
 
     const uint32_t selectedColor = selectedIsUser
-        ? userPalette[static_cast<size_t>(selectedIndex)]
-        : kDefaultPalette[selectedIndex];
+        ? palette[static_cast<size_t>(defaultCount + selectedIndex)]
+        : palette[static_cast<size_t>(selectedIndex)];
 
     ImGui::TextUnformatted("Color Picker");
     ImVec4 color = rgbaToFloat4(selectedColor);
     if (ImGui::ColorPicker4("##ProjectColorPicker", &color.x, ImGuiColorEditFlags_AlphaBar))
     {
         const uint32_t newColor = float4ToRgba(color);
-        if (selectedIsUser && !userPalette.empty())
-            userPalette[static_cast<size_t>(selectedIndex)] = newColor;
+        if (selectedIsUser && userCount > 0)
+            context->setPaletteColor(defaultCount + selectedIndex, newColor);
         context->setColorRGBA(newColor);
         context->setProjectDirty(true);
     }
 
     ImGui::Separator();
     ImGui::TextUnformatted("Palette - Default");
+    ImGui::TextDisabled("Right-click: secondary color");
+    ImGui::TextDisabled("Shift+click: append to shading ramp");
     for (int i = 0; i < defaultCount; ++i)
     {
         const bool isSelected = (!selectedIsUser && selectedIndex == i);
         ImGui::PushID(i);
-        if (ImGui::ColorButton("##palette_default", rgbaToFloat4(kDefaultPalette[i]), ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f)))
+        const uint32_t swatch = palette[static_cast<size_t>(i)];
+        if (ImGui::ColorButton("##palette_default", rgbaToFloat4(swatch), ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f)))
         {
-            selectedIsUser = false;
-            selectedIndex = i;
-            context->setColorRGBA(kDefaultPalette[i]);
+            if (ImGui::GetIO().KeyShift)
+            {
+                appendToShadeRamp(swatch);
+            }
+            else
+            {
+                selectedIsUser = false;
+                selectedIndex = i;
+                context->setColorRGBA(swatch);
+            }
         }
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
+            context->setSecondaryColorRGBA(swatch);
         if (isSelected)
         {
             ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -110,22 +124,32 @@ void ProjectWindow::renderLeftPanel(Project* project)
 
     ImGui::Separator();
     ImGui::TextUnformatted("Palette - User");
-    if (userPalette.empty())
+    if (userCount == 0)
     {
         ImGui::TextUnformatted("No user colors yet.");
     }
     else
     {
-        for (int i = 0; i < static_cast<int>(userPalette.size()); ++i)
+        for (int i = 0; i < userCount; ++i)
         {
             const bool isSelected = (selectedIsUser && selectedIndex == i);
+            const uint32_t swatch = palette[static_cast<size_t>(defaultCount + i)];
             ImGui::PushID(i);
-            if (ImGui::ColorButton("##palette_user", rgbaToFloat4(userPalette[static_cast<size_t>(i)]), ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f)))
+            if (ImGui::ColorButton("##palette_user", rgbaToFloat4(swatch), ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f)))
             {
-                selectedIsUser = true;
-                selectedIndex = i;
-                context->setColorRGBA(userPalette[static_cast<size_t>(i)]);
+                if (ImGui::GetIO().KeyShift)
+                {
+                    appendToShadeRamp(swatch);
+                }
+                else
+                {
+                    selectedIsUser = true;
+                    selectedIndex = i;
+                    context->setColorRGBA(swatch);
+                }
             }
+            if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
+                context->setSecondaryColorRGBA(swatch);
             if (isSelected)
             {
                 ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -143,13 +167,36 @@ void ProjectWindow::renderLeftPanel(Project* project)
         }
     }
 
+    // 明暗笔使用的色带（按添加顺序，由前到后）
+    ImGui::Separator();
+    ImGui::TextUnformatted("Shading Ramp");
+    const std::vector<uint32_t>& rampColors = context->getShadeRamp().getColors();
+    if (rampColors.empty())
+    {
+        ImGui::TextUnformatted("Empty.");
+    }
+    else
+    {
+        for (int i = 0; i < static_cast<int>(rampColors.size()); ++i)
+        {
+            ImGui::PushID(i);
+            ImGui::ColorButton("##shade_ramp", rgbaToFloat4(rampColors[static_cast<size_t>(i)]), ImGuiColorEditFlags_NoTooltip, ImVec2(16.0f, 16.0f));
+            ImGui::PopID();
+            if ((i + 1) % 8 != 0)
+                ImGui::SameLine(0.0f, 2.0f);
+        }
+        ImGui::NewLine();
+        if (ImGui::Button("Clear Ramp"))
+            context->setShadeRampColors({});
+    }
+
     ImGui::Separator();
     if (ImGui::Button("+ Add Color"))
     {
         const uint32_t newColor = context->getColorRGBA();
-        userPalette.push_back(newColor);
+        context->addPaletteColor(newColor);
         selectedIsUser = true;
-        selectedIndex = static_cast<int>(userPalette.size()) - 1;
+        selectedIndex = userCount;
         context->setProjectDirty(true);
     }
 }
@@ -9,6 +9,8 @@
 #include <SDL3_image/SDL_image.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 
 namespace
 {
@@ -115,6 +117,8 @@ void ProjectWindow::renderTimelinePanel(Project* project)
         {
             const int current = context->getCurrentFrameIndex();
             project->insertFrameAfter(current, 0x00000000);
+            // 增删帧会改变帧索引，按帧记录的撤销历史随之失效
+            context->clearUndoHistory();
             context->setCurrentFrameIndex(current + 1);
             context->setProjectDirty(true);
         }
@@ -126,6 +130,7 @@ void ProjectWindow::renderTimelinePanel(Project* project)
             {
                 const int current = context->getCurrentFrameIndex();
                 project->removeFrame(current);
+                context->clearUndoHistory();
                 const int newCount = project->getFrameCount();
                 context->setCurrentFrameIndex(std::min(current, newCount - 1));
                 context->setProjectDirty(true);
@@ -225,36 +230,87 @@ void ProjectWindow::renderTimelinePanel(Project* project)
         }
     }
 
-    const float cellW = 36.0f;
-    const float cellH = 24.0f;
+    // 帧条按水平方向虚拟化：格子宽度固定，只为可见范围内的帧提交标签、按钮与缩略图，
+    // 每个 UI 帧的开销与帧数无关；最后用一个 Dummy 撑出整条的宽度供滚动条使用
+    const float cellW = 48.0f;
+    const float cellH = 40.0f;
     const float headerH = 18.0f;
-    for (int i = 0; i < frameCount; ++i)
+    const float stride = cellW + ImGui::GetStyle().ItemSpacing.x;
+    const ImVec2 stripOrigin = ImGui::GetCursorScreenPos();
+    const float viewMinX = ImGui::GetWindowPos().x;
+    const float viewMaxX = viewMinX + ImGui::GetWindowSize().x;
+    const int firstVisible = std::clamp(static_cast<int>(std::floor((viewMinX - stripOrigin.x) / stride)), 0, frameCount);
+    const int lastVisible = std::clamp(static_cast<int>(std::ceil((viewMaxX - stripOrigin.x) / stride)), firstVisible, frameCount);
+
+    // 缩略图由后台线程生成，这里只上传已完成的结果
+    timelineThumbnails_.sync(
+        *project, current, firstVisible, lastVisible, thumbnailUploader_, context->getCanvasUploadMode(), SDL_GetTicks());
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    char label[16];
+    for (int i = firstVisible; i < lastVisible; ++i)
     {
-        ImGui::PushID(1000 + i);
-        ImGui::BeginGroup();
-        ImGui::Text(" %d", i + 1);
-        ImGui::EndGroup();
-        ImGui::PopID();
-        ImGui::SameLine(0.0f, cellW - 8.0f);
+        std::snprintf(label, sizeof(label), " %d", i + 1);
+        drawList->AddText(ImVec2(stripOrigin.x + static_cast<float>(i) * stride, stripOrigin.y),
+                          ImGui::GetColorU32(ImGuiCol_Text),
+                          label);
     }
 
-    ImGui::Dummy(ImVec2(0.0f, headerH));
-
-    for (int i = 0; i < frameCount; ++i)
+    // Shift+单击在当前帧与点击帧之间建立帧范围（供跨帧编辑），普通单击清除范围
+    int rangeFirst = current;
+    int rangeLast = current;
+    context->getFrameRange(rangeFirst, rangeLast);
+    const float cellsY = stripOrigin.y + headerH + ImGui::GetStyle().ItemSpacing.y;
+    for (int i = firstVisible; i < lastVisible; ++i)
     {
         ImGui::PushID(i);
         const bool selected = (i == current);
-        const ImVec4 col = selected ? ImVec4(0.2f, 0.5f, 0.9f, 0.9f) : ImVec4(0.35f, 0.35f, 0.35f, 0.9f);
+        const bool inRange = context->hasFrameRange() && i >= rangeFirst && i <= rangeLast;
+        const ImVec4 col = selected ? ImVec4(0.2f, 0.5f, 0.9f, 0.9f)
+                           : inRange ? ImVec4(0.2f, 0.35f, 0.55f, 0.9f)
+                                     : ImVec4(0.35f, 0.35f, 0.35f, 0.9f);
+        ImGui::SetCursorScreenPos(ImVec2(stripOrigin.x + static_cast<float>(i) * stride, cellsY));
         ImGui::PushStyleColor(ImGuiCol_Button, col);
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(col.x + 0.1f, col.y + 0.1f, col.z + 0.1f, 1.0f));
         ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(col.x + 0.15f, col.y + 0.15f, col.z + 0.15f, 1.0f));
         if (ImGui::Button("##frame_cell", ImVec2(cellW, cellH)))
-            context->setCurrentFrameIndex(i);
+        {
+            if (ImGui::GetIO().KeyShift)
+            {
+                context->setFrameRange(current, i);
+            }
+            else
+            {
+                context->clearFrameRange();
+                context->setCurrentFrameIndex(i);
+            }
+        }
         ImGui::PopStyleColor(3);
+
+        // 缩略图按比例放进格子（留出边框显示选中/范围颜色）
+        ThumbnailAtlas::View thumbnail;
+        if (timelineThumbnails_.getView(project->getFrame(i).id, thumbnail))
+        {
+            const float padding = 3.0f;
+            const ImVec2 cellMin = ImGui::GetItemRectMin();
+            const float scale = std::min((cellW - padding * 2.0f) / static_cast<float>(thumbnail.width),
+                                         (cellH - padding * 2.0f) / static_cast<float>(thumbnail.height));
+            const ImVec2 size(static_cast<float>(thumbnail.width) * scale, static_cast<float>(thumbnail.height) * scale);
+            const ImVec2 thumbMin(cellMin.x + (cellW - size.x) * 0.5f, cellMin.y + (cellH - size.y) * 0.5f);
+            const ImVec2 thumbMax(thumbMin.x + size.x, thumbMin.y + size.y);
+            drawList->AddRectFilled(thumbMin, thumbMax, IM_COL32(70, 70, 70, 255));
+            drawList->AddImage(reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(thumbnail.texture)),
+                               thumbMin,
+                               thumbMax,
+                               ImVec2(thumbnail.u0, thumbnail.v0),
+                               ImVec2(thumbnail.u1, thumbnail.v1));
+        }
         ImGui::PopID();
-        ImGui::SameLine();
     }
 
+    ImGui::SetCursorScreenPos(stripOrigin);
+    ImGui::Dummy(ImVec2(stride * static_cast<float>(frameCount), cellsY - stripOrigin.y + cellH));
+
     ImGui::EndChild();
     ImGui::EndChild();
 }
@@ -1,12 +1,75 @@
 #include "ProjectWindow.h"
 
+#include "commands/EditCommands.h"
+#include "commands/FilterCommands.h"
 #include "core/AppContext.h"
 #include "core/Project.h"
 #include "imgui.h"
+#include "tools/CustomBrush.h"
+
+#include <memory>
 
 void ProjectWindow::renderRightPanel(Project* project)
 {
     ImGui::TextUnformatted("Tool Properties");
+
+    // 浮动选区存在时给出落地/取消入口（也可用 Enter / Esc）
+    const FloatingSelection& floating = context->getFloatingSelection();
+    if (floating.isActive())
+    {
+        ImGui::TextUnformatted("Floating selection (drag to move)");
+        if (floating.isLifted())
+            ImGui::Text("Frames %d-%d", floating.getFirstFrame() + 1, floating.getLastFrame() + 1);
+
+        TransformStep step;
+        bool apply = false;
+        if (ImGui::Button("Flip H"))
+        {
+            step.op = TransformOp::FlipHorizontal;
+            apply = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Flip V"))
+        {
+            step.op = TransformOp::FlipVertical;
+            apply = true;
+        }
+        if (ImGui::Button("Rot CCW"))
+        {
+            step.op = TransformOp::Rotate90CCW;
+            apply = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Rot CW"))
+        {
+            step.op = TransformOp::Rotate90CW;
+            apply = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Rot 180"))
+        {
+            step.op = TransformOp::Rotate180;
+            apply = true;
+        }
+
+        // 任意角度旋转（RotSprite），每次点击在当前结果上叠加
+        ImGui::SliderFloat("Angle", &rotateAngle_, -180.0f, 180.0f, "%.0f deg");
+        if (ImGui::Button("Rotate"))
+        {
+            step.op = TransformOp::RotateAngle;
+            step.degrees = rotateAngle_;
+            apply = true;
+        }
+        if (apply)
+            EditCommands::transform(*context, step);
+
+        if (ImGui::Button("Commit"))
+            EditCommands::commitFloating(*context);
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel"))
+            EditCommands::cancelFloating(*context);
+        ImGui::Separator();
+    }
     const ToolType tool = context->getTool();
     switch (tool)
     {
@@ -16,6 +79,25 @@ void ProjectWindow::renderRightPanel(Project* project)
         int brushSize = context->getBrushSize();
         if (ImGui::SliderInt("Brush Size", &brushSize, 1, 32))
             context->setBrushSize(brushSize);
+        bool pixelPerfect = context->isPixelPerfect();
+        if (ImGui::Checkbox("Pixel Perfect", &pixelPerfect))
+            context->setPixelPerfect(pixelPerfect);
+
+        // 自定义笔刷（Edit > New Brush 从选区捕获）
+        ImGui::Separator();
+        if (const std::shared_ptr<const CustomBrush>& custom = context->getCustomBrush())
+        {
+            ImGui::Text("Custom Brush: %d x %d", custom->getWidth(), custom->getHeight());
+            bool useColor = context->isCustomBrushUsingColor();
+            if (ImGui::Checkbox("Use Foreground Color", &useColor))
+                context->setCustomBrushUsingColor(useColor);
+            if (ImGui::Button("Clear Custom Brush"))
+                context->setCustomBrush(nullptr);
+        }
+        else
+        {
+            ImGui::TextDisabled("Edit > New Brush captures the selection");
+        }
         break;
     }
     case ToolType::Eraser:
@@ -24,35 +106,155 @@ void ProjectWindow::renderRightPanel(Project* project)
         int brushSize = context->getBrushSize();
         if (ImGui::SliderInt("Eraser Size", &brushSize, 1, 32))
             context->setBrushSize(brushSize);
+        bool pixelPerfect = context->isPixelPerfect();
+        if (ImGui::Checkbox("Pixel Perfect", &pixelPerfect))
+            context->setPixelPerfect(pixelPerfect);
         break;
     }
     case ToolType::Eyedropper:
+    {
         ImGui::TextUnformatted("Current: Eyedropper");
+        const char* modeLabels[] = {"Current Frame", "Merged"};
+        int mode = static_cast<int>(context->getEyedropperMode());
+        if (ImGui::Combo("Sample", &mode, modeLabels, static_cast<int>(EyedropperMode::Count)))
+            context->setEyedropperMode(static_cast<EyedropperMode>(mode));
+
+        const char* sizeLabels[] = {"1 x 1", "3 x 3", "5 x 5", "7 x 7", "9 x 9"};
+        int sizeIndex = context->getEyedropperSize() / 2;
+        if (ImGui::Combo("Average", &sizeIndex, sizeLabels, AppContext::kMaxEyedropperSize / 2 + 1))
+            context->setEyedropperSize(sizeIndex * 2 + 1);
         ImGui::TextWrapped("Click a pixel on canvas to sample its RGBA color.");
         break;
+    }
     case ToolType::Fill:
         ImGui::TextUnformatted("Current: Fill");
         ImGui::TextWrapped("Click a pixel on canvas to flood-fill connected area.");
         break;
-    default:
-        ImGui::TextUnformatted("Current: Unsupported in toolbar");
+    case ToolType::MagicWand:
+    {
+        ImGui::TextUnformatted("Current: Magic Wand");
+        int tolerance = context->getWandTolerance();
+        if (ImGui::SliderInt("Tolerance", &tolerance, 0, 255))
+            context->setWandTolerance(tolerance);
+        bool contiguous = context->isWandContiguous();
+        if (ImGui::Checkbox("Contiguous", &contiguous))
+            context->setWandContiguous(contiguous);
+
+        const char* modeLabels[] = {"Replace", "Add", "Subtract"};
+        int mode = static_cast<int>(context->getSelectionMode());
+        if (ImGui::Combo("Mode", &mode, modeLabels, 3))
+            context->setSelectionMode(static_cast<SelectionMode>(mode));
+
+        // 按颜色选择：选中当前帧中所有与前景色匹配的像素
+        if (ImGui::Button("Select Current Color"))
+        {
+            const Project::Frame& frame = project->getFrame(context->getCurrentFrameIndex());
+            Selection picked;
+            Selection::buildColorMask(
+                frame.pixels.data(),
+                project->getWidth(),
+                project->getHeight(),
+                context->getColorRGBA(),
+                context->getWandTolerance(),
+                picked);
+            Selection& selection = context->getSelection();
+            if (selection.getWidth() != picked.getWidth() || selection.getHeight() != picked.getHeight())
+                selection.resize(picked.getWidth(), picked.getHeight());
+            selection.combine(picked, context->getSelectionMode());
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Deselect"))
+            context->getSelection().clear();
         break;
     }
-
-    const int zoomLevels[] = {1, 2, 4, 8, 16, 32};
-    const char* zoomLabels[] = {"1x", "2x", "4x", "8x", "16x", "32x"};
-    int zoomIndex = 0;
-    for (int i = 0; i < 6; ++i)
+    case ToolType::Gradient:
     {
-        if (zoomLevels[i] == context->getCanvasZoom())
+        ImGui::TextUnformatted("Current: Gradient");
+        // 前景色 -> 背景色（调色板中右键设置背景色）
+        const ImVec4 startColor = ImGui::ColorConvertU32ToFloat4(context->getColorRGBA());
+        const ImVec4 endColor = ImGui::ColorConvertU32ToFloat4(context->getSecondaryColorRGBA());
+        ImGui::ColorButton("##gradient_start", startColor, ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f));
+        ImGui::SameLine();
+        ImGui::ColorButton("##gradient_end", endColor, ImGuiColorEditFlags_NoTooltip, ImVec2(24.0f, 24.0f));
+        ImGui::SameLine();
+        if (ImGui::Button("Swap"))
         {
-            zoomIndex = i;
-            break;
+            const uint32_t primary = context->getColorRGBA();
+            context->setColorRGBA(context->getSecondaryColorRGBA());
+            context->setSecondaryColorRGBA(primary);
         }
+
+        const char* shapeLabels[] = {"Linear", "Radial"};
+        int shape = static_cast<int>(context->getGradientShape());
+        if (ImGui::Combo("Shape", &shape, shapeLabels, static_cast<int>(GradientShape::Count)))
+            context->setGradientShape(static_cast<GradientShape>(shape));
+
+        const char* ditherLabels[] = {"None", "Bayer 2x2", "Bayer 4x4", "Bayer 8x8"};
+        int matrix = static_cast<int>(context->getDitherMatrix());
+        if (ImGui::Combo("Dither", &matrix, ditherLabels, static_cast<int>(DitherMatrix::Count)))
+            context->setDitherMatrix(static_cast<DitherMatrix>(matrix));
+        ImGui::TextWrapped("Drag on canvas to set start and end. Colors are quantized to the palette.");
+        break;
+    }
+    case ToolType::Shade:
+    {
+        ImGui::TextUnformatted("Current: Shade");
+        int brushSize = context->getBrushSize();
+        if (ImGui::SliderInt("Brush Size", &brushSize, 1, 32))
+            context->setBrushSize(brushSize);
+        bool pixelPerfect = context->isPixelPerfect();
+        if (ImGui::Checkbox("Pixel Perfect", &pixelPerfect))
+            context->setPixelPerfect(pixelPerfect);
+        int step = context->getShadeStep();
+        if (ImGui::RadioButton("Up ramp", step > 0))
+            context->setShadeStep(1);
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Down ramp", step < 0))
+            context->setShadeStep(-1);
+        if (context->getShadeRamp().isEmpty())
+            ImGui::TextWrapped("Shift+click palette colors to build a shading ramp.");
+        break;
+    }
+    case ToolType::Spray:
+    {
+        ImGui::TextUnformatted("Current: Spray");
+        int radius = context->getSprayRadius();
+        if (ImGui::SliderInt("Radius", &radius, 1, Noise::kMaxSprayRadius))
+            context->setSprayRadius(radius);
+        int density = context->getNoiseDensity();
+        if (ImGui::SliderInt("Density", &density, 1, Noise::kMaxDensity, "%d%%"))
+            context->setNoiseDensity(density);
+
+        const char* colorLabels[] = {"Foreground", "Foreground + Secondary", "Shading Ramp"};
+        int colors = static_cast<int>(context->getNoiseColors());
+        if (ImGui::Combo("Colors", &colors, colorLabels, static_cast<int>(NoiseColors::Count)))
+            context->setNoiseColors(static_cast<NoiseColors>(colors));
+
+        // 种子决定下一笔/下一次填充的随机序列，填回相同的种子可以复现结果
+        uint32_t seed = context->getNoiseSeed();
+        if (ImGui::InputScalar("Seed", ImGuiDataType_U32, &seed))
+            context->setNoiseSeed(seed);
+
+        // 噪点填充：选区（无选区时整帧），作用于时间线帧范围
+        if (ImGui::Button("Fill With Noise"))
+            FilterCommands::fillNoise(*context);
+        break;
     }
-    if (ImGui::Combo("Canvas Zoom", &zoomIndex, zoomLabels, 6))
+    default:
+        ImGui::TextUnformatted("Current: Unsupported in toolbar");
+        break;
+    }
+
+    // 以面板中心为锚点缩放（滚轮缩放在画布上以光标为锚点）
+    float zoomPercent = context->getCanvasZoom() * 100.0f;
+    if (ImGui::SliderFloat("Canvas Zoom",
+                           &zoomPercent,
+                           AppContext::kMinCanvasZoom * 100.0f,
+                           AppContext::kMaxCanvasZoom * 100.0f,
+                           "%.0f%%",
+                           ImGuiSliderFlags_Logarithmic))
     {
-        context->setCanvasZoom(zoomLevels[zoomIndex]);
+        context->zoomCanvasAt(zoomPercent / 100.0f, 0.0f, 0.0f);
     }
 
     bool showGrid = context->isGridVisible();
@@ -62,6 +264,39 @@ void ProjectWindow::renderRightPanel(Project* project)
     bool onionSkin = context->isOnionSkinEnabled();
     if (ImGui::Checkbox("Onion Skin", &onionSkin))
         context->setOnionSkinEnabled(onionSkin);
+    if (onionSkin)
+    {
+        // 邻帧数量，以及每一层（按距离）的色调与不透明度
+        OnionSkinSettings onion = context->getOnionSkinSettings();
+        bool onionChanged = false;
+        ImGui::Indent();
+        onionChanged |= ImGui::SliderInt("Previous Frames", &onion.previous, 0, OnionSkinSettings::kMaxFrames);
+        onionChanged |= ImGui::SliderInt("Next Frames", &onion.next, 0, OnionSkinSettings::kMaxFrames);
+        const auto editLayer = [&](const char* label, int distance, OnionSkinLayer& layer) {
+            ImGui::PushID(label);
+            ImGui::PushID(distance);
+            ImVec4 tint = ImGui::ColorConvertU32ToFloat4(layer.tint);
+            if (ImGui::ColorEdit3("##tint", &tint.x, ImGuiColorEditFlags_NoInputs))
+            {
+                layer.tint = ImGui::ColorConvertFloat4ToU32(tint);
+                onionChanged = true;
+            }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120.0f);
+            onionChanged |= ImGui::SliderInt("##opacity", &layer.opacity, 0, 100, "%d%%");
+            ImGui::SameLine();
+            ImGui::Text("%s %d", label, distance);
+            ImGui::PopID();
+            ImGui::PopID();
+        };
+        for (int i = 0; i < onion.previous; ++i)
+            editLayer("Previous", i + 1, onion.previousLayers[i]);
+        for (int i = 0; i < onion.next; ++i)
+            editLayer("Next", i + 1, onion.nextLayers[i]);
+        ImGui::Unindent();
+        if (onionChanged)
+            context->setOnionSkinSettings(onion);
+    }
 
     ImGui::Separator();
     ImGui::TextUnformatted("Project");
@@ -81,6 +316,8 @@ void ProjectWindow::renderRightPanel(Project* project)
     if (ImGui::Button("Apply Size") && pendingCanvasWidth_ > 0 && pendingCanvasHeight_ > 0)
     {
         project->resizeCanvas(pendingCanvasWidth_, pendingCanvasHeight_, 0x00000000);
+        // 画布尺寸变化后旧的 tile 记录无法对齐，清空撤销历史
+        context->clearUndoHistory();
         context->setProjectDirty(true);
     }
 }
@@ -104,7 +104,11 @@ void ProjectWindow::renderToolbarPanel()
         {ToolType::Brush, "Brush", toolbarState_.brushIconTexture},
         {ToolType::Eraser, "Eraser", toolbarState_.eraserIconTexture},
         {ToolType::Eyedropper, "Eyedropper", toolbarState_.eyedropperIconTexture},
-        {ToolType::Fill, "Fill", toolbarState_.fillIconTexture}
+        {ToolType::Fill, "Fill", toolbarState_.fillIconTexture},
+        {ToolType::MagicWand, "Magic Wand", 0},
+        {ToolType::Gradient, "Gradient", 0},
+        {ToolType::Shade, "Shade", 0},
+        {ToolType::Spray, "Spray", 0}
     };
 
     const ImVec2 iconSize(26.0f, 26.0f);
@@ -125,7 +129,7 @@ void ProjectWindow::renderToolbarPanel()
         }
         else
         {
-            clicked = ImGui::Button(item.label, ImVec2(80.0f, 26.0f));
+            clicked = ImGui::Button(item.label, ImVec2(-FLT_MIN, 26.0f));
         }
 
         if (selected)
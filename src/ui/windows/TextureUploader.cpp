@@ -0,0 +1,164 @@
+#include "TextureUploader.h"
+
+#include "GlFunctions.h"
+
+#include <SDL3/SDL.h>
+
+#include <cstring>
+
+namespace
+{
+size_t rectBytes(const Project::DirtyRect& rect)
+{
+    return static_cast<size_t>(rect.width) * static_cast<size_t>(rect.height) * sizeof(uint32_t);
+}
+} // namespace
+
+TextureUploader::~TextureUploader()
+{
+    if (buffers_[0] != 0)
+        glFunctions().deleteBuffers(kRingSize, buffers_);
+}
+
+void TextureUploader::upload(const Target& target,
+                             const uint32_t* pixels,
+                             int width,
+                             int height,
+                             const std::vector<Project::DirtyRect>& rects,
+                             CanvasUploadMode mode)
+{
+    // 整帧上传用栈上的矩形，不为此分配内存
+    const Project::DirtyRect fullFrame{0, 0, width, height};
+    const Project::DirtyRect* regions = rects.empty() ? &fullFrame : rects.data();
+    const size_t regionCount = rects.empty() ? 1 : rects.size();
+    size_t bytes = 0;
+    for (size_t i = 0; i < regionCount; ++i)
+        bytes += rectBytes(regions[i]);
+
+    const uint64_t start = SDL_GetPerformanceCounter();
+    glBindTexture(target.layer >= 0 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D, target.texture);
+    // 设置像素存储模式，确保数据按1字节对齐，避免因对齐问题导致的数据错误
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    lastMode_ = CanvasUploadMode::Direct;
+    if (mode == CanvasUploadMode::PixelBuffer && uploadPixelBuffer(target, pixels, width, regions, regionCount, bytes))
+        lastMode_ = CanvasUploadMode::PixelBuffer;
+    else
+        uploadDirect(target, pixels, width, regions, regionCount);
+
+    const double elapsedMs = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0
+        / static_cast<double>(SDL_GetPerformanceFrequency());
+    Stats& stats = stats_[static_cast<int>(lastMode_)];
+    stats.lastMs = elapsedMs;
+    stats.averageMs = stats.uploads == 0 ? elapsedMs : stats.averageMs * 0.9 + elapsedMs * 0.1;
+    stats.lastBytes = bytes;
+    ++stats.uploads;
+}
+
+void TextureUploader::uploadDirect(const Target& target,
+                                   const uint32_t* pixels,
+                                   int width,
+                                   const Project::DirtyRect* rects,
+                                   size_t rectCount) const
+{
+    // 子矩形直接从帧内存按行跨步读取，不需要先拷到临时缓冲
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for (size_t i = 0; i < rectCount; ++i)
+    {
+        const Project::DirtyRect& rect = rects[i];
+        const uint32_t* origin = pixels + static_cast<size_t>(rect.y) * static_cast<size_t>(width) + static_cast<size_t>(rect.x);
+        writeRect(target, rect, origin);
+    }
+    // 恢复默认值，避免影响 ImGui 后端等其他纹理上传
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+bool TextureUploader::uploadPixelBuffer(const Target& target,
+                                        const uint32_t* pixels,
+                                        int width,
+                                        const Project::DirtyRect* rects,
+                                        size_t rectCount,
+                                        size_t bytes)
+{
+    const GlFunctions& gl = glFunctions();
+    if (!gl.hasBuffers)
+        return false;
+    if (buffers_[0] == 0)
+        gl.genBuffers(kRingSize, buffers_);
+
+    const int slot = next_;
+    next_ = (next_ + 1) % kRingSize;
+    gl.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffers_[slot]);
+
+    // 容量不足时重新分配；否则映射时带 INVALIDATE_BUFFER，驱动换一块新存储（孤立旧存储），
+    // 仍在被 GPU 读取的旧数据不受影响，CPU 无需等待
+    if (capacities_[slot] < bytes)
+    {
+        capacities_[slot] = bytes;
+        gl.bufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    }
+    uint8_t* mapped = static_cast<uint8_t*>(gl.mapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                                              0,
+                                                              static_cast<GLsizeiptr>(bytes),
+                                                              GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (!mapped)
+    {
+        gl.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    // 各矩形在 PBO 中紧凑排列（行跨度等于矩形宽度）
+    size_t offset = 0;
+    for (size_t i = 0; i < rectCount; ++i)
+    {
+        const Project::DirtyRect& rect = rects[i];
+        const size_t rowBytes = static_cast<size_t>(rect.width) * sizeof(uint32_t);
+        for (int y = 0; y < rect.height; ++y)
+        {
+            const uint32_t* src = pixels + static_cast<size_t>(rect.y + y) * static_cast<size_t>(width) + static_cast<size_t>(rect.x);
+            std::memcpy(mapped + offset + static_cast<size_t>(y) * rowBytes, src, rowBytes);
+        }
+        offset += rectBytes(rect);
+    }
+
+    if (!gl.unmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+    {
+        // 映射期间存储失效（极少见），本次改走直接上传
+        gl.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    // 绑定 PBO 时 glTexSubImage2D 的数据指针表示缓冲内的字节偏移
+    offset = 0;
+    for (size_t i = 0; i < rectCount; ++i)
+    {
+        writeRect(target, rects[i], reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)));
+        offset += rectBytes(rects[i]);
+    }
+
+    // 解绑，否则之后所有纹理上传（包括 ImGui 字体纹理）都会从 PBO 读取
+    gl.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+void TextureUploader::writeRect(const Target& target, const Project::DirtyRect& rect, const void* data) const
+{
+    const int x = target.offsetX + rect.x;
+    const int y = target.offsetY + rect.y;
+    if (target.layer >= 0)
+    {
+        glFunctions().texSubImage3D(GL_TEXTURE_2D_ARRAY,
+                                    target.level,
+                                    x,
+                                    y,
+                                    target.layer,
+                                    rect.width,
+                                    rect.height,
+                                    1,
+                                    GL_RGBA,
+                                    GL_UNSIGNED_BYTE,
+                                    data);
+        return;
+    }
+    glTexSubImage2D(GL_TEXTURE_2D, target.level, x, y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/AppContext.h"
+#include "core/Project.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 把帧像素的若干矩形上传到 RGBA8 纹理
+ *
+ * 两条路径：
+ * - Direct：glTexSubImage2D 直接读取帧内存（GL_UNPACK_ROW_LENGTH 跨步读取子矩形）。
+ *   驱动必须在调用返回前把数据拷走，大面积上传会卡住渲染线程。
+ * - PixelBuffer：kRingSize 个 PBO 轮流使用，每次映射前孤立（orphan）旧存储，
+ *   CPU 把脏矩形紧凑拷入映射内存后立即返回，纹理更新由驱动异步从 PBO 读取，
+ *   不必等待 GPU 用完上一帧的数据。
+ *
+ * 目标可以是普通 2D 纹理（可带偏移，例如图集中的一格；可指定 mip 层级），也可以是纹理数组的某一层。
+ * 每次上传都记录 CPU 侧耗时（含拷贝与驱动提交），按路径分别统计，便于对比。
+ * 需要当前线程持有 OpenGL 上下文；缓冲对象入口不可用时 PixelBuffer 自动退回 Direct。
+ */
+class TextureUploader
+{
+public:
+    static constexpr int kRingSize = 3;
+
+    // 单条路径的耗时统计
+    struct Stats
+    {
+        double lastMs = 0.0;       // 最近一次上传耗时（毫秒）
+        double averageMs = 0.0;    // 指数滑动平均
+        size_t lastBytes = 0;      // 最近一次上传的字节数
+        uint64_t uploads = 0;      // 累计上传次数
+    };
+
+    // 上传目标
+    struct Target
+    {
+        unsigned int texture = 0;
+        int layer = -1;     // >= 0 时 texture 为 GL_TEXTURE_2D_ARRAY，写入该层
+        int offsetX = 0;    // 写入位置偏移（图集中帧所在的格子）
+        int offsetY = 0;
+        int level = 0;      // mip 层级（width/height 为该层的尺寸）
+    };
+
+    TextureUploader() = default;
+    ~TextureUploader();
+
+    TextureUploader(const TextureUploader&) = delete;
+    TextureUploader& operator=(const TextureUploader&) = delete;
+
+    /**
+     * @brief 上传 rects 覆盖的像素
+     * @param target 目标纹理（容纳 width x height 的区域）
+     * @param pixels 整帧像素，行跨度为 width
+     * @param rects 要上传的矩形；为空表示整帧
+     */
+    void upload(const Target& target,
+                const uint32_t* pixels,
+                int width,
+                int height,
+                const std::vector<Project::DirtyRect>& rects,
+                CanvasUploadMode mode);
+
+    const Stats& getStats(CanvasUploadMode mode) const
+    {
+        return stats_[static_cast<int>(mode)];
+    }
+
+    // 最近一次上传实际走的路径（PBO 不可用时会退回 Direct）
+    CanvasUploadMode getLastMode() const
+    {
+        return lastMode_;
+    }
+
+private:
+    void uploadDirect(const Target& target, const uint32_t* pixels, int width, const Project::DirtyRect* rects, size_t rectCount) const;
+    bool uploadPixelBuffer(const Target& target,
+                           const uint32_t* pixels,
+                           int width,
+                           const Project::DirtyRect* rects,
+                           size_t rectCount,
+                           size_t bytes);
+    void writeRect(const Target& target, const Project::DirtyRect& rect, const void* data) const;
+
+    unsigned int buffers_[kRingSize] = {};
+    size_t capacities_[kRingSize] = {};
+    int next_ = 0;
+    Stats stats_[static_cast<int>(CanvasUploadMode::Count)];
+    CanvasUploadMode lastMode_ = CanvasUploadMode::Direct;
+};
@@ -0,0 +1,191 @@
+#include "ThumbnailAtlas.h"
+
+#include "GlFunctions.h"
+
+#include <algorithm>
+
+namespace
+{
+// 图集按 4 行一档增长
+constexpr int kRowStep = 4;
+} // namespace
+
+ThumbnailAtlas::ThumbnailAtlas()
+    : thumbnailer_(kCellSize)
+{
+}
+
+ThumbnailAtlas::~ThumbnailAtlas()
+{
+    release();
+}
+
+void ThumbnailAtlas::release()
+{
+    if (texture_ != 0)
+    {
+        glDeleteTextures(1, &texture_);
+        texture_ = 0;
+    }
+    rows_ = 0;
+    nextSlot_ = 0;
+    freeSlots_.clear();
+    for (const auto& item : entries_)
+        thumbnailer_.forget(item.first);
+    entries_.clear();
+}
+
+bool ThumbnailAtlas::grow()
+{
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    const int rows = rows_ + kRowStep;
+    if (rows * kCellSize > maxSize || kColumns * kCellSize > maxSize)
+        return false;
+
+    // 分配更大的新纹理，把旧图集的各行原样拷过去，已有的缩略图不必重新生成
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kColumns * kCellSize, rows * kCellSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    if (texture_ != 0)
+    {
+        const GlFunctions& gl = glFunctions();
+        if (gl.hasCopyImage)
+        {
+            gl.copyImageSubData(
+                texture_, GL_TEXTURE_2D, 0, 0, 0, 0, texture, GL_TEXTURE_2D, 0, 0, 0, 0, kColumns * kCellSize, rows_ * kCellSize, 1);
+        }
+        else
+        {
+            // 不支持纹理拷贝时内容丢失：已有的缩略图全部重新生成
+            for (auto& item : entries_)
+            {
+                item.second.uploadedGeneration = 0;
+                item.second.submittedGeneration = 0;
+                item.second.submittedAt = 0;
+            }
+        }
+        glDeleteTextures(1, &texture_);
+    }
+    texture_ = texture;
+    rows_ = rows;
+    return true;
+}
+
+int ThumbnailAtlas::allocateSlot()
+{
+    if (!freeSlots_.empty())
+    {
+        const int slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+    if (nextSlot_ >= rows_ * kColumns && !grow())
+        return -1;
+    return nextSlot_++;
+}
+
+void ThumbnailAtlas::submitIfStale(const Project& project, int frameIndex, Entry& entry, uint64_t nowMs, int& budget)
+{
+    const Project::Frame& frame = project.getFrame(frameIndex);
+    if (budget <= 0 || entry.slot < 0 || frame.generation == entry.submittedGeneration)
+        return;
+    if (entry.submittedAt != 0 && nowMs - entry.submittedAt < kThrottleMs)
+        return;
+    if (!thumbnailer_.submit(project, frameIndex))
+        return;
+    entry.submittedGeneration = frame.generation;
+    entry.submittedAt = nowMs;
+    --budget;
+}
+
+ThumbnailAtlas::Entry& ThumbnailAtlas::touch(uint64_t frameId, uint64_t nowMs)
+{
+    Entry& entry = entries_[frameId];
+    entry.lastSeen = nowMs;
+    if (entry.slot < 0)
+        entry.slot = allocateSlot();
+    return entry;
+}
+
+void ThumbnailAtlas::sync(const Project& project,
+                          int currentFrame,
+                          int firstFrame,
+                          int lastFrame,
+                          TextureUploader& uploader,
+                          CanvasUploadMode mode,
+                          uint64_t nowMs)
+{
+    const int frameCount = project.getFrameCount();
+    firstFrame = std::clamp(firstFrame, 0, frameCount);
+    lastFrame = std::clamp(lastFrame, firstFrame, frameCount);
+
+    // 先回收很久没有出现的帧（已删除或滚出视野），再为可见帧分配格子
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (nowMs - it->second.lastSeen <= kEvictMs)
+        {
+            ++it;
+            continue;
+        }
+        if (it->second.slot >= 0)
+            freeSlots_.push_back(it->second.slot);
+        thumbnailer_.forget(it->first);
+        it = entries_.erase(it);
+    }
+    for (int i = firstFrame; i < lastFrame; ++i)
+        touch(project.getFrame(i).id, nowMs);
+
+    // 上传已完成的缩略图（每张最多 kCellSize x kCellSize）
+    results_.clear();
+    thumbnailer_.collect(results_);
+    for (const Thumbnailer::Result& result : results_)
+    {
+        auto it = entries_.find(result.frameId);
+        if (it == entries_.end() || it->second.slot < 0 || result.generation <= it->second.uploadedGeneration)
+            continue;
+        Entry& entry = it->second;
+        TextureUploader::Target target;
+        target.texture = texture_;
+        target.offsetX = (entry.slot % kColumns) * kCellSize;
+        target.offsetY = (entry.slot / kColumns) * kCellSize;
+        const std::vector<Project::DirtyRect> wholeThumbnail;
+        uploader.upload(target, result.preview.pixels.data(), result.preview.width, result.preview.height, wholeThumbnail, mode);
+        entry.uploadedGeneration = result.generation;
+        entry.width = result.preview.width;
+        entry.height = result.preview.height;
+    }
+
+    // 提交版本号变化的帧：正在编辑的帧优先，其余只看可见范围
+    int budget = kMaxSubmitsPerFrame;
+    if (currentFrame >= 0 && currentFrame < frameCount)
+        submitIfStale(project, currentFrame, touch(project.getFrame(currentFrame).id, nowMs), nowMs, budget);
+    for (int i = firstFrame; i < lastFrame && budget > 0; ++i)
+        submitIfStale(project, i, entries_[project.getFrame(i).id], nowMs, budget);
+}
+
+bool ThumbnailAtlas::getView(uint64_t frameId, View& out) const
+{
+    const auto it = entries_.find(frameId);
+    if (it == entries_.end() || it->second.slot < 0 || it->second.uploadedGeneration == 0)
+        return false;
+    const Entry& entry = it->second;
+    const float atlasWidth = static_cast<float>(kColumns * kCellSize);
+    const float atlasHeight = static_cast<float>(rows_ * kCellSize);
+    const int x = (entry.slot % kColumns) * kCellSize;
+    const int y = (entry.slot / kColumns) * kCellSize;
+    out.texture = texture_;
+    out.width = entry.width;
+    out.height = entry.height;
+    out.u0 = static_cast<float>(x) / atlasWidth;
+    out.v0 = static_cast<float>(y) / atlasHeight;
+    out.u1 = static_cast<float>(x + entry.width) / atlasWidth;
+    out.v1 = static_cast<float>(y + entry.height) / atlasHeight;
+    return true;
+}
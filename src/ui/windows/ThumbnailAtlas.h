@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TextureUploader.h"
+#include "core/AppContext.h"
+#include "core/Project.h"
+#include "core/Thumbnailer.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 时间轴帧缩略图的共享图集纹理
+ *
+ * 每一帧（按帧编号）占图集中 kCellSize x kCellSize 的一格。缩小由 Thumbnailer 在后台线程完成，
+ * UI 线程每帧调用 sync：取回已完成的缩略图上传到对应格子，并为版本号变化的帧提交新快照。
+ * 提交有节流：同一帧还在处理中时不重复提交，两次提交至少间隔 kThrottleMs，
+ * 每个 UI 帧最多提交 kMaxSubmitsPerFrame 帧；每次提交只拷贝上次提交之后的脏区域，
+ * 所以连续绘画时 UI 线程只付出偶尔一次小范围拷贝。
+ *
+ * 只跟踪时间轴上可见的帧（以及当前帧）：超过 kEvictMs 没有出现在可见范围内的帧
+ * 释放其格子，所以每个 UI 帧的开销和图集大小都只与可见帧数有关，与项目帧数无关。
+ */
+class ThumbnailAtlas
+{
+public:
+    static constexpr int kCellSize = 64;             // 缩略图最大边长，也是图集格子尺寸
+    static constexpr int kColumns = 16;              // 图集每行的格子数
+    static constexpr uint64_t kThrottleMs = 250;
+    static constexpr int kMaxSubmitsPerFrame = 2;
+    static constexpr uint64_t kEvictMs = 2000;
+
+    // 一帧缩略图在图集中的位置
+    struct View
+    {
+        unsigned int texture = 0;
+        int width = 0;    // 缩略图尺寸（像素）
+        int height = 0;
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+    };
+
+    ThumbnailAtlas();
+    ~ThumbnailAtlas();
+
+    ThumbnailAtlas(const ThumbnailAtlas&) = delete;
+    ThumbnailAtlas& operator=(const ThumbnailAtlas&) = delete;
+
+    /**
+     * @brief 上传已完成的缩略图并提交需要更新的帧
+     * @param currentFrame 优先提交的帧（正在编辑的帧）
+     * @param firstFrame 时间轴上可见的帧范围 [firstFrame, lastFrame)
+     * @param nowMs 当前时间（毫秒，用于节流与回收）
+     */
+    void sync(const Project& project,
+              int currentFrame,
+              int firstFrame,
+              int lastFrame,
+              TextureUploader& uploader,
+              CanvasUploadMode mode,
+              uint64_t nowMs);
+
+    // 该帧已有缩略图时返回 true
+    bool getView(uint64_t frameId, View& out) const;
+
+    // 释放图集纹理
+    void release();
+
+private:
+    struct Entry
+    {
+        int slot = -1;                    // 图集格子（-1 表示图集已满）
+        uint64_t submittedGeneration = 0; // 最近一次提交快照的帧版本号
+        uint64_t submittedAt = 0;         // 最近一次提交的时间（毫秒）
+        uint64_t uploadedGeneration = 0;  // 图集中缩略图对应的帧版本号（0 表示还没有）
+        int width = 0;
+        int height = 0;
+        uint64_t lastSeen = 0;            // 最近一次在可见范围内的时间（毫秒）
+    };
+
+    int allocateSlot();
+    bool grow();
+    Entry& touch(uint64_t frameId, uint64_t nowMs);
+    void submitIfStale(const Project& project, int frameIndex, Entry& entry, uint64_t nowMs, int& budget);
+
+    Thumbnailer thumbnailer_;
+    unsigned int texture_ = 0;
+    int rows_ = 0;
+    int nextSlot_ = 0;
+    std::vector<int> freeSlots_;
+    std::unordered_map<uint64_t, Entry> entries_;   // 帧编号 -> 缩略图状态
+    std::vector<Thumbnailer::Result> results_;
+};